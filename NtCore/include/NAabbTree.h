@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file NAabbTree.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "NPlatform.h"
+#include "NPoint.h"
+#include "NRect.h"
+
+/**
+ * @brief Dynamic bounding volume tree over axis-aligned rects.
+ * Leaves store their bounds grown by MARGIN, so small moves only compare against the fat bounds and
+ * leave the tree untouched. Inserts descend by the cheapest perimeter increase and rotations keep the
+ * tree height balanced, so queries visit O(log n) nodes plus the results. The tree must not be
+ * changed from inside a query's visitor.
+ */
+class BDllExport NAabbTree {
+public:
+    NAabbTree() = default;
+    ~NAabbTree() = default;
+    NAabbTree(const NAabbTree& tree) = default;
+    NAabbTree(NAabbTree&& tree) = default;
+    NAabbTree& operator=(const NAabbTree& tree) = default;
+    NAabbTree& operator=(NAabbTree&& tree) = default;
+
+public:
+    int32_t Insert(const NRect& bounds, uint32_t user_data);
+    void Remove(int32_t proxy);
+    bool Move(int32_t proxy, const NRect& bounds);
+    uint32_t UserData(int32_t proxy) const;
+    NRect FatBounds(int32_t proxy) const;
+    size_t Size() const;
+    int32_t Height() const;
+    void Clear();
+
+    /**
+     * @brief Calls visitor(proxy) for every leaf whose fat bounds overlap area; stops when it returns false.
+     */
+    template <typename Visitor>
+    void Query(const NRect& area, Visitor&& visitor) const {
+        Box box{area.x_, area.y_, area.Right(), area.Bottom()};
+        QueryBox(box, visitor);
+    }
+
+    template <typename Visitor>
+    void Query(const NPoint& point, Visitor&& visitor) const {
+        Box box{point.x_, point.y_, point.x_, point.y_};
+        QueryBox(box, visitor);
+    }
+
+public:
+    static constexpr int32_t NULL_NODE{-1};
+    static constexpr float MARGIN{4.0F};
+
+private:
+    struct Box {
+        float left_{0.0F};
+        float top_{0.0F};
+        float right_{0.0F};
+        float bottom_{0.0F};
+
+        bool Overlaps(const Box& box) const {
+            return left_ <= box.right_ && box.left_ <= right_ && top_ <= box.bottom_ && box.top_ <= bottom_;
+        }
+
+        bool Contains(const Box& box) const {
+            return left_ <= box.left_ && top_ <= box.top_ && box.right_ <= right_ && box.bottom_ <= bottom_;
+        }
+
+        Box United(const Box& box) const {
+            return {(std::min)(left_, box.left_), (std::min)(top_, box.top_), (std::max)(right_, box.right_), (std::max)(bottom_, box.bottom_)};
+        }
+
+        float Perimeter() const {
+            return 2.0F * ((right_ - left_) + (bottom_ - top_));
+        }
+    };
+
+    struct Node {
+        Box box_{};
+        int32_t parent_{NULL_NODE};
+        int32_t child1_{NULL_NODE};
+        int32_t child2_{NULL_NODE};
+        int32_t height_{-1};
+        uint32_t user_data_{0};
+
+        bool IsLeaf() const {
+            return child1_ == NULL_NODE;
+        }
+    };
+
+private:
+    template <typename Visitor>
+    void QueryBox(const Box& box, Visitor& visitor) const {
+        if (root_ == NULL_NODE) {
+            return;
+        }
+        std::vector<int32_t> stack{};
+        stack.reserve(64);
+        stack.push_back(root_);
+        while (!stack.empty()) {
+            const auto& node = nodes_[stack.back()];
+            auto index = stack.back();
+            stack.pop_back();
+            if (!node.box_.Overlaps(box)) {
+                continue;
+            }
+            if (node.IsLeaf()) {
+                if (!visitor(index)) {
+                    return;
+                }
+            } else {
+                stack.push_back(node.child1_);
+                stack.push_back(node.child2_);
+            }
+        }
+    }
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t index);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t index);
+    void Refit(int32_t index);
+    static Box FatBox(const NRect& bounds);
+
+private:
+    std::vector<Node> nodes_{};
+    int32_t root_{NULL_NODE};
+    int32_t free_list_{NULL_NODE};
+    size_t size_{0};
+};
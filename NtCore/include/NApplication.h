@@ -6,9 +6,10 @@
  * @date 2023-05-24
  */
 
-#include "NPlatform.h"
+#include <functional>
 
-class NEventLoop;
+#include "NEventLoop.h"
+#include "NPlatform.h"
 
 class BDllExport NApplication {
 public:
@@ -21,6 +22,13 @@ public:
 
 public:
     int Exec();
+    void Quit(int exit_code = 0);
+    NRunMode RunMode() const;
+    void SetRunMode(NRunMode run_mode);
+    uint32_t TargetFrameRate() const;
+    void SetTargetFrameRate(uint32_t frame_rate);
+    void SetFrameCallback(std::function<void()> callback);
+    void Invalidate();
 
 private:
     NEventLoop* event_loop_{};
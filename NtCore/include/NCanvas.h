@@ -6,8 +6,15 @@
  * @date 2023-06-01
  */
 
+#include <functional>
+#include <map>
 #include <string>
 
+#include "NDamageRegion.h"
+#include "NDrawList.h"
+#include "NItemTree.h"
+#include "NMouseEvent.h"
+#include "NPathCache.h"
 #include "NPlatform.h"
 #include "NPosition.h"
 #include "NSize.h"
@@ -15,13 +22,17 @@
 class BDllExport NCanvas {
 public:
     NCanvas();
-    ~NCanvas() = default;
+    ~NCanvas();
     NCanvas(const NCanvas& canvas) = delete;
     NCanvas(NCanvas&& canvas) = delete;
     NCanvas& operator=(const NCanvas& canvas) = delete;
     NCanvas& operator=(NCanvas&& canvas) = delete;
 
 public:
+    using GeometryListener = std::function<void(const NPosition& pos, const NSize& size)>;
+
+public:
+    NCanvasID ID() const;
     void Show() const;
     std::wstring Title() const;
     void SetTitle(const std::wstring& title);
@@ -31,10 +42,26 @@ public:
     void Move(int32_t x, int32_t y, bool repaint = false);
     void Resize(const NSize& size, bool repaint = false);
     void Resize(uint32_t width, uint32_t height, bool repaint = false);
+    NPosition Position() const;
+    NSize Size() const;
+    uint32_t AddGeometryListener(GeometryListener listener);
+    void RemoveGeometryListener(uint32_t listener_id);
+    NDrawList& DrawList();
+    NPathCache& PathCache();
+    void FillPath(const NPath& path, const NColor& color, const NTransform& transform = {}, NFillRule rule = NFillRule::eNonZero, bool is_dynamic = false);
+    void StrokePath(const NPath& path, const NStrokeStyle& style, const NColor& color, const NTransform& transform = {});
+    void Invalidate(const NRect& rect);
+    void InvalidateAll();
+    bool HasDamage() const;
+    NDamageRegion TakeDamage();
+    NItemTree& Items();
+    size_t DrawItems();
 
 public:
     void MoveEvent(const NPosition& pos);
     void ResizeEvent(const NSize& size);
+    void GeometryEvent(const NPosition& pos, const NSize& size);
+    bool MouseEvent(const NMouseEvent& event);
 
 private:
     NSize GetMonitorSize() const;
@@ -44,4 +71,10 @@ private:
     std::wstring title_{};
     NPosition position_{};
     NSize size_{};
+    uint32_t next_listener_id_{1};
+    std::map<uint32_t, GeometryListener> geometry_listeners_{};
+    NDrawList draw_list_{};
+    NPathCache path_cache_{};
+    NDamageRegion damage_{};
+    NItemTree items_{};
 };
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file NColor.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+struct NColor {
+    float r_{0.0F};
+    float g_{0.0F};
+    float b_{0.0F};
+    float a_{1.0F};
+};
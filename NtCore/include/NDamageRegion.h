@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file NDamageRegion.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <vector>
+
+#include "NPlatform.h"
+#include "NRect.h"
+
+/**
+ * @brief The part of a canvas that changed since it was last presented, as a few disjoint rects.
+ * Touching or overlapping rects are merged as they are added; past MAX_RECTS the pair whose union
+ * wastes the least area is merged. A full region stands for the whole canvas whatever its size.
+ */
+class BDllExport NDamageRegion {
+public:
+    NDamageRegion() = default;
+    ~NDamageRegion() = default;
+    NDamageRegion(const NDamageRegion& region) = default;
+    NDamageRegion(NDamageRegion&& region) = default;
+    NDamageRegion& operator=(const NDamageRegion& region) = default;
+    NDamageRegion& operator=(NDamageRegion&& region) = default;
+
+public:
+    void Add(const NRect& rect);
+    void Add(const NDamageRegion& region);
+    void AddAll();
+    void Clear();
+    bool Empty() const;
+    bool IsFull() const;
+    NRect Bounds() const;
+    const std::vector<NRect>& Rects() const;
+
+public:
+    static constexpr size_t MAX_RECTS{8};
+
+private:
+    std::vector<NRect> rects_{};
+    bool is_full_{false};
+};
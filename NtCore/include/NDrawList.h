@@ -0,0 +1,143 @@
+#pragma once
+
+/**
+ * @file NDrawList.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "NColor.h"
+#include "NPath.h"
+#include "NPlatform.h"
+#include "NPoint.h"
+#include "NRect.h"
+#include "NTransform.h"
+
+using NTextureID = uint32_t;
+
+enum class NDrawPipeline : uint32_t {
+    eShape,
+    eImage,
+    eText,
+    ePath,
+    eStencilPath,
+};
+
+enum class NDrawPrimitive : uint32_t {
+    eRect,
+    eRoundedRect,
+    eLine,
+    eImage,
+    eGlyph,
+    ePath,
+};
+
+/**
+ * @brief One primitive as the GPU sees it: a single instance of a four-vertex quad.
+ * For lines rect_ holds the two end points instead of x, y, width and height; for paths it holds the
+ * transform's a, b, c and d, and uv_ starts with its translation.
+ */
+struct NDrawInstance {
+    float rect_[4]{};
+    float uv_[4]{};
+    float color_[4]{};
+    float radius_{0.0F};
+    float stroke_width_{0.0F};
+    NDrawPrimitive primitive_{NDrawPrimitive::eRect};
+    uint32_t reserved_{0};
+};
+
+/**
+ * @brief A glyph placed relative to the start of a text run's baseline; uv_ is normalized to the
+ * atlas page bound as texture_.
+ */
+struct NGlyphQuad {
+    NRect rect_{};
+    NRect uv_{};
+    NTextureID texture_{0};
+};
+
+/**
+ * @brief For the path pipelines texture_ is the index of the mesh in NDrawList::Meshes().
+ * bounds_ covers every primitive of the batch, so a batch outside a repaint rect can be skipped.
+ */
+struct NDrawBatch {
+    NDrawPipeline pipeline_{NDrawPipeline::eShape};
+    NTextureID texture_{0};
+    uint32_t first_instance_{0};
+    uint32_t instance_count_{0};
+    NRect bounds_{};
+};
+
+/**
+ * @brief Records 2D primitives and groups them into as few instanced draws as painter's order allows.
+ * A primitive joins the latest batch with the same pipeline and texture unless something it overlaps
+ * was put in a later batch, so the reordering never changes what ends up on screen. Overlaps are found
+ * through a coarse tile grid over the primitives' bounds; anything beyond the grid shares its edge tiles.
+ */
+class BDllExport NDrawList {
+public:
+    NDrawList() = default;
+    ~NDrawList() = default;
+    NDrawList(const NDrawList& list) = delete;
+    NDrawList(NDrawList&& list) = delete;
+    NDrawList& operator=(const NDrawList& list) = delete;
+    NDrawList& operator=(NDrawList&& list) = delete;
+
+public:
+    void Clear();
+    void DrawRect(const NRect& rect, const NColor& color);
+    void DrawRoundedRect(const NRect& rect, float radius, const NColor& color);
+    void DrawLine(const NPoint& from, const NPoint& to, float width, const NColor& color);
+    void DrawImage(NTextureID texture, const NRect& rect, const NColor& tint = {1.0F, 1.0F, 1.0F, 1.0F}, const NRect& uv = {0.0F, 0.0F, 1.0F, 1.0F});
+    void DrawGlyphs(const std::vector<NGlyphQuad>& quads, const NPoint& origin, const NColor& color);
+    void DrawPath(const std::shared_ptr<const NPathMesh>& mesh, const NTransform& transform, const NColor& color);
+    void Finish();
+    bool Empty() const;
+    size_t PrimitiveCount() const;
+    const std::vector<NDrawInstance>& Instances() const;
+    const std::vector<NDrawBatch>& Batches() const;
+    const std::vector<std::shared_ptr<const NPathMesh>>& Meshes() const;
+
+public:
+    static constexpr float TILE_SIZE{64.0F};
+    static constexpr int64_t TILE_GRID_SIZE{64};
+    static constexpr int64_t LARGE_TILE_COUNT{256};
+
+private:
+    struct OpenBatch {
+        NDrawPipeline pipeline_{NDrawPipeline::eShape};
+        NTextureID texture_{0};
+        uint32_t count_{0};
+        NRect bounds_{};
+    };
+
+    struct Occupant {
+        NRect bounds_{};
+        uint32_t batch_{0};
+    };
+
+private:
+    void Add(NDrawPipeline pipeline, NTextureID texture, const NRect& bounds, const NDrawInstance* instances, size_t count);
+    template <typename Visitor>
+    bool VisitTiles(const NRect& bounds, Visitor&& visitor);
+
+private:
+    std::vector<NDrawInstance> recorded_{};
+    std::vector<NDrawInstance> scratch_{};
+    std::vector<uint32_t> recorded_batches_{};
+    std::vector<OpenBatch> open_batches_{};
+    std::unordered_map<uint64_t, uint32_t> last_batches_{};
+    std::vector<std::vector<Occupant>> tiles_{};
+    std::vector<Occupant> large_occupants_{};
+    std::vector<NDrawInstance> instances_{};
+    std::vector<NDrawBatch> batches_{};
+    std::vector<std::shared_ptr<const NPathMesh>> meshes_{};
+    std::unordered_map<const NPathMesh*, uint32_t> mesh_indices_{};
+    bool is_finished_{true};
+};
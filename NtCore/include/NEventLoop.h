@@ -6,22 +6,137 @@
  * @date 2023-05-24
  */
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
 #include "NPlatform.h"
+#include "NPosition.h"
+#include "NSize.h"
+#include "NTaskQueue.h"
+
+#if !defined(_WIN32)
+#include <unordered_set>
+#endif
+
+class NCanvas;
+
+/**
+ * @brief How Exec schedules frames between events.
+ * eOnDemand sleeps until an event arrives or Invalidate is called,
+ * eContinuous renders on every iteration without waiting,
+ * ePaced renders at the target frame rate and sleeps in between.
+ */
+enum class NRunMode {
+    eOnDemand,
+    eContinuous,
+    ePaced,
+};
 
 class BDllExport NEventLoop {
 public:
     NEventLoop();
-    ~NEventLoop() = default;
+    ~NEventLoop();
     NEventLoop(const NEventLoop& event_loop) = delete;
     NEventLoop(NEventLoop&& event_loop) = delete;
     NEventLoop& operator=(const NEventLoop& event_loop) = delete;
     NEventLoop& operator=(NEventLoop&& event_loop) = delete;
 
+public:
+    static constexpr uint32_t DEFAULT_FRAME_RATE{60};
+    static constexpr std::chrono::microseconds DEFAULT_TASK_BUDGET{4000};
+
 public:
     int Exec();
+    void Quit(int exit_code = 0);
+    void Wakeup();
+    NRunMode RunMode() const;
+    void SetRunMode(NRunMode run_mode);
+    uint32_t TargetFrameRate() const;
+    void SetTargetFrameRate(uint32_t frame_rate);
+    void SetFrameCallback(std::function<void()> callback);
+    void Invalidate();
+    void SetTaskBudget(std::chrono::microseconds budget);
+
+    /**
+     * @brief Queue a callable to run on the thread executing Exec. Safe to call from any thread.
+     */
+    template <typename Callable>
+    void Post(Callable&& callable) {
+        if (tasks_.Push(std::forward<Callable>(callable))) {
+            Wakeup();
+        }
+    }
+
+private:
+    /**
+     * @brief Latest position and size reported for a canvas, applied once per loop iteration.
+     */
+    struct PendingGeometry {
+        std::optional<NPosition> position_{};
+        std::optional<NSize> size_{};
+    };
+
+private:
+    bool IsFrameDue();
+    void RunFrame();
+    void DrainTasks();
+    bool FlushGeometries();
+
+private:
+    NRunMode run_mode_{NRunMode::eOnDemand};
+    uint32_t target_frame_rate_{DEFAULT_FRAME_RATE};
+    std::function<void()> frame_callback_{};
+    std::atomic<bool> is_invalidated_{true};
+    std::chrono::steady_clock::time_point next_frame_time_{};
+    NTaskQueue tasks_{};
+    std::chrono::microseconds task_budget_{DEFAULT_TASK_BUDGET};
+    std::unordered_map<NCanvasID, PendingGeometry> pending_geometries_{};
 
 #if defined(_WIN32)
 private:
     static LRESULT CALLBACK EventProcess(HWND hwnd, UINT msg, WPARAM w_param, LPARAM l_param);
+    void WaitForEvents();
+
+private:
+    static constexpr UINT_PTR SIZE_MOVE_TIMER_ID{1};
+
+private:
+    DWORD thread_id_{};
+    HANDLE frame_timer_{};
+#else
+public:
+    using WatchCallback = std::function<void(uint32_t events)>;
+
+public:
+    void AddWatch(int fd, uint32_t events, WatchCallback callback);
+    void RemoveWatch(int fd);
+    int AddTimer(uint32_t interval_ms, std::function<void()> callback);
+    void RemoveTimer(int timer_fd);
+
+public:
+    static xcb_connection_t* Connection();
+    static xcb_screen_t* Screen();
+    static xcb_atom_t Atom(const char* name);
+    static void RegisterCanvas(NCanvasID id, NCanvas* canvas);
+    static void UnregisterCanvas(NCanvasID id);
+
+private:
+    void DispatchConnection();
+    int WaitTimeout();
+
+private:
+    static constexpr int MAX_EVENTS{32};
+
+private:
+    int epoll_fd_{-1};
+    int wakeup_fd_{-1};
+    int frame_timer_fd_{-1};
+    bool is_running_{false};
+    int exit_code_{0};
+    std::unordered_map<int, WatchCallback> watches_{};
+    std::unordered_set<int> timers_{};
 #endif
-};
\ No newline at end of file
+};
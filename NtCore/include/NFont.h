@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @file NFont.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <string>
+
+struct NFont {
+    std::wstring family_{};
+    float size_{16.0F};
+    uint32_t weight_{400};
+    bool italic_{false};
+
+    bool operator==(const NFont& font) const = default;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file NGlyphAtlas.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "NDrawList.h"
+#include "NFont.h"
+#include "NGlyphRasterizer.h"
+#include "NPlatform.h"
+
+struct NAtlasRegion {
+    uint32_t x_{0};
+    uint32_t y_{0};
+    uint32_t width_{0};
+    uint32_t height_{0};
+};
+
+/**
+ * @brief Where a glyph lives in the atlas. Metrics are in pixels at NGlyphAtlas::REFERENCE_SIZE and
+ * describe the padded distance field, not the glyph's ink.
+ */
+struct NAtlasGlyph {
+    uint32_t page_{0};
+    NTextureID texture_{0};
+    NAtlasRegion region_{};
+    float bearing_x_{0.0F};
+    float bearing_y_{0.0F};
+    float advance_{0.0F};
+    bool is_empty_{false};
+};
+
+/**
+ * @brief Single-channel signed distance field glyphs packed into fixed-size pages.
+ * Glyphs are rasterized once at REFERENCE_SIZE and scaled to any font size when drawn. Pages are
+ * shelf-packed with a GUTTER of zero pixels after each glyph, so bilinear sampling at a glyph's edge
+ * never reads its neighbour. Once every page is full the least recently used page that was not touched
+ * this frame is cleared as a whole and Generation() changes, telling callers to look their glyphs up again.
+ * New and cleared pages are dirty in full, so their first upload defines every texel.
+ * The GPU side names a texture for each new page through the texture provider and uploads the
+ * regions returned by TakeDirtyRegion.
+ */
+class BDllExport NGlyphAtlas {
+public:
+    using TextureProvider = std::function<NTextureID(uint32_t page)>;
+
+public:
+    explicit NGlyphAtlas(NGlyphRasterizer& rasterizer, uint32_t page_size = DEFAULT_PAGE_SIZE, uint32_t max_pages = DEFAULT_MAX_PAGES);
+    NGlyphAtlas() = delete;
+    ~NGlyphAtlas() = default;
+    NGlyphAtlas(const NGlyphAtlas& atlas) = delete;
+    NGlyphAtlas(NGlyphAtlas&& atlas) = delete;
+    NGlyphAtlas& operator=(const NGlyphAtlas& atlas) = delete;
+    NGlyphAtlas& operator=(NGlyphAtlas&& atlas) = delete;
+
+public:
+    void SetTextureProvider(TextureProvider provider);
+    void BeginFrame();
+    const NAtlasGlyph* Find(const NFont& font, uint32_t glyph);
+    void Touch(uint32_t page);
+    uint64_t Generation() const;
+    uint32_t PageSize() const;
+    uint32_t PageCount() const;
+    NTextureID PageTexture(uint32_t page) const;
+    const std::vector<uint8_t>& PagePixels(uint32_t page) const;
+    bool TakeDirtyRegion(uint32_t page, NAtlasRegion& region);
+    size_t GlyphCount() const;
+
+public:
+    static constexpr float REFERENCE_SIZE{32.0F};
+    static constexpr uint32_t SDF_SPREAD{4};
+    static constexpr uint32_t DEFAULT_PAGE_SIZE{1024};
+    static constexpr uint32_t DEFAULT_MAX_PAGES{4};
+    static constexpr uint32_t GUTTER{1};
+
+private:
+    struct Shelf {
+        uint32_t y_{0};
+        uint32_t height_{0};
+        uint32_t x_{0};
+    };
+
+    struct Page {
+        std::vector<uint8_t> pixels_{};
+        std::vector<Shelf> shelves_{};
+        uint32_t next_shelf_y_{0};
+        uint64_t last_used_{0};
+        std::vector<uint64_t> glyphs_{};
+        NTextureID texture_{0};
+        NAtlasRegion dirty_{};
+        bool is_dirty_{false};
+    };
+
+private:
+    uint32_t FaceID(const NFont& font);
+    bool Allocate(Page& page, uint32_t width, uint32_t height, NAtlasRegion& region);
+    bool Place(uint32_t width, uint32_t height, uint32_t& page_index, NAtlasRegion& region);
+    void Evict(uint32_t page_index);
+    void MarkDirty(Page& page);
+
+private:
+    NGlyphRasterizer& rasterizer_;
+    uint32_t page_size_{DEFAULT_PAGE_SIZE};
+    uint32_t max_pages_{DEFAULT_MAX_PAGES};
+    TextureProvider texture_provider_{};
+    std::vector<NFont> faces_{};
+    std::unordered_map<uint64_t, NAtlasGlyph> glyphs_{};
+    std::vector<Page> pages_{};
+    uint64_t frame_{1};
+    uint64_t generation_{0};
+    NGlyphBitmap bitmap_{};
+    std::vector<uint8_t> sdf_{};
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file NGlyphRasterizer.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "NFont.h"
+#include "NPlatform.h"
+
+struct NFontMetrics {
+    float ascent_{0.0F};
+    float descent_{0.0F};
+    float line_gap_{0.0F};
+};
+
+/**
+ * @brief A rasterized glyph. bearing_x_ and bearing_y_ place the bitmap's top-left corner relative to
+ * the pen position on the baseline, with y growing downwards.
+ */
+struct NGlyphBitmap {
+    uint32_t width_{0};
+    uint32_t height_{0};
+    float bearing_x_{0.0F};
+    float bearing_y_{0.0F};
+    float advance_{0.0F};
+    std::vector<uint8_t> coverage_{};
+};
+
+/**
+ * @brief Font backend used by the glyph atlas and the text cache.
+ * Everything is measured in pixels at font.size_.
+ */
+class BDllExport NGlyphRasterizer {
+public:
+    NGlyphRasterizer() = default;
+    virtual ~NGlyphRasterizer() = default;
+    NGlyphRasterizer(const NGlyphRasterizer& rasterizer) = delete;
+    NGlyphRasterizer(NGlyphRasterizer&& rasterizer) = delete;
+    NGlyphRasterizer& operator=(const NGlyphRasterizer& rasterizer) = delete;
+    NGlyphRasterizer& operator=(NGlyphRasterizer&& rasterizer) = delete;
+
+public:
+    virtual NFontMetrics FontMetrics(const NFont& font) = 0;
+    virtual uint32_t GlyphIndex(const NFont& font, char32_t codepoint) = 0;
+    virtual float Advance(const NFont& font, uint32_t glyph) = 0;
+    virtual float Kerning(const NFont& font, char32_t left, char32_t right) = 0;
+    virtual bool Rasterize(const NFont& font, uint32_t glyph, NGlyphBitmap& bitmap) = 0;
+};
+
+#if defined(_WIN32)
+/**
+ * @brief GDI backend: glyph outlines through GetGlyphOutlineW, kerning through GetKerningPairsW.
+ * Characters outside the Basic Multilingual Plane map to the missing glyph.
+ */
+class BDllExport NGdiGlyphRasterizer : public NGlyphRasterizer {
+public:
+    NGdiGlyphRasterizer();
+    ~NGdiGlyphRasterizer() override;
+
+public:
+    NFontMetrics FontMetrics(const NFont& font) override;
+    uint32_t GlyphIndex(const NFont& font, char32_t codepoint) override;
+    float Advance(const NFont& font, uint32_t glyph) override;
+    float Kerning(const NFont& font, char32_t left, char32_t right) override;
+    bool Rasterize(const NFont& font, uint32_t glyph, NGlyphBitmap& bitmap) override;
+
+private:
+    struct FontEntry {
+        HFONT font_{};
+        std::unordered_map<uint32_t, float> kerning_{};
+    };
+
+private:
+    FontEntry& Select(const NFont& font);
+
+private:
+    HDC dc_{};
+    std::unordered_map<std::wstring, FontEntry> fonts_{};
+};
+#endif
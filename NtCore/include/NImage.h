@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file NImage.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "NPlatform.h"
+
+/**
+ * @brief Pixel layout of an NImage. eRGBA8 is 4 bytes per pixel; the others are 4x4 blocks.
+ */
+enum class NImageFormat {
+    eRGBA8,
+    eBC1,
+    eBC3,
+    eBC5,
+    eBC7,
+    eASTC4x4,
+};
+
+struct NImageLevel {
+    uint32_t width_{0};
+    uint32_t height_{0};
+    std::vector<uint8_t> data_{};
+};
+
+/**
+ * @brief A decoded image: the base level first, then any pre-built mip levels.
+ */
+struct BDllExport NImage {
+    NImageFormat format_{NImageFormat::eRGBA8};
+    bool is_srgb_{true};
+    std::vector<NImageLevel> levels_{};
+
+    uint32_t Width() const;
+    uint32_t Height() const;
+    bool Empty() const;
+    bool IsCompressed() const;
+    bool HasMipChain() const;
+
+    /**
+     * @brief Appends box-filtered levels down to 1x1. Only for eRGBA8; odd edges are clamped.
+     */
+    void GenerateMips();
+
+    static uint32_t MipCount(uint32_t width, uint32_t height);
+    static size_t LevelSize(NImageFormat format, uint32_t width, uint32_t height);
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file NImageLoader.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NImage.h"
+#include "NPlatform.h"
+
+/**
+ * @brief Decodes image files on a pool of worker threads.
+ * Built in are binary PPM, uncompressed TGA, DDS with BC1/BC3/BC5/BC7 mip chains and single-level
+ * .astc 4x4 files. Other formats are handled by decoders added before the first load; they run on
+ * the workers, so they must be thread-safe, and return false for data they don't recognize.
+ * With generate_mips an uncompressed image without a full chain also gets its mips built on the worker.
+ * A failed decode rethrows from the future's get().
+ */
+class BDllExport NImageLoader {
+public:
+    explicit NImageLoader(size_t thread_count = 0);
+    ~NImageLoader();
+    NImageLoader(const NImageLoader& loader) = delete;
+    NImageLoader(NImageLoader&& loader) = delete;
+    NImageLoader& operator=(const NImageLoader& loader) = delete;
+    NImageLoader& operator=(NImageLoader&& loader) = delete;
+
+public:
+    using Decoder = std::function<bool(const std::vector<uint8_t>& bytes, NImage& image)>;
+
+public:
+    void AddDecoder(Decoder decoder);
+    std::future<NImage> Load(const std::filesystem::path& path, bool generate_mips = false);
+    std::future<NImage> Decode(std::vector<uint8_t> bytes, bool generate_mips = false);
+    size_t ThreadCount() const;
+    NImage DecodeNow(const std::vector<uint8_t>& bytes, bool generate_mips = false) const;
+
+    static bool DecodePpm(const std::vector<uint8_t>& bytes, NImage& image);
+    static bool DecodeTga(const std::vector<uint8_t>& bytes, NImage& image);
+    static bool DecodeDds(const std::vector<uint8_t>& bytes, NImage& image);
+    static bool DecodeAstc(const std::vector<uint8_t>& bytes, NImage& image);
+
+private:
+    std::future<NImage> Enqueue(std::function<NImage()> work);
+    void WorkerMain();
+
+private:
+    std::vector<Decoder> decoders_{};
+    std::vector<std::thread> workers_{};
+    std::mutex mutex_{};
+    std::condition_variable condition_{};
+    std::deque<std::packaged_task<NImage()>> tasks_{};
+    bool is_stopping_{false};
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file NItemTree.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "NAabbTree.h"
+#include "NDrawList.h"
+#include "NMouseEvent.h"
+#include "NPlatform.h"
+#include "NRect.h"
+
+using NItemID = uint32_t;
+
+/**
+ * @brief Retained tree of canvas items indexed by an NAabbTree.
+ * Bounds are in canvas coordinates. Items paint in pre-order: a parent under its children, and
+ * earlier siblings under later ones. Only items that are visible together with all of their
+ * ancestors are in the index, so Record culls against the viewport and HitTest resolves a point
+ * without walking the tree. Changes report the affected bounds through the invalidate callback.
+ * IDs of removed items are reused.
+ */
+class BDllExport NItemTree {
+public:
+    NItemTree();
+    ~NItemTree() = default;
+    NItemTree(const NItemTree& tree) = delete;
+    NItemTree(NItemTree&& tree) = delete;
+    NItemTree& operator=(const NItemTree& tree) = delete;
+    NItemTree& operator=(NItemTree&& tree) = delete;
+
+public:
+    using DrawCallback = std::function<void(NDrawList& draw_list, const NRect& bounds)>;
+    using HitTestCallback = std::function<bool(const NPoint& point)>;
+    using MouseListener = std::function<bool(NItemID item, const NMouseEvent& event)>;
+    using InvalidateCallback = std::function<void(const NRect& rect)>;
+
+public:
+    NItemID Add(NItemID parent, const NRect& bounds, DrawCallback draw = {});
+    void Remove(NItemID item);
+    void Clear();
+    bool Contains(NItemID item) const;
+    NItemID Parent(NItemID item) const;
+    const std::vector<NItemID>& Children(NItemID item) const;
+    const NRect& Bounds(NItemID item) const;
+    void SetBounds(NItemID item, const NRect& bounds);
+    bool IsVisible(NItemID item) const;
+    void SetVisible(NItemID item, bool is_visible);
+    void SetDraw(NItemID item, DrawCallback draw);
+    void SetHitTest(NItemID item, HitTestCallback hit_test);
+    void SetMouseListener(NItemID item, MouseListener listener);
+    void Update(NItemID item);
+    void SetInvalidateCallback(InvalidateCallback callback);
+    size_t Record(NDrawList& draw_list, const NRect& viewport);
+    NItemID HitTest(const NPoint& point);
+    bool DispatchMouseEvent(const NMouseEvent& event);
+    size_t Size() const;
+    const NAabbTree& Index() const;
+
+public:
+    static constexpr NItemID ROOT{0};
+
+private:
+    struct Item {
+        NItemID parent_{ROOT};
+        std::vector<NItemID> children_{};
+        NRect bounds_{};
+        DrawCallback draw_{};
+        HitTestCallback hit_test_{};
+        MouseListener mouse_listener_{};
+        int32_t proxy_{NAabbTree::NULL_NODE};
+        uint32_t order_{0};
+        bool is_visible_{true};
+        bool is_alive_{false};
+    };
+
+private:
+    Item& At(NItemID item);
+    const Item& At(NItemID item) const;
+    bool IsShown(NItemID item) const;
+    void Show(NItemID item);
+    void Hide(NItemID item);
+    void Release(NItemID item);
+    void UpdateOrder();
+    void Invalidate(const NRect& rect) const;
+
+private:
+    std::vector<Item> items_{};
+    std::vector<NItemID> free_ids_{};
+    NAabbTree index_{};
+    InvalidateCallback invalidate_callback_{};
+    std::vector<NItemID> visible_{};
+    bool is_order_dirty_{false};
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file NMouseEvent.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NPoint.h"
+
+enum class NMouseEventType {
+    eMove,
+    ePress,
+    eRelease,
+};
+
+enum class NMouseButton {
+    eNone,
+    eLeft,
+    eMiddle,
+    eRight,
+};
+
+/**
+ * @brief A pointer event in canvas coordinates.
+ */
+struct NMouseEvent {
+    NMouseEventType type_{NMouseEventType::eMove};
+    NPoint position_{};
+    NMouseButton button_{NMouseButton::eNone};
+};
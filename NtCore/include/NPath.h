@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file NPath.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "NPlatform.h"
+#include "NPoint.h"
+#include "NRect.h"
+
+enum class NPathVerb : uint8_t {
+    eMove,
+    eLine,
+    eQuad,
+    eCubic,
+    eClose,
+};
+
+enum class NFillRule : uint8_t {
+    eNonZero,
+    eEvenOdd,
+};
+
+enum class NLineJoin : uint8_t {
+    eMiter,
+    eBevel,
+};
+
+enum class NLineCap : uint8_t {
+    eButt,
+    eSquare,
+};
+
+struct NStrokeStyle {
+    float width_{1.0F};
+    NLineJoin join_{NLineJoin::eMiter};
+    NLineCap cap_{NLineCap::eButt};
+    float miter_limit_{4.0F};
+};
+
+/**
+ * @brief Tessellated path geometry in path space, drawn as a triangle list.
+ * A stencil mesh is a fan per contour that only marks coverage in the stencil buffer; its last six
+ * vertices are the bounding quad that is then drawn with the stencil test.
+ */
+struct NPathMesh {
+    std::vector<NPoint> vertices_{};
+    uint32_t fill_vertex_count_{0};
+    bool is_stencil_{false};
+    NFillRule fill_rule_{NFillRule::eNonZero};
+    NRect bounds_{};
+};
+
+/**
+ * @brief Move, line, quadratic and cubic commands with a hash kept up to date as they are added,
+ * so caches can key on a path without walking it.
+ */
+class BDllExport NPath {
+public:
+    NPath() = default;
+    ~NPath() = default;
+    NPath(const NPath& path) = default;
+    NPath(NPath&& path) = default;
+    NPath& operator=(const NPath& path) = default;
+    NPath& operator=(NPath&& path) = default;
+
+public:
+    void MoveTo(const NPoint& point);
+    void LineTo(const NPoint& point);
+    void QuadTo(const NPoint& control, const NPoint& point);
+    void CubicTo(const NPoint& control1, const NPoint& control2, const NPoint& point);
+    void Close();
+    void Clear();
+    bool Empty() const;
+    uint64_t Hash() const;
+    const std::vector<NPathVerb>& Verbs() const;
+    const std::vector<NPoint>& Points() const;
+    bool operator==(const NPath& path) const;
+
+private:
+    void Add(NPathVerb verb);
+    void Add(const NPoint& point);
+
+private:
+    std::vector<NPathVerb> verbs_{};
+    std::vector<NPoint> points_{};
+    uint64_t hash_{HASH_SEED};
+
+private:
+    static constexpr uint64_t HASH_SEED{0xcbf29ce484222325ULL};
+};
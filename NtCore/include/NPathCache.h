@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file NPathCache.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "NPath.h"
+#include "NPlatform.h"
+#include "NTransform.h"
+
+/**
+ * @brief Tessellated fills and strokes keyed by path hash, style and transform class.
+ * The transform class is the transform's scale rounded up to a quarter octave: curves are flattened
+ * finely enough for that scale and the rest of the transform is applied when drawing, so a path that
+ * only moves or rotates is tessellated once. Convex and simple single contours are triangulated on
+ * the CPU; fills with several contours, self-intersections, too many points or the dynamic hint
+ * become stencil-then-cover meshes, which cost no triangulation at all. Dynamic fills are not cached.
+ */
+class BDllExport NPathCache {
+public:
+    explicit NPathCache(size_t capacity = DEFAULT_CAPACITY);
+    ~NPathCache() = default;
+    NPathCache(const NPathCache& cache) = delete;
+    NPathCache(NPathCache&& cache) = delete;
+    NPathCache& operator=(const NPathCache& cache) = delete;
+    NPathCache& operator=(NPathCache&& cache) = delete;
+
+public:
+    std::shared_ptr<const NPathMesh> Fill(const NPath& path, NFillRule rule, const NTransform& transform, bool is_dynamic = false);
+    std::shared_ptr<const NPathMesh> Stroke(const NPath& path, const NStrokeStyle& style, const NTransform& transform);
+    void SetStencilFallback(bool enabled);
+    void Clear();
+    size_t Size() const;
+    uint64_t TessellationCount() const;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY{1024};
+    static constexpr float TOLERANCE{0.25F};
+    static constexpr size_t COMPLEX_POINT_COUNT{256};
+
+private:
+    struct Key {
+        uint64_t hash_{0};
+        bool is_stroke_{false};
+        NFillRule fill_rule_{NFillRule::eNonZero};
+        NStrokeStyle stroke_{};
+        int32_t scale_class_{0};
+
+        bool operator==(const Key& key) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key_{};
+        NPath path_{};
+        std::shared_ptr<const NPathMesh> mesh_{};
+    };
+
+    using Contour = std::vector<NPoint>;
+
+private:
+    std::shared_ptr<const NPathMesh> Find(const Key& key, const NPath& path);
+    void Insert(const Key& key, const NPath& path, const std::shared_ptr<const NPathMesh>& mesh);
+    void Flatten(const NPath& path, float tolerance, std::vector<Contour>& contours, std::vector<bool>& closed) const;
+    std::shared_ptr<NPathMesh> TessellateFill(const NPath& path, NFillRule rule, float tolerance, bool is_dynamic);
+    std::shared_ptr<NPathMesh> TessellateStroke(const NPath& path, const NStrokeStyle& style, float tolerance);
+
+private:
+    size_t capacity_{DEFAULT_CAPACITY};
+    bool is_stencil_fallback_{true};
+    std::list<Entry> entries_{};
+    std::unordered_map<Key, std::vector<std::list<Entry>::iterator>, KeyHash> lookup_{};
+    uint64_t tessellation_count_{0};
+    std::vector<Contour> contours_{};
+    std::vector<bool> closed_{};
+};
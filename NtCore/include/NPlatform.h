@@ -23,4 +23,14 @@
 using NCanvasID = HWND;
 static const wchar_t* N_CLASS_NAME{L"NWindows"};
 
+#else
+
+#include <xcb/xcb.h>
+
+#if !defined(BDllExport)
+#define BDllExport __attribute__((visibility("default")))
+#endif
+
+using NCanvasID = xcb_window_t;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * @file NPoint.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+struct NPoint {
+    float x_{0.0F};
+    float y_{0.0F};
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file NProfiler.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "NPlatform.h"
+
+/**
+ * @brief A finished zone. name_ must outlive the profiler; zones take string literals.
+ */
+struct NProfileEvent {
+    const char* name_{nullptr};
+    int64_t begin_{0};
+    int64_t end_{0};
+    uint32_t thread_{0};
+    bool is_gpu_{false};
+};
+
+/**
+ * @brief Collects timed zones from any thread and exports them as a Chrome trace.
+ * Every thread records into its own single-producer ring, so recording takes no lock; Collect drains
+ * the rings and may run on any thread. A full ring drops new zones until the next Collect. When a
+ * thread exits its ring goes back to a free list and the next new thread takes it over, id included.
+ * Times are steady-clock nanoseconds; GPU zones are converted into the same clock before recording.
+ * Instrument code through the N_PROFILE_* macros, which compile to nothing unless NT_PROFILER is defined.
+ */
+class BDllExport NProfiler {
+public:
+    static NProfiler& Singleton() {
+        static NProfiler profiler;
+        return profiler;
+    }
+
+private:
+    NProfiler();
+
+public:
+    ~NProfiler() = default;
+    NProfiler(const NProfiler& profiler) = delete;
+    NProfiler(NProfiler&& profiler) = delete;
+    NProfiler& operator=(const NProfiler& profiler) = delete;
+    NProfiler& operator=(NProfiler&& profiler) = delete;
+
+public:
+    void Record(const char* name, int64_t begin, int64_t end, bool is_gpu = false);
+    void SetThreadName(const std::string& name);
+    void Collect();
+    void Clear();
+    const std::vector<NProfileEvent>& Events() const;
+    uint64_t DroppedCount() const;
+    size_t RingCount();
+    std::string ChromeTrace();
+    void WriteChromeTrace(const std::filesystem::path& path);
+
+    static int64_t Now();
+
+public:
+    static constexpr size_t RING_SIZE{16384};
+
+private:
+    struct ThreadRing {
+        std::array<NProfileEvent, RING_SIZE> events_{};
+        std::atomic<uint64_t> head_{0};
+        std::atomic<uint64_t> tail_{0};
+        uint32_t thread_{0};
+        std::string name_{};
+    };
+
+private:
+    ThreadRing& CurrentRing();
+    void ReleaseRing(ThreadRing& ring);
+
+private:
+    std::mutex mutex_{};
+    std::vector<std::unique_ptr<ThreadRing>> rings_{};
+    std::vector<ThreadRing*> free_rings_{};
+    std::map<uint32_t, std::string> exited_threads_{};
+    uint32_t next_thread_{1};
+    std::vector<NProfileEvent> events_{};
+    std::atomic<uint64_t> dropped_{0};
+    int64_t epoch_{0};
+};
+
+/**
+ * @brief Records the enclosing scope as a zone on the current thread.
+ */
+class NProfileZone {
+public:
+    explicit NProfileZone(const char* name) : name_(name), begin_(NProfiler::Now()) {}
+    ~NProfileZone() {
+        NProfiler::Singleton().Record(name_, begin_, NProfiler::Now());
+    }
+    NProfileZone(const NProfileZone& zone) = delete;
+    NProfileZone(NProfileZone&& zone) = delete;
+    NProfileZone& operator=(const NProfileZone& zone) = delete;
+    NProfileZone& operator=(NProfileZone&& zone) = delete;
+
+private:
+    const char* name_{nullptr};
+    int64_t begin_{0};
+};
+
+#define N_PROFILE_CONCAT_INNER(a, b) a##b
+#define N_PROFILE_CONCAT(a, b) N_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(NT_PROFILER)
+#define N_PROFILE_ZONE(name) NProfileZone N_PROFILE_CONCAT(n_profile_zone_, __LINE__)(name)
+#define N_PROFILE_THREAD(name) NProfiler::Singleton().SetThreadName(name)
+#else
+#define N_PROFILE_ZONE(name) ((void)0)
+#define N_PROFILE_THREAD(name) ((void)0)
+#endif
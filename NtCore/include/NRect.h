@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file NRect.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+
+struct NRect {
+    float x_{0.0F};
+    float y_{0.0F};
+    float width_{0.0F};
+    float height_{0.0F};
+
+    float Right() const {
+        return x_ + width_;
+    }
+
+    float Bottom() const {
+        return y_ + height_;
+    }
+
+    bool Empty() const {
+        return width_ <= 0.0F || height_ <= 0.0F;
+    }
+
+    bool Intersects(const NRect& rect) const {
+        return x_ < rect.Right() && rect.x_ < Right() && y_ < rect.Bottom() && rect.y_ < Bottom();
+    }
+
+    NRect United(const NRect& rect) const {
+        auto left = (std::min)(x_, rect.x_);
+        auto top = (std::min)(y_, rect.y_);
+        return {left, top, (std::max)(Right(), rect.Right()) - left, (std::max)(Bottom(), rect.Bottom()) - top};
+    }
+};
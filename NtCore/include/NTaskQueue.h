@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file NTaskQueue.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "NPlatform.h"
+
+/**
+ * @brief Intrusive lock-free multi-producer single-consumer task queue.
+ * Any thread may Push; only the owning thread may Drain.
+ */
+class BDllExport NTaskQueue {
+public:
+    NTaskQueue();
+    ~NTaskQueue();
+    NTaskQueue(const NTaskQueue& task_queue) = delete;
+    NTaskQueue(NTaskQueue&& task_queue) = delete;
+    NTaskQueue& operator=(const NTaskQueue& task_queue) = delete;
+    NTaskQueue& operator=(NTaskQueue&& task_queue) = delete;
+
+public:
+    /**
+     * @brief Push a callable, which may be move-only.
+     * @return true if the queue was empty before this push and the consumer needs a wakeup.
+     */
+    template <typename Callable>
+    bool Push(Callable&& callable) {
+        return PushNode(new Task<std::decay_t<Callable>>(std::forward<Callable>(callable)));
+    }
+
+    /**
+     * @brief Run queued tasks until the queue is empty or the budget is spent.
+     * The clock is read after every task, so the budget is overrun by at most the last task.
+     * @return the number of tasks that ran.
+     */
+    size_t Drain(std::chrono::steady_clock::duration budget);
+    bool Empty() const;
+    size_t Size() const;
+
+private:
+    struct Node {
+        virtual ~Node() = default;
+        virtual void Run() {}
+        std::atomic<Node*> next_{};
+    };
+
+    template <typename Callable>
+    struct Task final : Node {
+        explicit Task(Callable&& callable) : callable_(std::move(callable)) {}
+        explicit Task(const Callable& callable) : callable_(callable) {}
+        void Run() override {
+            callable_();
+        }
+        Callable callable_;
+    };
+
+private:
+    bool PushNode(Node* node);
+    void Link(Node* node);
+    Node* Pop();
+
+private:
+    Node stub_{};
+    std::atomic<Node*> head_{};
+    Node* tail_{};
+    std::atomic<size_t> size_{0};
+};
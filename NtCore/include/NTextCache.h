@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file NTextCache.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "NColor.h"
+#include "NDrawList.h"
+#include "NFont.h"
+#include "NGlyphAtlas.h"
+#include "NGlyphRasterizer.h"
+#include "NPlatform.h"
+#include "NPoint.h"
+
+struct NShapedGlyph {
+    uint32_t glyph_{0};
+    float x_{0.0F};
+};
+
+/**
+ * @brief A single line of text laid out along its baseline, plus the glyph quads last resolved
+ * against the atlas.
+ */
+struct NShapedRun {
+    std::vector<NShapedGlyph> glyphs_{};
+    std::vector<NGlyphQuad> quads_{};
+    std::vector<uint32_t> pages_{};
+    float width_{0.0F};
+    float ascent_{0.0F};
+    float descent_{0.0F};
+    uint64_t atlas_generation_{0};
+    bool is_resolved_{false};
+};
+
+/**
+ * @brief Shaped runs keyed by string and font, evicted least recently used first.
+ * Shaping is codepoint to glyph with pair kerning; a label drawn again with the same string, font and
+ * size reuses both its layout and its atlas quads, and only looks its glyphs up again after the atlas
+ * evicted a page. References returned by Shape stay valid until the next call to Shape or DrawText.
+ */
+class BDllExport NTextCache {
+public:
+    NTextCache(NGlyphRasterizer& rasterizer, NGlyphAtlas& atlas, size_t capacity = DEFAULT_CAPACITY);
+    NTextCache() = delete;
+    ~NTextCache() = default;
+    NTextCache(const NTextCache& cache) = delete;
+    NTextCache(NTextCache&& cache) = delete;
+    NTextCache& operator=(const NTextCache& cache) = delete;
+    NTextCache& operator=(NTextCache&& cache) = delete;
+
+public:
+    const NShapedRun& Shape(std::wstring_view text, const NFont& font);
+    void DrawText(NDrawList& list, std::wstring_view text, const NFont& font, const NPoint& baseline, const NColor& color);
+    void Clear();
+    size_t Size() const;
+    uint64_t ShapeCount() const;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY{4096};
+
+private:
+    struct Key {
+        std::wstring text_{};
+        NFont font_{};
+    };
+
+    struct KeyView {
+        std::wstring_view text_{};
+        const NFont* font_{nullptr};
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const Key& key) const;
+        size_t operator()(const KeyView& key) const;
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+        bool operator()(const Key& left, const Key& right) const;
+        bool operator()(const KeyView& left, const Key& right) const;
+        bool operator()(const Key& left, const KeyView& right) const;
+    };
+
+    struct Entry {
+        Key key_{};
+        NShapedRun run_{};
+    };
+
+private:
+    NShapedRun& Find(std::wstring_view text, const NFont& font);
+    void ShapeRun(std::wstring_view text, const NFont& font, NShapedRun& run);
+    void Resolve(const NFont& font, NShapedRun& run);
+
+private:
+    NGlyphRasterizer& rasterizer_;
+    NGlyphAtlas& atlas_;
+    size_t capacity_{DEFAULT_CAPACITY};
+    std::list<Entry> entries_{};
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEqual> lookup_{};
+    uint64_t shape_count_{0};
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file NTransform.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "NPoint.h"
+#include "NRect.h"
+
+/**
+ * @brief 2D affine transform: x' = a x + c y + tx, y' = b x + d y + ty.
+ */
+struct NTransform {
+    float a_{1.0F};
+    float b_{0.0F};
+    float c_{0.0F};
+    float d_{1.0F};
+    float tx_{0.0F};
+    float ty_{0.0F};
+
+    static NTransform Translation(float x, float y) {
+        return {1.0F, 0.0F, 0.0F, 1.0F, x, y};
+    }
+
+    static NTransform Scale(float x, float y) {
+        return {x, 0.0F, 0.0F, y, 0.0F, 0.0F};
+    }
+
+    static NTransform Rotation(float radians) {
+        auto cos = std::cos(radians);
+        auto sin = std::sin(radians);
+        return {cos, sin, -sin, cos, 0.0F, 0.0F};
+    }
+
+    NTransform operator*(const NTransform& transform) const {
+        return {
+            a_ * transform.a_ + c_ * transform.b_,
+            b_ * transform.a_ + d_ * transform.b_,
+            a_ * transform.c_ + c_ * transform.d_,
+            b_ * transform.c_ + d_ * transform.d_,
+            a_ * transform.tx_ + c_ * transform.ty_ + tx_,
+            b_ * transform.tx_ + d_ * transform.ty_ + ty_,
+        };
+    }
+
+    NPoint Apply(const NPoint& point) const {
+        return {a_ * point.x_ + c_ * point.y_ + tx_, b_ * point.x_ + d_ * point.y_ + ty_};
+    }
+
+    NRect Apply(const NRect& rect) const {
+        NPoint corners[4]{Apply(NPoint{rect.x_, rect.y_}), Apply(NPoint{rect.Right(), rect.y_}), Apply(NPoint{rect.x_, rect.Bottom()}), Apply(NPoint{rect.Right(), rect.Bottom()})};
+        auto left = corners[0].x_;
+        auto top = corners[0].y_;
+        auto right = left;
+        auto bottom = top;
+        for (const auto& corner : corners) {
+            left = (std::min)(left, corner.x_);
+            top = (std::min)(top, corner.y_);
+            right = (std::max)(right, corner.x_);
+            bottom = (std::max)(bottom, corner.y_);
+        }
+        return {left, top, right - left, bottom - top};
+    }
+
+    // The largest factor any length is stretched by.
+    float MaxScale() const {
+        return (std::max)(std::sqrt(a_ * a_ + b_ * b_), std::sqrt(c_ * c_ + d_ * d_));
+    }
+};
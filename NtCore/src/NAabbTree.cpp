@@ -0,0 +1,216 @@
+/**
+ * @file NAabbTree.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NAabbTree.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+int32_t NAabbTree::Insert(const NRect& bounds, uint32_t user_data) {
+    auto leaf = AllocateNode();
+    nodes_[leaf].box_ = FatBox(bounds);
+    nodes_[leaf].user_data_ = user_data;
+    nodes_[leaf].height_ = 0;
+    InsertLeaf(leaf);
+    ++size_;
+    return leaf;
+}
+
+void NAabbTree::Remove(int32_t proxy) {
+    if (proxy < 0 || static_cast<size_t>(proxy) >= nodes_.size() || !nodes_[proxy].IsLeaf() || nodes_[proxy].height_ != 0) {
+        throw std::runtime_error("Invalid AABB tree proxy.");
+    }
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --size_;
+}
+
+bool NAabbTree::Move(int32_t proxy, const NRect& bounds) {
+    Box box{bounds.x_, bounds.y_, bounds.Right(), bounds.Bottom()};
+    if (nodes_[proxy].box_.Contains(box)) {
+        return false;
+    }
+    RemoveLeaf(proxy);
+    nodes_[proxy].box_ = FatBox(bounds);
+    InsertLeaf(proxy);
+    return true;
+}
+
+uint32_t NAabbTree::UserData(int32_t proxy) const {
+    return nodes_[proxy].user_data_;
+}
+
+NRect NAabbTree::FatBounds(int32_t proxy) const {
+    const auto& box = nodes_[proxy].box_;
+    return {box.left_, box.top_, box.right_ - box.left_, box.bottom_ - box.top_};
+}
+
+size_t NAabbTree::Size() const {
+    return size_;
+}
+
+int32_t NAabbTree::Height() const {
+    return root_ == NULL_NODE ? 0 : nodes_[root_].height_;
+}
+
+void NAabbTree::Clear() {
+    nodes_.clear();
+    root_ = NULL_NODE;
+    free_list_ = NULL_NODE;
+    size_ = 0;
+}
+
+int32_t NAabbTree::AllocateNode() {
+    if (free_list_ == NULL_NODE) {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+    // Free nodes are chained through parent_.
+    auto index = free_list_;
+    free_list_ = nodes_[index].parent_;
+    nodes_[index] = Node{};
+    return index;
+}
+
+void NAabbTree::FreeNode(int32_t index) {
+    nodes_[index] = Node{};
+    nodes_[index].parent_ = free_list_;
+    free_list_ = index;
+}
+
+void NAabbTree::InsertLeaf(int32_t leaf) {
+    if (root_ == NULL_NODE) {
+        root_ = leaf;
+        nodes_[leaf].parent_ = NULL_NODE;
+        return;
+    }
+    // Descend towards the sibling whose subtree grows least, stopping once pairing here is cheaper.
+    auto leaf_box = nodes_[leaf].box_;
+    auto index = root_;
+    while (!nodes_[index].IsLeaf()) {
+        const auto& node = nodes_[index];
+        auto combined_perimeter = node.box_.United(leaf_box).Perimeter();
+        auto cost = 2.0F * combined_perimeter;
+        auto inheritance_cost = 2.0F * (combined_perimeter - node.box_.Perimeter());
+        auto descend_cost = [this, &leaf_box, inheritance_cost](int32_t child) {
+            const auto& child_node = nodes_[child];
+            auto perimeter = child_node.box_.United(leaf_box).Perimeter();
+            if (!child_node.IsLeaf()) {
+                perimeter -= child_node.box_.Perimeter();
+            }
+            return perimeter + inheritance_cost;
+        };
+        auto cost1 = descend_cost(node.child1_);
+        auto cost2 = descend_cost(node.child2_);
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1_ : node.child2_;
+    }
+
+    auto sibling = index;
+    auto old_parent = nodes_[sibling].parent_;
+    auto new_parent = AllocateNode();
+    nodes_[new_parent].parent_ = old_parent;
+    nodes_[new_parent].box_ = leaf_box.United(nodes_[sibling].box_);
+    nodes_[new_parent].height_ = nodes_[sibling].height_ + 1;
+    nodes_[new_parent].child1_ = sibling;
+    nodes_[new_parent].child2_ = leaf;
+    nodes_[sibling].parent_ = new_parent;
+    nodes_[leaf].parent_ = new_parent;
+    if (old_parent == NULL_NODE) {
+        root_ = new_parent;
+    } else if (nodes_[old_parent].child1_ == sibling) {
+        nodes_[old_parent].child1_ = new_parent;
+    } else {
+        nodes_[old_parent].child2_ = new_parent;
+    }
+    Refit(new_parent);
+}
+
+void NAabbTree::RemoveLeaf(int32_t leaf) {
+    if (leaf == root_) {
+        root_ = NULL_NODE;
+        return;
+    }
+    auto parent = nodes_[leaf].parent_;
+    auto grand_parent = nodes_[parent].parent_;
+    auto sibling = nodes_[parent].child1_ == leaf ? nodes_[parent].child2_ : nodes_[parent].child1_;
+    FreeNode(parent);
+    if (grand_parent == NULL_NODE) {
+        root_ = sibling;
+        nodes_[sibling].parent_ = NULL_NODE;
+        return;
+    }
+    if (nodes_[grand_parent].child1_ == parent) {
+        nodes_[grand_parent].child1_ = sibling;
+    } else {
+        nodes_[grand_parent].child2_ = sibling;
+    }
+    nodes_[sibling].parent_ = grand_parent;
+    Refit(grand_parent);
+}
+
+void NAabbTree::Refit(int32_t index) {
+    while (index != NULL_NODE) {
+        index = Balance(index);
+        auto& node = nodes_[index];
+        const auto& child1 = nodes_[node.child1_];
+        const auto& child2 = nodes_[node.child2_];
+        node.height_ = 1 + (std::max)(child1.height_, child2.height_);
+        node.box_ = child1.box_.United(child2.box_);
+        index = node.parent_;
+    }
+}
+
+int32_t NAabbTree::Balance(int32_t a) {
+    // Rotates the taller grandchild up when the children's heights differ by more than one.
+    if (nodes_[a].IsLeaf() || nodes_[a].height_ < 2) {
+        return a;
+    }
+    auto b = nodes_[a].child1_;
+    auto c = nodes_[a].child2_;
+    auto balance = nodes_[c].height_ - nodes_[b].height_;
+    if (std::abs(balance) <= 1) {
+        return a;
+    }
+    // Rotate the taller child (up) above a; its shorter child moves down to a.
+    auto up = balance > 0 ? c : b;
+    auto other = balance > 0 ? b : c;
+    auto f = nodes_[up].child1_;
+    auto g = nodes_[up].child2_;
+    nodes_[up].child1_ = a;
+    nodes_[up].parent_ = nodes_[a].parent_;
+    nodes_[a].parent_ = up;
+    if (nodes_[up].parent_ == NULL_NODE) {
+        root_ = up;
+    } else if (nodes_[nodes_[up].parent_].child1_ == a) {
+        nodes_[nodes_[up].parent_].child1_ = up;
+    } else {
+        nodes_[nodes_[up].parent_].child2_ = up;
+    }
+    if (nodes_[f].height_ < nodes_[g].height_) {
+        std::swap(f, g);
+    }
+    // f is the taller grandchild and stays under up; g replaces up under a.
+    nodes_[up].child2_ = f;
+    if (balance > 0) {
+        nodes_[a].child2_ = g;
+    } else {
+        nodes_[a].child1_ = g;
+    }
+    nodes_[g].parent_ = a;
+    nodes_[a].box_ = nodes_[other].box_.United(nodes_[g].box_);
+    nodes_[a].height_ = 1 + (std::max)(nodes_[other].height_, nodes_[g].height_);
+    nodes_[up].box_ = nodes_[a].box_.United(nodes_[f].box_);
+    nodes_[up].height_ = 1 + (std::max)(nodes_[a].height_, nodes_[f].height_);
+    return up;
+}
+
+NAabbTree::Box NAabbTree::FatBox(const NRect& bounds) {
+    return {bounds.x_ - MARGIN, bounds.y_ - MARGIN, bounds.Right() + MARGIN, bounds.Bottom() + MARGIN};
+}
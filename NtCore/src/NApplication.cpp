@@ -6,11 +6,37 @@
 
 #include "NApplication.h"
 
-#include "NEventLoop.h"
-
 NApplication::NApplication() : event_loop_(new NEventLoop()) {
 }
 
 int NApplication::Exec() {
     return event_loop_->Exec();
 }
+
+void NApplication::Quit(int exit_code) {
+    event_loop_->Quit(exit_code);
+}
+
+NRunMode NApplication::RunMode() const {
+    return event_loop_->RunMode();
+}
+
+void NApplication::SetRunMode(NRunMode run_mode) {
+    event_loop_->SetRunMode(run_mode);
+}
+
+uint32_t NApplication::TargetFrameRate() const {
+    return event_loop_->TargetFrameRate();
+}
+
+void NApplication::SetTargetFrameRate(uint32_t frame_rate) {
+    event_loop_->SetTargetFrameRate(frame_rate);
+}
+
+void NApplication::SetFrameCallback(std::function<void()> callback) {
+    event_loop_->SetFrameCallback(std::move(callback));
+}
+
+void NApplication::Invalidate() {
+    event_loop_->Invalidate();
+}
@@ -6,9 +6,44 @@
 
 #include "NCanvas.h"
 
+#include <algorithm>
 #include <stdexcept>
 
+#if !defined(_WIN32)
+#include <cstdlib>
+#include <string>
+
+#include "NEventLoop.h"
+
+static std::string ToUtf8(const std::wstring& text) {
+    std::string result;
+    for (auto character : text) {
+        auto code = static_cast<uint32_t>(character);
+        if (code < 0x80) {
+            result.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+    return result;
+}
+#endif
+
 NCanvas::NCanvas() {
+    damage_.AddAll();
+    items_.SetInvalidateCallback([this](const NRect& rect) {
+        Invalidate(rect);
+    });
 #if defined(_WIN32)
     id_ = CreateWindowEx(
         0,
@@ -27,6 +62,32 @@ NCanvas::NCanvas() {
         throw std::runtime_error("Failed to create canvas");
     }
     SetWindowLongPtr(id_, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+#else
+    auto* connection = NEventLoop::Connection();
+    auto* screen = NEventLoop::Screen();
+    id_ = xcb_generate_id(connection);
+    uint32_t event_mask = XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_POINTER_MOTION;
+    auto cookie = xcb_create_window_checked(
+        connection,
+        XCB_COPY_FROM_PARENT,
+        id_,
+        screen->root,
+        static_cast<int16_t>(position_.x_),
+        static_cast<int16_t>(position_.y_),
+        static_cast<uint16_t>((std::max)(size_.width_, 1U)),
+        static_cast<uint16_t>((std::max)(size_.height_, 1U)),
+        0,
+        XCB_WINDOW_CLASS_INPUT_OUTPUT,
+        screen->root_visual,
+        XCB_CW_EVENT_MASK,
+        &event_mask);
+    if (auto* error = xcb_request_check(connection, cookie)) {
+        std::free(error);
+        throw std::runtime_error("Failed to create canvas");
+    }
+    auto delete_window = NEventLoop::Atom("WM_DELETE_WINDOW");
+    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, id_, NEventLoop::Atom("WM_PROTOCOLS"), XCB_ATOM_ATOM, 32, 1, &delete_window);
+    NEventLoop::RegisterCanvas(id_, this);
 #endif
     auto size = GetMonitorSize();
     Move({static_cast<int32_t>(size.width_ / 4), static_cast<int32_t>(size.height_ / 4)}, {size.width_ / 2, size.height_ / 2});
@@ -47,13 +108,33 @@ NSize NCanvas::GetMonitorSize() const {
         return size;
     size.width_ = dm.dmPelsWidth;
     size.height_ = dm.dmPelsHeight;
+#else
+    size.width_ = NEventLoop::Screen()->width_in_pixels;
+    size.height_ = NEventLoop::Screen()->height_in_pixels;
 #endif
     return size;
 }
 
+NCanvas::~NCanvas() {
+#if defined(_WIN32)
+    SetWindowLongPtr(id_, GWLP_USERDATA, 0);
+#else
+    NEventLoop::UnregisterCanvas(id_);
+    xcb_destroy_window(NEventLoop::Connection(), id_);
+    xcb_flush(NEventLoop::Connection());
+#endif
+}
+
+NCanvasID NCanvas::ID() const {
+    return id_;
+}
+
 void NCanvas::Show() const {
 #if defined(_WIN32)
     ShowWindow(id_, 5);
+#else
+    xcb_map_window(NEventLoop::Connection(), id_);
+    xcb_flush(NEventLoop::Connection());
 #endif
 }
 
@@ -65,12 +146,26 @@ void NCanvas::SetTitle(const std::wstring& title) {
     title_ = title;
 #if defined(_WIN32)
     SetWindowText(id_, title_.c_str());
+#else
+    auto title_utf8 = ToUtf8(title_);
+    auto* connection = NEventLoop::Connection();
+    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, id_, XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, static_cast<uint32_t>(title_utf8.size()), title_utf8.data());
+    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, id_, NEventLoop::Atom("_NET_WM_NAME"), NEventLoop::Atom("UTF8_STRING"), 8, static_cast<uint32_t>(title_utf8.size()), title_utf8.data());
+    xcb_flush(connection);
 #endif
 }
 
 void NCanvas::Move(const NPosition& pos, const NSize& size, bool repaint) {
 #if defined(_WIN32)
     MoveWindow(id_, pos.x_, pos.y_, size.width_, size.height_, repaint);
+#else
+    uint32_t values[]{static_cast<uint32_t>(pos.x_), static_cast<uint32_t>(pos.y_), (std::max)(size.width_, 1U), (std::max)(size.height_, 1U)};
+    auto* connection = NEventLoop::Connection();
+    xcb_configure_window(connection, id_, XCB_CONFIG_WINDOW_X | XCB_CONFIG_WINDOW_Y | XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT, values);
+    if (repaint) {
+        xcb_clear_area(connection, 1, id_, 0, 0, 0, 0);
+    }
+    xcb_flush(connection);
 #endif
 }
 
@@ -94,10 +189,91 @@ void NCanvas::Resize(uint32_t width, uint32_t height, bool repaint) {
     Resize({width, height}, repaint);
 }
 
+NPosition NCanvas::Position() const {
+    return position_;
+}
+
+NSize NCanvas::Size() const {
+    return size_;
+}
+
+uint32_t NCanvas::AddGeometryListener(GeometryListener listener) {
+    auto listener_id = next_listener_id_++;
+    geometry_listeners_.emplace(listener_id, std::move(listener));
+    return listener_id;
+}
+
+void NCanvas::RemoveGeometryListener(uint32_t listener_id) {
+    geometry_listeners_.erase(listener_id);
+}
+
+NDrawList& NCanvas::DrawList() {
+    return draw_list_;
+}
+
+NPathCache& NCanvas::PathCache() {
+    return path_cache_;
+}
+
+void NCanvas::FillPath(const NPath& path, const NColor& color, const NTransform& transform, NFillRule rule, bool is_dynamic) {
+    draw_list_.DrawPath(path_cache_.Fill(path, rule, transform, is_dynamic), transform, color);
+}
+
+void NCanvas::StrokePath(const NPath& path, const NStrokeStyle& style, const NColor& color, const NTransform& transform) {
+    draw_list_.DrawPath(path_cache_.Stroke(path, style, transform), transform, color);
+}
+
+void NCanvas::Invalidate(const NRect& rect) {
+    damage_.Add(rect);
+}
+
+void NCanvas::InvalidateAll() {
+    damage_.AddAll();
+}
+
+bool NCanvas::HasDamage() const {
+    return !damage_.Empty();
+}
+
+NDamageRegion NCanvas::TakeDamage() {
+    auto damage = std::move(damage_);
+    damage_.Clear();
+    return damage;
+}
+
+NItemTree& NCanvas::Items() {
+    return items_;
+}
+
+size_t NCanvas::DrawItems() {
+    return items_.Record(draw_list_, {0.0F, 0.0F, static_cast<float>(size_.width_), static_cast<float>(size_.height_)});
+}
+
 void NCanvas::MoveEvent(const NPosition& pos) {
     position_ = pos;
 }
 
 void NCanvas::ResizeEvent(const NSize& size) {
+    if (size.width_ != size_.width_ || size.height_ != size_.height_) {
+        damage_.AddAll();
+    }
     size_ = size;
 }
+
+void NCanvas::GeometryEvent(const NPosition& pos, const NSize& size) {
+    auto is_moved = pos.x_ != position_.x_ || pos.y_ != position_.y_;
+    auto is_resized = size.width_ != size_.width_ || size.height_ != size_.height_;
+    if (!is_moved && !is_resized) {
+        return;
+    }
+    MoveEvent(pos);
+    ResizeEvent(size);
+    auto listeners = geometry_listeners_;
+    for (const auto& [listener_id, listener] : listeners) {
+        listener(position_, size_);
+    }
+}
+
+bool NCanvas::MouseEvent(const NMouseEvent& event) {
+    return items_.DispatchMouseEvent(event);
+}
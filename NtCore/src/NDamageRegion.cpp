@@ -0,0 +1,100 @@
+/**
+ * @file NDamageRegion.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NDamageRegion.h"
+
+static float Area(const NRect& rect) {
+    return rect.width_ * rect.height_;
+}
+
+static bool Touches(const NRect& a, const NRect& b) {
+    return a.x_ <= b.Right() && b.x_ <= a.Right() && a.y_ <= b.Bottom() && b.y_ <= a.Bottom();
+}
+
+void NDamageRegion::Add(const NRect& rect) {
+    if (is_full_ || rect.Empty()) {
+        return;
+    }
+    // Absorb every rect the new one touches; the union may touch more, so repeat until it is stable.
+    auto merged = rect;
+    for (auto is_growing = true; is_growing;) {
+        is_growing = false;
+        for (size_t i = 0; i < rects_.size();) {
+            if (Touches(rects_[i], merged)) {
+                merged = merged.United(rects_[i]);
+                rects_[i] = rects_.back();
+                rects_.pop_back();
+                is_growing = true;
+            } else {
+                ++i;
+            }
+        }
+    }
+    rects_.push_back(merged);
+    if (rects_.size() <= MAX_RECTS) {
+        return;
+    }
+    size_t best_a = 0;
+    size_t best_b = 1;
+    auto best_waste = -1.0F;
+    for (size_t a = 0; a < rects_.size(); ++a) {
+        for (size_t b = a + 1; b < rects_.size(); ++b) {
+            auto waste = Area(rects_[a].United(rects_[b])) - Area(rects_[a]) - Area(rects_[b]);
+            if (best_waste < 0.0F || waste < best_waste) {
+                best_waste = waste;
+                best_a = a;
+                best_b = b;
+            }
+        }
+    }
+    auto united = rects_[best_a].United(rects_[best_b]);
+    rects_.erase(rects_.begin() + static_cast<std::ptrdiff_t>(best_b));
+    rects_.erase(rects_.begin() + static_cast<std::ptrdiff_t>(best_a));
+    Add(united);
+}
+
+void NDamageRegion::Add(const NDamageRegion& region) {
+    if (region.is_full_) {
+        AddAll();
+        return;
+    }
+    for (const auto& rect : region.rects_) {
+        Add(rect);
+    }
+}
+
+void NDamageRegion::AddAll() {
+    is_full_ = true;
+    rects_.clear();
+}
+
+void NDamageRegion::Clear() {
+    is_full_ = false;
+    rects_.clear();
+}
+
+bool NDamageRegion::Empty() const {
+    return !is_full_ && rects_.empty();
+}
+
+bool NDamageRegion::IsFull() const {
+    return is_full_;
+}
+
+NRect NDamageRegion::Bounds() const {
+    if (rects_.empty()) {
+        return {};
+    }
+    auto bounds = rects_[0];
+    for (const auto& rect : rects_) {
+        bounds = bounds.United(rect);
+    }
+    return bounds;
+}
+
+const std::vector<NRect>& NDamageRegion::Rects() const {
+    return rects_;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file NDrawList.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NDrawList.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Shapes are anti-aliased over one pixel outside their geometry.
+static constexpr float AA_MARGIN{1.0F};
+
+static void SetColor(NDrawInstance& instance, const NColor& color) {
+    instance.color_[0] = color.r_;
+    instance.color_[1] = color.g_;
+    instance.color_[2] = color.b_;
+    instance.color_[3] = color.a_;
+}
+
+static void SetRect(float (&target)[4], const NRect& rect) {
+    target[0] = rect.x_;
+    target[1] = rect.y_;
+    target[2] = rect.width_;
+    target[3] = rect.height_;
+}
+
+static NRect Inflate(const NRect& rect, float margin) {
+    return {rect.x_ - margin, rect.y_ - margin, rect.width_ + margin * 2.0F, rect.height_ + margin * 2.0F};
+}
+
+template <typename Visitor>
+bool NDrawList::VisitTiles(const NRect& bounds, Visitor&& visitor) {
+    auto to_tile = [](float coordinate) {
+        return std::clamp(static_cast<int64_t>(std::floor(coordinate / TILE_SIZE)), int64_t{0}, TILE_GRID_SIZE - 1);
+    };
+    auto left = to_tile(bounds.x_);
+    auto top = to_tile(bounds.y_);
+    auto right = to_tile(bounds.Right());
+    auto bottom = to_tile(bounds.Bottom());
+    if ((right - left + 1) * (bottom - top + 1) > LARGE_TILE_COUNT) {
+        return false;
+    }
+    if (tiles_.empty()) {
+        tiles_.resize(TILE_GRID_SIZE * TILE_GRID_SIZE);
+    }
+    for (auto y = top; y <= bottom; ++y) {
+        for (auto x = left; x <= right; ++x) {
+            visitor(tiles_[y * TILE_GRID_SIZE + x]);
+        }
+    }
+    return true;
+}
+
+void NDrawList::Clear() {
+    recorded_.clear();
+    recorded_batches_.clear();
+    open_batches_.clear();
+    last_batches_.clear();
+    // Keep the tile vectors around; the next frame usually touches the same tiles.
+    for (auto& occupants : tiles_) {
+        occupants.clear();
+    }
+    large_occupants_.clear();
+    scratch_.clear();
+    instances_.clear();
+    batches_.clear();
+    meshes_.clear();
+    mesh_indices_.clear();
+    is_finished_ = true;
+}
+
+void NDrawList::DrawRect(const NRect& rect, const NColor& color) {
+    if (rect.Empty() || color.a_ <= 0.0F) {
+        return;
+    }
+    NDrawInstance instance{};
+    SetRect(instance.rect_, rect);
+    SetColor(instance, color);
+    instance.primitive_ = NDrawPrimitive::eRect;
+    Add(NDrawPipeline::eShape, 0, Inflate(rect, AA_MARGIN), &instance, 1);
+}
+
+void NDrawList::DrawRoundedRect(const NRect& rect, float radius, const NColor& color) {
+    if (rect.Empty() || color.a_ <= 0.0F) {
+        return;
+    }
+    NDrawInstance instance{};
+    SetRect(instance.rect_, rect);
+    SetColor(instance, color);
+    instance.radius_ = (std::max)(radius, 0.0F);
+    instance.primitive_ = NDrawPrimitive::eRoundedRect;
+    Add(NDrawPipeline::eShape, 0, Inflate(rect, AA_MARGIN), &instance, 1);
+}
+
+void NDrawList::DrawLine(const NPoint& from, const NPoint& to, float width, const NColor& color) {
+    if (width <= 0.0F || color.a_ <= 0.0F) {
+        return;
+    }
+    NDrawInstance instance{};
+    instance.rect_[0] = from.x_;
+    instance.rect_[1] = from.y_;
+    instance.rect_[2] = to.x_;
+    instance.rect_[3] = to.y_;
+    SetColor(instance, color);
+    instance.stroke_width_ = width;
+    instance.primitive_ = NDrawPrimitive::eLine;
+    NRect bounds{(std::min)(from.x_, to.x_), (std::min)(from.y_, to.y_), std::abs(to.x_ - from.x_), std::abs(to.y_ - from.y_)};
+    Add(NDrawPipeline::eShape, 0, Inflate(bounds, width * 0.5F + AA_MARGIN), &instance, 1);
+}
+
+void NDrawList::DrawImage(NTextureID texture, const NRect& rect, const NColor& tint, const NRect& uv) {
+    if (rect.Empty() || tint.a_ <= 0.0F) {
+        return;
+    }
+    NDrawInstance instance{};
+    SetRect(instance.rect_, rect);
+    SetRect(instance.uv_, uv);
+    SetColor(instance, tint);
+    instance.primitive_ = NDrawPrimitive::eImage;
+    Add(NDrawPipeline::eImage, texture, rect, &instance, 1);
+}
+
+void NDrawList::DrawGlyphs(const std::vector<NGlyphQuad>& quads, const NPoint& origin, const NColor& color) {
+    if (quads.empty() || color.a_ <= 0.0F) {
+        return;
+    }
+    // A run is added as one occupant per atlas page rather than one per glyph.
+    size_t first = 0;
+    while (first < quads.size()) {
+        auto texture = quads[first].texture_;
+        auto last = first;
+        scratch_.clear();
+        NRect bounds{};
+        for (; last < quads.size() && quads[last].texture_ == texture; ++last) {
+            NRect rect{quads[last].rect_.x_ + origin.x_, quads[last].rect_.y_ + origin.y_, quads[last].rect_.width_, quads[last].rect_.height_};
+            bounds = last == first ? rect : bounds.United(rect);
+            NDrawInstance instance{};
+            SetRect(instance.rect_, rect);
+            SetRect(instance.uv_, quads[last].uv_);
+            SetColor(instance, color);
+            instance.primitive_ = NDrawPrimitive::eGlyph;
+            scratch_.push_back(instance);
+        }
+        Add(NDrawPipeline::eText, texture, bounds, scratch_.data(), scratch_.size());
+        first = last;
+    }
+}
+
+void NDrawList::DrawPath(const std::shared_ptr<const NPathMesh>& mesh, const NTransform& transform, const NColor& color) {
+    if (!mesh || mesh->fill_vertex_count_ == 0 || color.a_ <= 0.0F) {
+        return;
+    }
+    auto [it, is_new] = mesh_indices_.emplace(mesh.get(), static_cast<uint32_t>(meshes_.size()));
+    if (is_new) {
+        meshes_.push_back(mesh);
+    }
+    NDrawInstance instance{};
+    instance.rect_[0] = transform.a_;
+    instance.rect_[1] = transform.b_;
+    instance.rect_[2] = transform.c_;
+    instance.rect_[3] = transform.d_;
+    instance.uv_[0] = transform.tx_;
+    instance.uv_[1] = transform.ty_;
+    SetColor(instance, color);
+    instance.primitive_ = NDrawPrimitive::ePath;
+    // Instances of one mesh share a draw; stencil meshes are still covered one instance at a time.
+    Add(mesh->is_stencil_ ? NDrawPipeline::eStencilPath : NDrawPipeline::ePath, it->second, transform.Apply(mesh->bounds_), &instance, 1);
+}
+
+void NDrawList::Finish() {
+    if (is_finished_) {
+        return;
+    }
+    // Counting sort by batch keeps recording order inside each batch.
+    batches_.resize(open_batches_.size());
+    uint32_t first_instance = 0;
+    for (size_t i = 0; i < open_batches_.size(); ++i) {
+        batches_[i].pipeline_ = open_batches_[i].pipeline_;
+        batches_[i].texture_ = open_batches_[i].texture_;
+        batches_[i].bounds_ = open_batches_[i].bounds_;
+        batches_[i].first_instance_ = first_instance;
+        batches_[i].instance_count_ = 0;
+        first_instance += open_batches_[i].count_;
+    }
+    instances_.resize(recorded_.size());
+    for (size_t i = 0; i < recorded_.size(); ++i) {
+        auto& batch = batches_[recorded_batches_[i]];
+        instances_[batch.first_instance_ + batch.instance_count_++] = recorded_[i];
+    }
+    is_finished_ = true;
+}
+
+bool NDrawList::Empty() const {
+    return recorded_.empty();
+}
+
+size_t NDrawList::PrimitiveCount() const {
+    return recorded_.size();
+}
+
+const std::vector<NDrawInstance>& NDrawList::Instances() const {
+    return instances_;
+}
+
+const std::vector<NDrawBatch>& NDrawList::Batches() const {
+    return batches_;
+}
+
+const std::vector<std::shared_ptr<const NPathMesh>>& NDrawList::Meshes() const {
+    return meshes_;
+}
+
+void NDrawList::Add(NDrawPipeline pipeline, NTextureID texture, const NRect& bounds, const NDrawInstance* instances, size_t count) {
+    is_finished_ = false;
+    recorded_.insert(recorded_.end(), instances, instances + count);
+    // Every earlier primitive this one overlaps has to be drawn first, so it can only join the latest
+    // batch with its key if nothing it overlaps went into a later batch.
+    auto key = (static_cast<uint64_t>(pipeline) << 32) | texture;
+    auto it = last_batches_.find(key);
+    auto can_join = it != last_batches_.end();
+    if (can_join && it->second + 1 < open_batches_.size()) {
+        auto candidate = it->second;
+        auto check_tile = [&bounds, &can_join, candidate](const std::vector<Occupant>& occupants) {
+            for (const auto& occupant : occupants) {
+                if (occupant.batch_ > candidate && occupant.bounds_.Intersects(bounds)) {
+                    can_join = false;
+                    return;
+                }
+            }
+        };
+        check_tile(large_occupants_);
+        if (can_join && !VisitTiles(bounds, check_tile)) {
+            for (const auto& occupants : tiles_) {
+                check_tile(occupants);
+            }
+        }
+    }
+    uint32_t batch_index = 0;
+    if (can_join) {
+        batch_index = it->second;
+        open_batches_[batch_index].count_ += static_cast<uint32_t>(count);
+        open_batches_[batch_index].bounds_ = open_batches_[batch_index].bounds_.United(bounds);
+    } else {
+        batch_index = static_cast<uint32_t>(open_batches_.size());
+        open_batches_.push_back({pipeline, texture, static_cast<uint32_t>(count), bounds});
+        last_batches_[key] = batch_index;
+    }
+    recorded_batches_.insert(recorded_batches_.end(), count, batch_index);
+
+    Occupant occupant{bounds, batch_index};
+    auto is_tiled = VisitTiles(bounds, [&occupant](std::vector<Occupant>& occupants) {
+        occupants.push_back(occupant);
+    });
+    if (!is_tiled) {
+        large_occupants_.push_back(occupant);
+    }
+}
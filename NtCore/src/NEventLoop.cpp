@@ -6,49 +6,560 @@
 
 #include "NEventLoop.h"
 
+#include <algorithm>
+
 #include "NCanvas.h"
 
+#if !defined(_WIN32)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+static std::unordered_map<NCanvasID, NCanvas*>& Canvases() {
+    static std::unordered_map<NCanvasID, NCanvas*> canvases;
+    return canvases;
+}
+#endif
+
+static NCanvas* FindCanvas(NCanvasID id) {
+#if defined(_WIN32)
+    return reinterpret_cast<NCanvas*>(GetWindowLongPtr(id, GWLP_USERDATA));
+#else
+    auto it = Canvases().find(id);
+    return it == Canvases().end() ? nullptr : it->second;
+#endif
+}
+
+static bool RouteMouseEvent(NCanvasID id, const NMouseEvent& event) {
+    auto* canvas = FindCanvas(id);
+    if (!canvas) {
+        return false;
+    }
+    canvas->MouseEvent(event);
+    return canvas->HasDamage();
+}
+
+#if defined(_WIN32)
+#if !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+static thread_local NEventLoop* current_event_loop{};
+#endif
+
 NEventLoop::NEventLoop() {
 #if defined(_WIN32)
+    thread_id_ = GetCurrentThreadId();
     auto instance = GetModuleHandle(nullptr);
     WNDCLASS window_class{};
     window_class.lpfnWndProc = EventProcess;
     window_class.hInstance = instance;
     window_class.lpszClassName = N_CLASS_NAME;
     RegisterClass(&window_class);
+    frame_timer_ = CreateWaitableTimerEx(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!frame_timer_) {
+        frame_timer_ = CreateWaitableTimer(nullptr, FALSE, nullptr);
+    }
+#else
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_fd_ < 0 || wakeup_fd_ < 0) {
+        throw std::runtime_error("Failed to create event loop: " + std::string(std::strerror(errno)) + ".");
+    }
+    AddWatch(wakeup_fd_, EPOLLIN, [this](uint32_t) {
+        eventfd_t value{};
+        eventfd_read(wakeup_fd_, &value);
+    });
+    AddWatch(xcb_get_file_descriptor(Connection()), EPOLLIN, [](uint32_t) {});
+    frame_timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (frame_timer_fd_ < 0) {
+        throw std::runtime_error("Failed to create frame timer: " + std::string(std::strerror(errno)) + ".");
+    }
+    AddWatch(frame_timer_fd_, EPOLLIN, [this](uint32_t) {
+        uint64_t expirations{};
+        [[maybe_unused]] auto size = read(frame_timer_fd_, &expirations, sizeof(expirations));
+    });
+#endif
+}
+
+NEventLoop::~NEventLoop() {
+#if defined(_WIN32)
+    if (frame_timer_) {
+        CloseHandle(frame_timer_);
+    }
+#else
+    for (auto timer_fd : timers_) {
+        close(timer_fd);
+    }
+    close(frame_timer_fd_);
+    close(wakeup_fd_);
+    close(epoll_fd_);
 #endif
 }
 
 int NEventLoop::Exec() {
+    next_frame_time_ = std::chrono::steady_clock::now();
 #if defined(_WIN32)
+    current_event_loop = this;
     MSG msg = {};
-    while (GetMessage(&msg, nullptr, 0, 0) > 0) {
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
+    while (true) {
+        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) {
+                FlushGeometries();
+                current_event_loop = nullptr;
+                return static_cast<int>(msg.wParam);
+            }
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+        DrainTasks();
+        if (FlushGeometries()) {
+            Invalidate();
+        }
+        if (IsFrameDue()) {
+            RunFrame();
+        }
+        WaitForEvents();
+    }
+#else
+    is_running_ = true;
+    exit_code_ = 0;
+    epoll_event events[MAX_EVENTS];
+    DispatchConnection();
+    while (is_running_) {
+        if (IsFrameDue()) {
+            RunFrame();
+        }
+        xcb_flush(Connection());
+        // Replies read during the frame can leave events in xcb's queue, which the socket no longer signals.
+        DispatchConnection();
+        if (!is_running_) {
+            break;
+        }
+        auto count = epoll_wait(epoll_fd_, events, MAX_EVENTS, WaitTimeout());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to wait for events: " + std::string(std::strerror(errno)) + ".");
+        }
+        for (int i = 0; i < count && is_running_; ++i) {
+            auto it = watches_.find(events[i].data.fd);
+            if (it != watches_.end()) {
+                auto callback = it->second;
+                callback(events[i].events);
+            }
+        }
+        DrainTasks();
+        DispatchConnection();
+        if (xcb_connection_has_error(Connection())) {
+            Quit(1);
+        }
     }
+    return exit_code_;
+#endif
+}
+
+void NEventLoop::Quit(int exit_code) {
+#if defined(_WIN32)
+    PostThreadMessage(thread_id_, WM_QUIT, static_cast<WPARAM>(exit_code), 0);
+#else
+    exit_code_ = exit_code;
+    is_running_ = false;
+    Wakeup();
 #endif
-    return 0;
 }
 
+void NEventLoop::Wakeup() {
+#if defined(_WIN32)
+    PostThreadMessage(thread_id_, WM_NULL, 0, 0);
+#else
+    eventfd_write(wakeup_fd_, 1);
+#endif
+}
+
+NRunMode NEventLoop::RunMode() const {
+    return run_mode_;
+}
+
+void NEventLoop::SetRunMode(NRunMode run_mode) {
+    run_mode_ = run_mode;
+    next_frame_time_ = std::chrono::steady_clock::now();
+    Invalidate();
+}
+
+uint32_t NEventLoop::TargetFrameRate() const {
+    return target_frame_rate_;
+}
+
+void NEventLoop::SetTargetFrameRate(uint32_t frame_rate) {
+    target_frame_rate_ = (std::max)(frame_rate, 1U);
+    next_frame_time_ = std::chrono::steady_clock::now();
+}
+
+void NEventLoop::SetFrameCallback(std::function<void()> callback) {
+    frame_callback_ = std::move(callback);
+    Invalidate();
+}
+
+void NEventLoop::Invalidate() {
+    if (!is_invalidated_.exchange(true)) {
+        Wakeup();
+    }
+}
+
+void NEventLoop::SetTaskBudget(std::chrono::microseconds budget) {
+    task_budget_ = budget;
+}
+
+void NEventLoop::DrainTasks() {
+    tasks_.Drain(task_budget_);
+}
+
+bool NEventLoop::IsFrameDue() {
+    switch (run_mode_) {
+        case NRunMode::eContinuous: {
+            is_invalidated_ = false;
+            return true;
+        }
+        case NRunMode::eOnDemand: {
+            return is_invalidated_.exchange(false);
+        }
+        case NRunMode::ePaced: {
+            auto now = std::chrono::steady_clock::now();
+            if (now < next_frame_time_) {
+                return false;
+            }
+            auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / target_frame_rate_));
+            next_frame_time_ += period;
+            if (next_frame_time_ <= now) {
+                // Fell behind by more than a frame, so drop the missed ticks instead of bursting.
+                next_frame_time_ = now + period;
+            }
+            is_invalidated_ = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void NEventLoop::RunFrame() {
+    if (frame_callback_) {
+        frame_callback_();
+    }
+}
+
+bool NEventLoop::FlushGeometries() {
+    auto geometries = std::move(pending_geometries_);
+    pending_geometries_.clear();
+    auto is_changed = false;
+    for (const auto& [id, geometry] : geometries) {
+        auto* canvas = FindCanvas(id);
+        if (!canvas) {
+            continue;
+        }
+        canvas->GeometryEvent(geometry.position_.value_or(canvas->Position()), geometry.size_.value_or(canvas->Size()));
+        is_changed = true;
+    }
+    return is_changed;
+}
+
+#if defined(_WIN32)
 LRESULT NEventLoop::EventProcess(HWND hwnd, UINT msg, WPARAM w_param, LPARAM l_param) {
-    auto* canvas = reinterpret_cast<NCanvas*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
     switch (msg) {
+        case WM_PAINT: {
+            RECT update_rect{};
+            auto* canvas = FindCanvas(hwnd);
+            if (canvas && GetUpdateRect(hwnd, &update_rect, FALSE)) {
+                canvas->Invalidate({static_cast<float>(update_rect.left), static_cast<float>(update_rect.top), static_cast<float>(update_rect.right - update_rect.left), static_cast<float>(update_rect.bottom - update_rect.top)});
+            }
+            if (current_event_loop) {
+                current_event_loop->Invalidate();
+            }
+            break;
+        }
+        case WM_MOUSEMOVE:
+        case WM_LBUTTONDOWN:
+        case WM_LBUTTONUP:
+        case WM_MBUTTONDOWN:
+        case WM_MBUTTONUP:
+        case WM_RBUTTONDOWN:
+        case WM_RBUTTONUP: {
+            NMouseEvent event{};
+            event.position_ = {static_cast<float>(static_cast<int16_t>(LOWORD(l_param))), static_cast<float>(static_cast<int16_t>(HIWORD(l_param)))};
+            if (msg == WM_LBUTTONDOWN || msg == WM_MBUTTONDOWN || msg == WM_RBUTTONDOWN) {
+                event.type_ = NMouseEventType::ePress;
+            } else if (msg == WM_LBUTTONUP || msg == WM_MBUTTONUP || msg == WM_RBUTTONUP) {
+                event.type_ = NMouseEventType::eRelease;
+            }
+            if (msg == WM_LBUTTONDOWN || msg == WM_LBUTTONUP) {
+                event.button_ = NMouseButton::eLeft;
+            } else if (msg == WM_MBUTTONDOWN || msg == WM_MBUTTONUP) {
+                event.button_ = NMouseButton::eMiddle;
+            } else if (msg == WM_RBUTTONDOWN || msg == WM_RBUTTONUP) {
+                event.button_ = NMouseButton::eRight;
+            }
+            if (RouteMouseEvent(hwnd, event) && current_event_loop) {
+                current_event_loop->Invalidate();
+            }
+            return 0;
+        }
         case WM_DESTROY: {
+            if (current_event_loop) {
+                current_event_loop->pending_geometries_.erase(hwnd);
+            }
             PostQuitMessage(0);
             return 0;
         }
         case WM_MOVE: {
-            auto x = static_cast<int32_t>(LOWORD(l_param));
-            auto y = static_cast<int32_t>(HIWORD(l_param));
-            canvas->MoveEvent({x, y});
+            auto x = static_cast<int32_t>(static_cast<int16_t>(LOWORD(l_param)));
+            auto y = static_cast<int32_t>(static_cast<int16_t>(HIWORD(l_param)));
+            if (current_event_loop) {
+                current_event_loop->pending_geometries_[hwnd].position_ = NPosition{x, y};
+            } else if (auto* canvas = FindCanvas(hwnd)) {
+                // Move before Exec sends this synchronously and nothing would flush it, so apply it now.
+                canvas->GeometryEvent(NPosition{x, y}, canvas->Size());
+            }
             return 0;
         }
         case WM_SIZE: {
             auto width = static_cast<uint32_t>(LOWORD(l_param));
             auto height = static_cast<uint32_t>(HIWORD(l_param));
-            canvas->ResizeEvent({width, height});
+            if (current_event_loop) {
+                current_event_loop->pending_geometries_[hwnd].size_ = NSize{width, height};
+            } else if (auto* canvas = FindCanvas(hwnd)) {
+                canvas->GeometryEvent(canvas->Position(), NSize{width, height});
+            }
+            return 0;
+        }
+        case WM_ENTERSIZEMOVE: {
+            // The modal drag loop starves Exec, so flush from a timer until it ends.
+            SetTimer(hwnd, SIZE_MOVE_TIMER_ID, USER_TIMER_MINIMUM, nullptr);
             return 0;
         }
+        case WM_EXITSIZEMOVE: {
+            KillTimer(hwnd, SIZE_MOVE_TIMER_ID);
+            if (current_event_loop) {
+                current_event_loop->FlushGeometries();
+            }
+            return 0;
+        }
+        case WM_TIMER: {
+            if (w_param == SIZE_MOVE_TIMER_ID) {
+                // Thread messages are dropped by the modal loop, so posted tasks are drained here too.
+                if (current_event_loop) {
+                    current_event_loop->DrainTasks();
+                    current_event_loop->FlushGeometries();
+                }
+                return 0;
+            }
+            break;
+        }
     }
     return DefWindowProc(hwnd, msg, w_param, l_param);
 }
+
+void NEventLoop::WaitForEvents() {
+    switch (run_mode_) {
+        case NRunMode::eContinuous: {
+            return;
+        }
+        case NRunMode::eOnDemand: {
+            if (!is_invalidated_ && tasks_.Empty()) {
+                MsgWaitForMultipleObjectsEx(0, nullptr, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            }
+            return;
+        }
+        case NRunMode::ePaced: {
+            auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(next_frame_time_ - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0 || !tasks_.Empty()) {
+                return;
+            }
+            LARGE_INTEGER due_time{};
+            due_time.QuadPart = -static_cast<LONGLONG>(remaining.count() / 100);
+            if (frame_timer_ && SetWaitableTimer(frame_timer_, &due_time, 0, nullptr, nullptr, FALSE)) {
+                MsgWaitForMultipleObjectsEx(1, &frame_timer_, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            } else {
+                MsgWaitForMultipleObjectsEx(0, nullptr, static_cast<DWORD>(remaining.count() / 1000000), QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            }
+            return;
+        }
+    }
+}
+#else
+void NEventLoop::AddWatch(int fd, uint32_t events, WatchCallback callback) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    auto operation = watches_.contains(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(epoll_fd_, operation, fd, &event) < 0) {
+        throw std::runtime_error("Failed to watch file descriptor: " + std::string(std::strerror(errno)) + ".");
+    }
+    watches_[fd] = std::move(callback);
+}
+
+void NEventLoop::RemoveWatch(int fd) {
+    if (watches_.erase(fd) > 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+int NEventLoop::AddTimer(uint32_t interval_ms, std::function<void()> callback) {
+    auto timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (timer_fd < 0) {
+        throw std::runtime_error("Failed to create timer: " + std::string(std::strerror(errno)) + ".");
+    }
+    itimerspec spec{};
+    spec.it_interval.tv_sec = interval_ms / 1000;
+    spec.it_interval.tv_nsec = static_cast<long>(interval_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    timerfd_settime(timer_fd, 0, &spec, nullptr);
+    timers_.insert(timer_fd);
+    AddWatch(timer_fd, EPOLLIN, [timer_fd, callback = std::move(callback)](uint32_t) {
+        uint64_t expirations{};
+        if (read(timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            callback();
+        }
+    });
+    return timer_fd;
+}
+
+void NEventLoop::RemoveTimer(int timer_fd) {
+    RemoveWatch(timer_fd);
+    if (timers_.erase(timer_fd) > 0) {
+        close(timer_fd);
+    }
+}
+
+xcb_connection_t* NEventLoop::Connection() {
+    static xcb_connection_t* connection = [] {
+        auto* connection = xcb_connect(nullptr, nullptr);
+        if (xcb_connection_has_error(connection)) {
+            throw std::runtime_error("Failed to connect to the X server.");
+        }
+        return connection;
+    }();
+    return connection;
+}
+
+xcb_screen_t* NEventLoop::Screen() {
+    static xcb_screen_t* screen = xcb_setup_roots_iterator(xcb_get_setup(Connection())).data;
+    return screen;
+}
+
+xcb_atom_t NEventLoop::Atom(const char* name) {
+    static std::unordered_map<std::string, xcb_atom_t> atoms;
+    auto it = atoms.find(name);
+    if (it != atoms.end()) {
+        return it->second;
+    }
+    auto cookie = xcb_intern_atom(Connection(), 0, static_cast<uint16_t>(std::strlen(name)), name);
+    auto* reply = xcb_intern_atom_reply(Connection(), cookie, nullptr);
+    xcb_atom_t atom = reply ? reply->atom : static_cast<xcb_atom_t>(XCB_ATOM_NONE);
+    std::free(reply);
+    atoms.emplace(name, atom);
+    return atom;
+}
+
+void NEventLoop::RegisterCanvas(NCanvasID id, NCanvas* canvas) {
+    Canvases()[id] = canvas;
+}
+
+void NEventLoop::UnregisterCanvas(NCanvasID id) {
+    Canvases().erase(id);
+}
+
+void NEventLoop::DispatchConnection() {
+    auto& geometries = pending_geometries_;
+    auto* connection = Connection();
+    while (auto* event = xcb_poll_for_event(connection)) {
+        switch (event->response_type & ~0x80) {
+            case XCB_CONFIGURE_NOTIFY: {
+                auto* configure = reinterpret_cast<xcb_configure_notify_event_t*>(event);
+                geometries[configure->window] = {NPosition{configure->x, configure->y}, NSize{configure->width, configure->height}};
+                break;
+            }
+            case XCB_EXPOSE: {
+                auto* expose = reinterpret_cast<xcb_expose_event_t*>(event);
+                if (auto* canvas = FindCanvas(expose->window)) {
+                    canvas->Invalidate({static_cast<float>(expose->x), static_cast<float>(expose->y), static_cast<float>(expose->width), static_cast<float>(expose->height)});
+                }
+                Invalidate();
+                break;
+            }
+            case XCB_BUTTON_PRESS:
+            case XCB_BUTTON_RELEASE: {
+                // Buttons 4 to 7 are wheel steps, which items don't receive.
+                auto* button = reinterpret_cast<xcb_button_press_event_t*>(event);
+                if (button->detail < 1 || button->detail > 3) {
+                    break;
+                }
+                NMouseEvent mouse_event{};
+                mouse_event.type_ = (event->response_type & ~0x80) == XCB_BUTTON_PRESS ? NMouseEventType::ePress : NMouseEventType::eRelease;
+                mouse_event.position_ = {static_cast<float>(button->event_x), static_cast<float>(button->event_y)};
+                mouse_event.button_ = button->detail == 1 ? NMouseButton::eLeft : (button->detail == 2 ? NMouseButton::eMiddle : NMouseButton::eRight);
+                if (RouteMouseEvent(button->event, mouse_event)) {
+                    Invalidate();
+                }
+                break;
+            }
+            case XCB_MOTION_NOTIFY: {
+                auto* motion = reinterpret_cast<xcb_motion_notify_event_t*>(event);
+                NMouseEvent mouse_event{};
+                mouse_event.position_ = {static_cast<float>(motion->event_x), static_cast<float>(motion->event_y)};
+                if (RouteMouseEvent(motion->event, mouse_event)) {
+                    Invalidate();
+                }
+                break;
+            }
+            case XCB_CLIENT_MESSAGE: {
+                auto* message = reinterpret_cast<xcb_client_message_event_t*>(event);
+                if (message->data.data32[0] == Atom("WM_DELETE_WINDOW")) {
+                    geometries.erase(message->window);
+                    xcb_unmap_window(connection, message->window);
+                    Quit(0);
+                }
+                break;
+            }
+        }
+        std::free(event);
+    }
+    if (FlushGeometries()) {
+        Invalidate();
+    }
+}
+
+int NEventLoop::WaitTimeout() {
+    if (!tasks_.Empty()) {
+        // Either the last drain ran out of budget or a producer is mid-push; poll instead of sleeping.
+        return 0;
+    }
+    switch (run_mode_) {
+        case NRunMode::eContinuous: {
+            return 0;
+        }
+        case NRunMode::eOnDemand: {
+            return is_invalidated_ ? 0 : -1;
+        }
+        case NRunMode::ePaced: {
+            auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(next_frame_time_ - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                return 0;
+            }
+            itimerspec spec{};
+            spec.it_value.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+            spec.it_value.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+            timerfd_settime(frame_timer_fd_, 0, &spec, nullptr);
+            return -1;
+        }
+    }
+    return -1;
+}
+#endif
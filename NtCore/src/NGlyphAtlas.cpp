@@ -0,0 +1,242 @@
+/**
+ * @file NGlyphAtlas.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NGlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Shelves only take glyphs at most this much shorter than themselves, bounding the wasted height.
+static constexpr float SHELF_SLACK{1.25F};
+
+/**
+ * Distance from each pixel centre to the nearest pixel of the other side, searched within the spread.
+ * Pixels on the edge use their coverage for a sub-pixel estimate. 128 is the outline; one unit of
+ * spread maps to 127 / SDF_SPREAD.
+ */
+static void GenerateSdf(const NGlyphBitmap& bitmap, uint32_t spread, std::vector<uint8_t>& sdf) {
+    auto width = bitmap.width_ + spread * 2;
+    auto height = bitmap.height_ + spread * 2;
+    sdf.assign(static_cast<size_t>(width) * height, 0);
+    auto coverage = [&bitmap, spread](int64_t x, int64_t y) -> uint8_t {
+        x -= spread;
+        y -= spread;
+        if (x < 0 || y < 0 || x >= static_cast<int64_t>(bitmap.width_) || y >= static_cast<int64_t>(bitmap.height_)) {
+            return 0;
+        }
+        return bitmap.coverage_[y * bitmap.width_ + x];
+    };
+    auto radius = static_cast<int64_t>(spread);
+    for (int64_t y = 0; y < height; ++y) {
+        for (int64_t x = 0; x < width; ++x) {
+            auto value = coverage(x, y);
+            auto is_inside = value >= 128;
+            auto nearest_squared = static_cast<float>((radius + 1) * (radius + 1));
+            for (auto dy = -radius; dy <= radius; ++dy) {
+                for (auto dx = -radius; dx <= radius; ++dx) {
+                    auto distance_squared = static_cast<float>(dx * dx + dy * dy);
+                    if (distance_squared < nearest_squared && (coverage(x + dx, y + dy) >= 128) != is_inside) {
+                        nearest_squared = distance_squared;
+                    }
+                }
+            }
+            auto nearest = std::sqrt(nearest_squared);
+            auto distance = nearest <= 1.0F ? static_cast<float>(value) / 255.0F - 0.5F : (is_inside ? nearest - 0.5F : 0.5F - nearest);
+            distance = std::clamp(distance, -static_cast<float>(spread), static_cast<float>(spread));
+            sdf[y * width + x] = static_cast<uint8_t>(std::clamp(128.0F + distance * 127.0F / static_cast<float>(spread), 0.0F, 255.0F));
+        }
+    }
+}
+
+NGlyphAtlas::NGlyphAtlas(NGlyphRasterizer& rasterizer, uint32_t page_size, uint32_t max_pages)
+    : rasterizer_(rasterizer), page_size_(page_size), max_pages_(max_pages) {
+    if (page_size_ == 0 || max_pages_ == 0) {
+        throw std::runtime_error("Glyph atlas needs at least one non-empty page.");
+    }
+}
+
+void NGlyphAtlas::SetTextureProvider(TextureProvider provider) {
+    texture_provider_ = std::move(provider);
+    for (uint32_t i = 0; i < pages_.size(); ++i) {
+        pages_[i].texture_ = texture_provider_ ? texture_provider_(i) : 0;
+        MarkDirty(pages_[i]);
+    }
+    ++generation_;
+}
+
+void NGlyphAtlas::BeginFrame() {
+    ++frame_;
+}
+
+const NAtlasGlyph* NGlyphAtlas::Find(const NFont& font, uint32_t glyph) {
+    auto key = (static_cast<uint64_t>(FaceID(font)) << 32) | glyph;
+    auto it = glyphs_.find(key);
+    if (it != glyphs_.end()) {
+        if (!it->second.is_empty_) {
+            pages_[it->second.page_].last_used_ = frame_;
+        }
+        return &it->second;
+    }
+    auto reference = font;
+    reference.size_ = REFERENCE_SIZE;
+    if (!rasterizer_.Rasterize(reference, glyph, bitmap_)) {
+        return nullptr;
+    }
+    NAtlasGlyph entry{};
+    entry.advance_ = bitmap_.advance_;
+    if (bitmap_.width_ == 0 || bitmap_.height_ == 0) {
+        entry.is_empty_ = true;
+        return &glyphs_.emplace(key, entry).first->second;
+    }
+    auto width = bitmap_.width_ + SDF_SPREAD * 2;
+    auto height = bitmap_.height_ + SDF_SPREAD * 2;
+    if (!Place(width, height, entry.page_, entry.region_)) {
+        return nullptr;
+    }
+    entry.bearing_x_ = bitmap_.bearing_x_ - static_cast<float>(SDF_SPREAD);
+    entry.bearing_y_ = bitmap_.bearing_y_ - static_cast<float>(SDF_SPREAD);
+
+    GenerateSdf(bitmap_, SDF_SPREAD, sdf_);
+    auto& page = pages_[entry.page_];
+    for (uint32_t y = 0; y < height; ++y) {
+        std::copy_n(sdf_.data() + static_cast<size_t>(y) * width, width, page.pixels_.data() + static_cast<size_t>(entry.region_.y_ + y) * page_size_ + entry.region_.x_);
+    }
+    if (page.is_dirty_) {
+        auto right = (std::max)(page.dirty_.x_ + page.dirty_.width_, entry.region_.x_ + width);
+        auto bottom = (std::max)(page.dirty_.y_ + page.dirty_.height_, entry.region_.y_ + height);
+        page.dirty_.x_ = (std::min)(page.dirty_.x_, entry.region_.x_);
+        page.dirty_.y_ = (std::min)(page.dirty_.y_, entry.region_.y_);
+        page.dirty_.width_ = right - page.dirty_.x_;
+        page.dirty_.height_ = bottom - page.dirty_.y_;
+    } else {
+        page.dirty_ = entry.region_;
+        page.is_dirty_ = true;
+    }
+    page.last_used_ = frame_;
+    page.glyphs_.push_back(key);
+    entry.texture_ = page.texture_;
+    return &glyphs_.emplace(key, entry).first->second;
+}
+
+void NGlyphAtlas::Touch(uint32_t page) {
+    pages_[page].last_used_ = frame_;
+}
+
+uint64_t NGlyphAtlas::Generation() const {
+    return generation_;
+}
+
+uint32_t NGlyphAtlas::PageSize() const {
+    return page_size_;
+}
+
+uint32_t NGlyphAtlas::PageCount() const {
+    return static_cast<uint32_t>(pages_.size());
+}
+
+NTextureID NGlyphAtlas::PageTexture(uint32_t page) const {
+    return pages_[page].texture_;
+}
+
+const std::vector<uint8_t>& NGlyphAtlas::PagePixels(uint32_t page) const {
+    return pages_[page].pixels_;
+}
+
+bool NGlyphAtlas::TakeDirtyRegion(uint32_t page, NAtlasRegion& region) {
+    if (!pages_[page].is_dirty_) {
+        return false;
+    }
+    region = pages_[page].dirty_;
+    pages_[page].is_dirty_ = false;
+    return true;
+}
+
+size_t NGlyphAtlas::GlyphCount() const {
+    return glyphs_.size();
+}
+
+uint32_t NGlyphAtlas::FaceID(const NFont& font) {
+    for (uint32_t i = 0; i < faces_.size(); ++i) {
+        if (faces_[i].family_ == font.family_ && faces_[i].weight_ == font.weight_ && faces_[i].italic_ == font.italic_) {
+            return i;
+        }
+    }
+    faces_.push_back(font);
+    return static_cast<uint32_t>(faces_.size() - 1);
+}
+
+bool NGlyphAtlas::Allocate(Page& page, uint32_t width, uint32_t height, NAtlasRegion& region) {
+    // Cells include the gutter on the right and below; the region handed out is the glyph alone.
+    auto cell_width = width + GUTTER;
+    auto cell_height = height + GUTTER;
+    for (auto& shelf : page.shelves_) {
+        if (shelf.height_ >= cell_height && static_cast<float>(shelf.height_) <= static_cast<float>(cell_height) * SHELF_SLACK && shelf.x_ + cell_width <= page_size_) {
+            region = {shelf.x_, shelf.y_, width, height};
+            shelf.x_ += cell_width;
+            return true;
+        }
+    }
+    if (page.next_shelf_y_ + cell_height > page_size_ || cell_width > page_size_) {
+        return false;
+    }
+    page.shelves_.push_back({page.next_shelf_y_, cell_height, cell_width});
+    region = {0, page.next_shelf_y_, width, height};
+    page.next_shelf_y_ += cell_height;
+    return true;
+}
+
+bool NGlyphAtlas::Place(uint32_t width, uint32_t height, uint32_t& page_index, NAtlasRegion& region) {
+    if (width + GUTTER > page_size_ || height + GUTTER > page_size_) {
+        // Not even an empty page holds it, so evicting one would only throw away cached glyphs.
+        return false;
+    }
+    for (uint32_t i = 0; i < pages_.size(); ++i) {
+        if (Allocate(pages_[i], width, height, region)) {
+            page_index = i;
+            return true;
+        }
+    }
+    if (pages_.size() < max_pages_) {
+        page_index = static_cast<uint32_t>(pages_.size());
+        auto& page = pages_.emplace_back();
+        page.pixels_.assign(static_cast<size_t>(page_size_) * page_size_, 0);
+        page.texture_ = texture_provider_ ? texture_provider_(page_index) : 0;
+        MarkDirty(page);
+        return Allocate(page, width, height, region);
+    }
+    auto victim = pages_.size();
+    for (size_t i = 0; i < pages_.size(); ++i) {
+        if (pages_[i].last_used_ < frame_ && (victim == pages_.size() || pages_[i].last_used_ < pages_[victim].last_used_)) {
+            victim = i;
+        }
+    }
+    if (victim == pages_.size()) {
+        // Everything on every page is on screen this frame.
+        return false;
+    }
+    page_index = static_cast<uint32_t>(victim);
+    Evict(page_index);
+    return Allocate(pages_[page_index], width, height, region);
+}
+
+void NGlyphAtlas::Evict(uint32_t page_index) {
+    auto& page = pages_[page_index];
+    for (auto key : page.glyphs_) {
+        glyphs_.erase(key);
+    }
+    page.glyphs_.clear();
+    page.shelves_.clear();
+    page.next_shelf_y_ = 0;
+    std::fill(page.pixels_.begin(), page.pixels_.end(), uint8_t{0});
+    MarkDirty(page);
+    ++generation_;
+}
+
+void NGlyphAtlas::MarkDirty(Page& page) {
+    page.dirty_ = {0, 0, page_size_, page_size_};
+    page.is_dirty_ = true;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file NGlyphRasterizer.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NGlyphRasterizer.h"
+
+#if defined(_WIN32)
+
+#include <stdexcept>
+
+NGdiGlyphRasterizer::NGdiGlyphRasterizer() {
+    dc_ = CreateCompatibleDC(nullptr);
+    if (!dc_) {
+        throw std::runtime_error("Failed to create a GDI device context.");
+    }
+}
+
+NGdiGlyphRasterizer::~NGdiGlyphRasterizer() {
+    for (auto& [key, entry] : fonts_) {
+        DeleteObject(entry.font_);
+    }
+    DeleteDC(dc_);
+}
+
+NFontMetrics NGdiGlyphRasterizer::FontMetrics(const NFont& font) {
+    Select(font);
+    TEXTMETRICW text_metrics{};
+    GetTextMetricsW(dc_, &text_metrics);
+    return {static_cast<float>(text_metrics.tmAscent), static_cast<float>(text_metrics.tmDescent), static_cast<float>(text_metrics.tmExternalLeading)};
+}
+
+uint32_t NGdiGlyphRasterizer::GlyphIndex(const NFont& font, char32_t codepoint) {
+    if (codepoint > 0xFFFF) {
+        return 0;
+    }
+    Select(font);
+    auto character = static_cast<wchar_t>(codepoint);
+    WORD glyph = 0;
+    if (GetGlyphIndicesW(dc_, &character, 1, &glyph, GGI_MARK_NONEXISTING_GLYPHS) == GDI_ERROR || glyph == 0xFFFF) {
+        return 0;
+    }
+    return glyph;
+}
+
+float NGdiGlyphRasterizer::Advance(const NFont& font, uint32_t glyph) {
+    Select(font);
+    GLYPHMETRICS glyph_metrics{};
+    MAT2 matrix{{0, 1}, {0, 0}, {0, 0}, {0, 1}};
+    if (GetGlyphOutlineW(dc_, glyph, GGO_METRICS | GGO_GLYPH_INDEX, &glyph_metrics, 0, nullptr, &matrix) == GDI_ERROR) {
+        return 0.0F;
+    }
+    return static_cast<float>(glyph_metrics.gmCellIncX);
+}
+
+float NGdiGlyphRasterizer::Kerning(const NFont& font, char32_t left, char32_t right) {
+    auto& entry = Select(font);
+    auto it = entry.kerning_.find((static_cast<uint32_t>(left) << 16) | static_cast<uint32_t>(right & 0xFFFF));
+    return it == entry.kerning_.end() || left > 0xFFFF || right > 0xFFFF ? 0.0F : it->second;
+}
+
+bool NGdiGlyphRasterizer::Rasterize(const NFont& font, uint32_t glyph, NGlyphBitmap& bitmap) {
+    Select(font);
+    GLYPHMETRICS glyph_metrics{};
+    MAT2 matrix{{0, 1}, {0, 0}, {0, 0}, {0, 1}};
+    auto size = GetGlyphOutlineW(dc_, glyph, GGO_GRAY8_BITMAP | GGO_GLYPH_INDEX, &glyph_metrics, 0, nullptr, &matrix);
+    if (size == GDI_ERROR) {
+        return false;
+    }
+    bitmap.advance_ = static_cast<float>(glyph_metrics.gmCellIncX);
+    bitmap.bearing_x_ = static_cast<float>(glyph_metrics.gmptGlyphOrigin.x);
+    bitmap.bearing_y_ = -static_cast<float>(glyph_metrics.gmptGlyphOrigin.y);
+    if (size == 0) {
+        // Whitespace has metrics but no bitmap.
+        bitmap.width_ = 0;
+        bitmap.height_ = 0;
+        bitmap.coverage_.clear();
+        return true;
+    }
+    std::vector<uint8_t> buffer(size);
+    GetGlyphOutlineW(dc_, glyph, GGO_GRAY8_BITMAP | GGO_GLYPH_INDEX, &glyph_metrics, size, buffer.data(), &matrix);
+    bitmap.width_ = glyph_metrics.gmBlackBoxX;
+    bitmap.height_ = glyph_metrics.gmBlackBoxY;
+    bitmap.coverage_.resize(static_cast<size_t>(bitmap.width_) * bitmap.height_);
+    // GGO_GRAY8_BITMAP rows are DWORD aligned and use 65 levels.
+    auto pitch = (bitmap.width_ + 3) & ~3U;
+    for (uint32_t y = 0; y < bitmap.height_; ++y) {
+        for (uint32_t x = 0; x < bitmap.width_; ++x) {
+            bitmap.coverage_[y * bitmap.width_ + x] = static_cast<uint8_t>(buffer[y * pitch + x] * 255 / 64);
+        }
+    }
+    return true;
+}
+
+NGdiGlyphRasterizer::FontEntry& NGdiGlyphRasterizer::Select(const NFont& font) {
+    auto key = font.family_ + L'|' + std::to_wstring(font.size_) + L'|' + std::to_wstring(font.weight_) + (font.italic_ ? L"|i" : L"");
+    auto it = fonts_.find(key);
+    if (it == fonts_.end()) {
+        FontEntry entry{};
+        entry.font_ = CreateFontW(-static_cast<int>(font.size_ + 0.5F), 0, 0, 0, static_cast<int>(font.weight_), font.italic_, FALSE, FALSE, DEFAULT_CHARSET, OUT_TT_PRECIS, CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY, DEFAULT_PITCH, font.family_.c_str());
+        if (!entry.font_) {
+            throw std::runtime_error("Failed to create a GDI font.");
+        }
+        SelectObject(dc_, entry.font_);
+        auto pair_count = GetKerningPairsW(dc_, 0, nullptr);
+        if (pair_count > 0) {
+            std::vector<KERNINGPAIR> pairs(pair_count);
+            GetKerningPairsW(dc_, pair_count, pairs.data());
+            for (const auto& pair : pairs) {
+                entry.kerning_[(static_cast<uint32_t>(pair.wFirst) << 16) | pair.wSecond] = static_cast<float>(pair.iKernAmount);
+            }
+        }
+        it = fonts_.emplace(std::move(key), std::move(entry)).first;
+    }
+    SelectObject(dc_, it->second.font_);
+    return it->second;
+}
+
+#endif
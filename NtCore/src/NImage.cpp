@@ -0,0 +1,78 @@
+/**
+ * @file NImage.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NImage.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+uint32_t NImage::Width() const {
+    return levels_.empty() ? 0 : levels_.front().width_;
+}
+
+uint32_t NImage::Height() const {
+    return levels_.empty() ? 0 : levels_.front().height_;
+}
+
+bool NImage::Empty() const {
+    return levels_.empty() || Width() == 0 || Height() == 0;
+}
+
+bool NImage::IsCompressed() const {
+    return format_ != NImageFormat::eRGBA8;
+}
+
+bool NImage::HasMipChain() const {
+    return !Empty() && levels_.size() == MipCount(Width(), Height());
+}
+
+void NImage::GenerateMips() {
+    if (IsCompressed()) {
+        throw std::runtime_error("Mips of compressed images must be built offline.");
+    }
+    if (Empty()) {
+        return;
+    }
+    levels_.resize(1);
+    while (levels_.back().width_ > 1 || levels_.back().height_ > 1) {
+        const auto& source = levels_.back();
+        NImageLevel level{};
+        level.width_ = (std::max)(source.width_ / 2, 1U);
+        level.height_ = (std::max)(source.height_ / 2, 1U);
+        level.data_.resize(LevelSize(format_, level.width_, level.height_));
+        for (uint32_t y = 0; y < level.height_; ++y) {
+            auto y0 = (std::min)(y * 2, source.height_ - 1);
+            auto y1 = (std::min)(y * 2 + 1, source.height_ - 1);
+            for (uint32_t x = 0; x < level.width_; ++x) {
+                auto x0 = (std::min)(x * 2, source.width_ - 1);
+                auto x1 = (std::min)(x * 2 + 1, source.width_ - 1);
+                for (uint32_t channel = 0; channel < 4; ++channel) {
+                    uint32_t sum = source.data_[(y0 * source.width_ + x0) * 4 + channel] + source.data_[(y0 * source.width_ + x1) * 4 + channel] +
+                                   source.data_[(y1 * source.width_ + x0) * 4 + channel] + source.data_[(y1 * source.width_ + x1) * 4 + channel];
+                    level.data_[(y * level.width_ + x) * 4 + channel] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+        levels_.push_back(std::move(level));
+    }
+}
+
+uint32_t NImage::MipCount(uint32_t width, uint32_t height) {
+    uint32_t count = 1;
+    for (auto size = (std::max)(width, height); size > 1; size /= 2) {
+        ++count;
+    }
+    return count;
+}
+
+size_t NImage::LevelSize(NImageFormat format, uint32_t width, uint32_t height) {
+    if (format == NImageFormat::eRGBA8) {
+        return static_cast<size_t>(width) * height * 4;
+    }
+    size_t blocks = static_cast<size_t>((std::max)((width + 3) / 4, 1U)) * (std::max)((height + 3) / 4, 1U);
+    return blocks * (format == NImageFormat::eBC1 ? 8 : 16);
+}
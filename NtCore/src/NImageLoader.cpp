@@ -0,0 +1,288 @@
+/**
+ * @file NImageLoader.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NImageLoader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "NProfiler.h"
+
+static uint32_t ReadU16(const std::vector<uint8_t>& bytes, size_t offset) {
+    return static_cast<uint32_t>(bytes[offset]) | (static_cast<uint32_t>(bytes[offset + 1]) << 8);
+}
+
+static uint32_t ReadU24(const std::vector<uint8_t>& bytes, size_t offset) {
+    return ReadU16(bytes, offset) | (static_cast<uint32_t>(bytes[offset + 2]) << 16);
+}
+
+static uint32_t ReadU32(const std::vector<uint8_t>& bytes, size_t offset) {
+    return ReadU16(bytes, offset) | (ReadU16(bytes, offset + 2) << 16);
+}
+
+static constexpr uint32_t FourCC(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+NImageLoader::NImageLoader(size_t thread_count) {
+    if (thread_count == 0) {
+        // Leave a core for the UI thread.
+        thread_count = (std::max)(std::thread::hardware_concurrency(), 2U) - 1;
+    }
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back(&NImageLoader::WorkerMain, this);
+    }
+}
+
+NImageLoader::~NImageLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void NImageLoader::AddDecoder(Decoder decoder) {
+    decoders_.push_back(std::move(decoder));
+}
+
+std::future<NImage> NImageLoader::Load(const std::filesystem::path& path, bool generate_mips) {
+    return Enqueue([this, path, generate_mips] {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Failed to open image: " + path.string() + ".");
+        }
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return DecodeNow(bytes, generate_mips);
+    });
+}
+
+std::future<NImage> NImageLoader::Decode(std::vector<uint8_t> bytes, bool generate_mips) {
+    return Enqueue([this, bytes = std::move(bytes), generate_mips] {
+        return DecodeNow(bytes, generate_mips);
+    });
+}
+
+size_t NImageLoader::ThreadCount() const {
+    return workers_.size();
+}
+
+NImage NImageLoader::DecodeNow(const std::vector<uint8_t>& bytes, bool generate_mips) const {
+    N_PROFILE_ZONE("NImageLoader::Decode");
+    NImage image{};
+    auto is_decoded = std::any_of(decoders_.begin(), decoders_.end(), [&bytes, &image](const Decoder& decoder) {
+        return decoder(bytes, image);
+    });
+    if (!is_decoded && !DecodePpm(bytes, image) && !DecodeDds(bytes, image) && !DecodeAstc(bytes, image) && !DecodeTga(bytes, image)) {
+        throw std::runtime_error("Unsupported image format.");
+    }
+    if (generate_mips && !image.IsCompressed() && !image.HasMipChain()) {
+        image.GenerateMips();
+    }
+    return image;
+}
+
+bool NImageLoader::DecodePpm(const std::vector<uint8_t>& bytes, NImage& image) {
+    if (bytes.size() < 2 || bytes[0] != 'P' || bytes[1] != '6') {
+        return false;
+    }
+    // Header: P6, width, height and maxval separated by whitespace or comments, then one whitespace byte.
+    size_t offset = 2;
+    uint32_t fields[3]{};
+    for (auto& field : fields) {
+        while (offset < bytes.size() && (std::isspace(bytes[offset]) || bytes[offset] == '#')) {
+            if (bytes[offset] == '#') {
+                while (offset < bytes.size() && bytes[offset] != '\n') {
+                    ++offset;
+                }
+            } else {
+                ++offset;
+            }
+        }
+        if (offset >= bytes.size() || !std::isdigit(bytes[offset])) {
+            return false;
+        }
+        while (offset < bytes.size() && std::isdigit(bytes[offset])) {
+            field = field * 10 + (bytes[offset++] - '0');
+        }
+    }
+    ++offset;
+    auto width = fields[0];
+    auto height = fields[1];
+    if (fields[2] != 255 || width == 0 || height == 0 || bytes.size() < offset + static_cast<size_t>(width) * height * 3) {
+        return false;
+    }
+    NImageLevel level{width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4)};
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+        level.data_[i * 4] = bytes[offset + i * 3];
+        level.data_[i * 4 + 1] = bytes[offset + i * 3 + 1];
+        level.data_[i * 4 + 2] = bytes[offset + i * 3 + 2];
+        level.data_[i * 4 + 3] = 255;
+    }
+    image = NImage{};
+    image.levels_.push_back(std::move(level));
+    return true;
+}
+
+bool NImageLoader::DecodeTga(const std::vector<uint8_t>& bytes, NImage& image) {
+    static constexpr size_t HEADER_SIZE{18};
+    // TGA has no magic number, so only uncompressed true-color with no color map is accepted.
+    if (bytes.size() < HEADER_SIZE || bytes[1] != 0 || bytes[2] != 2) {
+        return false;
+    }
+    auto width = ReadU16(bytes, 12);
+    auto height = ReadU16(bytes, 14);
+    auto bytes_per_pixel = static_cast<size_t>(bytes[16]) / 8;
+    auto is_top_down = (bytes[17] & 0x20) != 0;
+    auto offset = HEADER_SIZE + bytes[0];
+    if ((bytes_per_pixel != 3 && bytes_per_pixel != 4) || width == 0 || height == 0 || bytes.size() < offset + width * height * bytes_per_pixel) {
+        return false;
+    }
+    NImageLevel level{width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4)};
+    for (uint32_t y = 0; y < height; ++y) {
+        auto row = is_top_down ? y : height - 1 - y;
+        for (uint32_t x = 0; x < width; ++x) {
+            const auto* source = &bytes[offset + (static_cast<size_t>(y) * width + x) * bytes_per_pixel];
+            auto* target = &level.data_[(static_cast<size_t>(row) * width + x) * 4];
+            target[0] = source[2];
+            target[1] = source[1];
+            target[2] = source[0];
+            target[3] = bytes_per_pixel == 4 ? source[3] : 255;
+        }
+    }
+    image = NImage{};
+    image.levels_.push_back(std::move(level));
+    return true;
+}
+
+bool NImageLoader::DecodeDds(const std::vector<uint8_t>& bytes, NImage& image) {
+    static constexpr size_t HEADER_SIZE{128};
+    static constexpr size_t DX10_HEADER_SIZE{20};
+    if (bytes.size() < HEADER_SIZE || ReadU32(bytes, 0) != FourCC('D', 'D', 'S', ' ')) {
+        return false;
+    }
+    auto height = ReadU32(bytes, 12);
+    auto width = ReadU32(bytes, 16);
+    auto mip_count = (std::max)(ReadU32(bytes, 28), 1U);
+    auto four_cc = ReadU32(bytes, 84);
+    auto offset = HEADER_SIZE;
+    NImage result{};
+    result.is_srgb_ = false;
+    if (four_cc == FourCC('D', 'X', '1', '0')) {
+        if (bytes.size() < HEADER_SIZE + DX10_HEADER_SIZE || ReadU32(bytes, 140) > 1) {
+            return false;
+        }
+        // DXGI_FORMAT values of the block-compressed formats.
+        switch (ReadU32(bytes, 128)) {
+            case 72:
+                result.is_srgb_ = true;
+                [[fallthrough]];
+            case 71:
+                result.format_ = NImageFormat::eBC1;
+                break;
+            case 78:
+                result.is_srgb_ = true;
+                [[fallthrough]];
+            case 77:
+                result.format_ = NImageFormat::eBC3;
+                break;
+            case 83:
+                result.format_ = NImageFormat::eBC5;
+                break;
+            case 99:
+                result.is_srgb_ = true;
+                [[fallthrough]];
+            case 98:
+                result.format_ = NImageFormat::eBC7;
+                break;
+            default:
+                return false;
+        }
+        offset += DX10_HEADER_SIZE;
+    } else if (four_cc == FourCC('D', 'X', 'T', '1')) {
+        result.format_ = NImageFormat::eBC1;
+    } else if (four_cc == FourCC('D', 'X', 'T', '5')) {
+        result.format_ = NImageFormat::eBC3;
+    } else if (four_cc == FourCC('A', 'T', 'I', '2') || four_cc == FourCC('B', 'C', '5', 'U')) {
+        result.format_ = NImageFormat::eBC5;
+    } else {
+        return false;
+    }
+    if (width == 0 || height == 0 || mip_count > NImage::MipCount(width, height)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < mip_count; ++i) {
+        NImageLevel level{(std::max)(width >> i, 1U), (std::max)(height >> i, 1U)};
+        auto size = NImage::LevelSize(result.format_, level.width_, level.height_);
+        if (bytes.size() < offset + size) {
+            return false;
+        }
+        level.data_.assign(bytes.begin() + static_cast<std::ptrdiff_t>(offset), bytes.begin() + static_cast<std::ptrdiff_t>(offset + size));
+        offset += size;
+        result.levels_.push_back(std::move(level));
+    }
+    image = std::move(result);
+    return true;
+}
+
+bool NImageLoader::DecodeAstc(const std::vector<uint8_t>& bytes, NImage& image) {
+    static constexpr size_t HEADER_SIZE{16};
+    if (bytes.size() < HEADER_SIZE || ReadU32(bytes, 0) != 0x5CA1AB13) {
+        return false;
+    }
+    // Only 2D 4x4 blocks; other footprints would need their own formats.
+    if (bytes[4] != 4 || bytes[5] != 4 || bytes[6] != 1 || ReadU24(bytes, 13) != 1) {
+        return false;
+    }
+    NImageLevel level{ReadU24(bytes, 7), ReadU24(bytes, 10)};
+    auto size = NImage::LevelSize(NImageFormat::eASTC4x4, level.width_, level.height_);
+    if (level.width_ == 0 || level.height_ == 0 || bytes.size() < HEADER_SIZE + size) {
+        return false;
+    }
+    level.data_.assign(bytes.begin() + HEADER_SIZE, bytes.begin() + static_cast<std::ptrdiff_t>(HEADER_SIZE + size));
+    image = NImage{};
+    image.format_ = NImageFormat::eASTC4x4;
+    image.levels_.push_back(std::move(level));
+    return true;
+}
+
+std::future<NImage> NImageLoader::Enqueue(std::function<NImage()> work) {
+    std::packaged_task<NImage()> task(std::move(work));
+    auto future = task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+    return future;
+}
+
+void NImageLoader::WorkerMain() {
+    N_PROFILE_THREAD("Image decode");
+    while (true) {
+        std::packaged_task<NImage()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] {
+                return is_stopping_ || !tasks_.empty();
+            });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
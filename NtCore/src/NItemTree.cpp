@@ -0,0 +1,283 @@
+/**
+ * @file NItemTree.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NItemTree.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+static bool ContainsPoint(const NRect& rect, const NPoint& point) {
+    return point.x_ >= rect.x_ && point.x_ < rect.Right() && point.y_ >= rect.y_ && point.y_ < rect.Bottom();
+}
+
+NItemTree::NItemTree() {
+    items_.emplace_back();
+    items_[ROOT].is_alive_ = true;
+}
+
+NItemID NItemTree::Add(NItemID parent, const NRect& bounds, DrawCallback draw) {
+    At(parent);
+    NItemID id{};
+    if (free_ids_.empty()) {
+        id = static_cast<NItemID>(items_.size());
+        items_.emplace_back();
+    } else {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    auto& item = items_[id];
+    item.parent_ = parent;
+    item.bounds_ = bounds;
+    item.draw_ = std::move(draw);
+    item.is_alive_ = true;
+    items_[parent].children_.push_back(id);
+    if (IsShown(parent)) {
+        item.proxy_ = index_.Insert(bounds, id);
+        Invalidate(bounds);
+    }
+    is_order_dirty_ = true;
+    return id;
+}
+
+void NItemTree::Remove(NItemID item) {
+    if (item == ROOT) {
+        throw std::runtime_error("The root item can't be removed.");
+    }
+    Hide(item);
+    auto& siblings = At(At(item).parent_).children_;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), item));
+    Release(item);
+    is_order_dirty_ = true;
+}
+
+void NItemTree::Clear() {
+    Hide(ROOT);
+    items_.resize(1);
+    items_[ROOT].children_.clear();
+    free_ids_.clear();
+    index_.Clear();
+    is_order_dirty_ = false;
+}
+
+bool NItemTree::Contains(NItemID item) const {
+    return item < items_.size() && items_[item].is_alive_;
+}
+
+NItemID NItemTree::Parent(NItemID item) const {
+    return At(item).parent_;
+}
+
+const std::vector<NItemID>& NItemTree::Children(NItemID item) const {
+    return At(item).children_;
+}
+
+const NRect& NItemTree::Bounds(NItemID item) const {
+    return At(item).bounds_;
+}
+
+void NItemTree::SetBounds(NItemID item, const NRect& bounds) {
+    auto& target = At(item);
+    if (target.proxy_ != NAabbTree::NULL_NODE) {
+        Invalidate(target.bounds_);
+        index_.Move(target.proxy_, bounds);
+        Invalidate(bounds);
+    }
+    target.bounds_ = bounds;
+}
+
+bool NItemTree::IsVisible(NItemID item) const {
+    return At(item).is_visible_;
+}
+
+void NItemTree::SetVisible(NItemID item, bool is_visible) {
+    auto& target = At(item);
+    if (item == ROOT || target.is_visible_ == is_visible) {
+        return;
+    }
+    target.is_visible_ = is_visible;
+    if (!IsShown(target.parent_)) {
+        return;
+    }
+    if (is_visible) {
+        Show(item);
+    } else {
+        Hide(item);
+    }
+}
+
+void NItemTree::SetDraw(NItemID item, DrawCallback draw) {
+    At(item).draw_ = std::move(draw);
+    Update(item);
+}
+
+void NItemTree::SetHitTest(NItemID item, HitTestCallback hit_test) {
+    At(item).hit_test_ = std::move(hit_test);
+}
+
+void NItemTree::SetMouseListener(NItemID item, MouseListener listener) {
+    At(item).mouse_listener_ = std::move(listener);
+}
+
+void NItemTree::Update(NItemID item) {
+    const auto& target = At(item);
+    if (target.proxy_ != NAabbTree::NULL_NODE) {
+        Invalidate(target.bounds_);
+    }
+}
+
+void NItemTree::SetInvalidateCallback(InvalidateCallback callback) {
+    invalidate_callback_ = std::move(callback);
+}
+
+size_t NItemTree::Record(NDrawList& draw_list, const NRect& viewport) {
+    UpdateOrder();
+    visible_.clear();
+    index_.Query(viewport, [this, &viewport](int32_t proxy) {
+        auto id = index_.UserData(proxy);
+        if (items_[id].bounds_.Intersects(viewport)) {
+            visible_.push_back(id);
+        }
+        return true;
+    });
+    std::sort(visible_.begin(), visible_.end(), [this](NItemID left, NItemID right) {
+        return items_[left].order_ < items_[right].order_;
+    });
+    for (auto id : visible_) {
+        const auto& item = items_[id];
+        if (item.draw_) {
+            item.draw_(draw_list, item.bounds_);
+        }
+    }
+    return visible_.size();
+}
+
+NItemID NItemTree::HitTest(const NPoint& point) {
+    UpdateOrder();
+    auto hit = ROOT;
+    index_.Query(point, [this, &point, &hit](int32_t proxy) {
+        auto id = index_.UserData(proxy);
+        const auto& item = items_[id];
+        if (item.order_ > items_[hit].order_ && ContainsPoint(item.bounds_, point) && (!item.hit_test_ || item.hit_test_(point))) {
+            hit = id;
+        }
+        return true;
+    });
+    return hit;
+}
+
+bool NItemTree::DispatchMouseEvent(const NMouseEvent& event) {
+    // Bubble from the topmost item under the pointer up to the root until a listener accepts it.
+    auto target = HitTest(event.position_);
+    while (Contains(target)) {
+        auto parent = items_[target].parent_;
+        auto listener = items_[target].mouse_listener_;
+        if (listener && listener(target, event)) {
+            return true;
+        }
+        if (target == ROOT) {
+            break;
+        }
+        target = parent;
+    }
+    return false;
+}
+
+size_t NItemTree::Size() const {
+    return items_.size() - free_ids_.size() - 1;
+}
+
+const NAabbTree& NItemTree::Index() const {
+    return index_;
+}
+
+NItemTree::Item& NItemTree::At(NItemID item) {
+    if (!Contains(item)) {
+        throw std::runtime_error("Invalid canvas item.");
+    }
+    return items_[item];
+}
+
+const NItemTree::Item& NItemTree::At(NItemID item) const {
+    if (!Contains(item)) {
+        throw std::runtime_error("Invalid canvas item.");
+    }
+    return items_[item];
+}
+
+bool NItemTree::IsShown(NItemID item) const {
+    for (; item != ROOT; item = items_[item].parent_) {
+        if (!items_[item].is_visible_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NItemTree::Show(NItemID item) {
+    std::vector<NItemID> stack{item};
+    while (!stack.empty()) {
+        auto id = stack.back();
+        stack.pop_back();
+        auto& target = items_[id];
+        if (!target.is_visible_) {
+            continue;
+        }
+        if (id != ROOT && target.proxy_ == NAabbTree::NULL_NODE) {
+            target.proxy_ = index_.Insert(target.bounds_, id);
+            Invalidate(target.bounds_);
+        }
+        stack.insert(stack.end(), target.children_.begin(), target.children_.end());
+    }
+}
+
+void NItemTree::Hide(NItemID item) {
+    std::vector<NItemID> stack{item};
+    while (!stack.empty()) {
+        auto id = stack.back();
+        stack.pop_back();
+        auto& target = items_[id];
+        if (target.proxy_ != NAabbTree::NULL_NODE) {
+            index_.Remove(target.proxy_);
+            target.proxy_ = NAabbTree::NULL_NODE;
+            Invalidate(target.bounds_);
+        }
+        stack.insert(stack.end(), target.children_.begin(), target.children_.end());
+    }
+}
+
+void NItemTree::Release(NItemID item) {
+    std::vector<NItemID> stack{item};
+    while (!stack.empty()) {
+        auto id = stack.back();
+        stack.pop_back();
+        stack.insert(stack.end(), items_[id].children_.begin(), items_[id].children_.end());
+        items_[id] = Item{};
+        free_ids_.push_back(id);
+    }
+}
+
+void NItemTree::UpdateOrder() {
+    if (!is_order_dirty_) {
+        return;
+    }
+    uint32_t order = 0;
+    std::vector<NItemID> stack{ROOT};
+    while (!stack.empty()) {
+        auto id = stack.back();
+        stack.pop_back();
+        auto& item = items_[id];
+        item.order_ = order++;
+        stack.insert(stack.end(), item.children_.rbegin(), item.children_.rend());
+    }
+    is_order_dirty_ = false;
+}
+
+void NItemTree::Invalidate(const NRect& rect) const {
+    if (invalidate_callback_) {
+        invalidate_callback_(rect);
+    }
+}
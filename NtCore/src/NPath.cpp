@@ -0,0 +1,83 @@
+/**
+ * @file NPath.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NPath.h"
+
+#include <bit>
+
+static constexpr uint64_t HASH_PRIME{0x100000001b3ULL};
+
+void NPath::MoveTo(const NPoint& point) {
+    Add(NPathVerb::eMove);
+    Add(point);
+}
+
+void NPath::LineTo(const NPoint& point) {
+    Add(NPathVerb::eLine);
+    Add(point);
+}
+
+void NPath::QuadTo(const NPoint& control, const NPoint& point) {
+    Add(NPathVerb::eQuad);
+    Add(control);
+    Add(point);
+}
+
+void NPath::CubicTo(const NPoint& control1, const NPoint& control2, const NPoint& point) {
+    Add(NPathVerb::eCubic);
+    Add(control1);
+    Add(control2);
+    Add(point);
+}
+
+void NPath::Close() {
+    Add(NPathVerb::eClose);
+}
+
+void NPath::Clear() {
+    verbs_.clear();
+    points_.clear();
+    hash_ = HASH_SEED;
+}
+
+bool NPath::Empty() const {
+    return verbs_.empty();
+}
+
+uint64_t NPath::Hash() const {
+    return hash_;
+}
+
+const std::vector<NPathVerb>& NPath::Verbs() const {
+    return verbs_;
+}
+
+const std::vector<NPoint>& NPath::Points() const {
+    return points_;
+}
+
+bool NPath::operator==(const NPath& path) const {
+    if (hash_ != path.hash_ || verbs_ != path.verbs_ || points_.size() != path.points_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < points_.size(); ++i) {
+        if (points_[i].x_ != path.points_[i].x_ || points_[i].y_ != path.points_[i].y_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NPath::Add(NPathVerb verb) {
+    verbs_.push_back(verb);
+    hash_ = (hash_ ^ static_cast<uint64_t>(verb)) * HASH_PRIME;
+}
+
+void NPath::Add(const NPoint& point) {
+    points_.push_back(point);
+    hash_ = (hash_ ^ std::bit_cast<uint32_t>(point.x_)) * HASH_PRIME;
+    hash_ = (hash_ ^ std::bit_cast<uint32_t>(point.y_)) * HASH_PRIME;
+}
@@ -0,0 +1,449 @@
+/**
+ * @file NPathCache.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NPathCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+static constexpr uint32_t MAX_CURVE_SEGMENTS{256};
+// Scale classes are quarter octaves.
+static constexpr float SCALE_CLASSES_PER_OCTAVE{4.0F};
+
+static float Cross(const NPoint& a, const NPoint& b, const NPoint& c) {
+    return (b.x_ - a.x_) * (c.y_ - a.y_) - (b.y_ - a.y_) * (c.x_ - a.x_);
+}
+
+static NPoint Lerp(const NPoint& a, const NPoint& b, float t) {
+    return {a.x_ + (b.x_ - a.x_) * t, a.y_ + (b.y_ - a.y_) * t};
+}
+
+static float Length(float x, float y) {
+    return std::sqrt(x * x + y * y);
+}
+
+static uint32_t CurveSegments(float deviation, float tolerance) {
+    return std::clamp(static_cast<uint32_t>(std::ceil(std::sqrt(deviation / tolerance))), 1U, MAX_CURVE_SEGMENTS);
+}
+
+static bool IsConvex(const std::vector<NPoint>& points) {
+    // Every turn in the same direction and one full revolution in total; a pentagram turns twice.
+    float turning = 0.0F;
+    float sign = 0.0F;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto& a = points[i];
+        const auto& b = points[(i + 1) % points.size()];
+        const auto& c = points[(i + 2) % points.size()];
+        auto cross = Cross(a, b, c);
+        if (cross != 0.0F) {
+            if (sign != 0.0F && (cross > 0.0F) != (sign > 0.0F)) {
+                return false;
+            }
+            sign = cross;
+        }
+        auto dot = (b.x_ - a.x_) * (c.x_ - b.x_) + (b.y_ - a.y_) * (c.y_ - b.y_);
+        turning += std::atan2(cross, dot);
+    }
+    return std::abs(std::abs(turning) - 2.0F * std::numbers::pi_v<float>) < 0.01F;
+}
+
+static bool SegmentsCross(const NPoint& a, const NPoint& b, const NPoint& c, const NPoint& d) {
+    auto d1 = Cross(c, d, a);
+    auto d2 = Cross(c, d, b);
+    auto d3 = Cross(a, b, c);
+    auto d4 = Cross(a, b, d);
+    return ((d1 > 0.0F && d2 < 0.0F) || (d1 < 0.0F && d2 > 0.0F)) && ((d3 > 0.0F && d4 < 0.0F) || (d3 < 0.0F && d4 > 0.0F));
+}
+
+static bool IsSimple(const std::vector<NPoint>& points) {
+    auto count = points.size();
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = i + 2; j < count; ++j) {
+            if (i == 0 && j == count - 1) {
+                continue;
+            }
+            if (SegmentsCross(points[i], points[(i + 1) % count], points[j], points[(j + 1) % count])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool EarClip(const std::vector<NPoint>& points, std::vector<NPoint>& triangles) {
+    std::vector<uint32_t> indices(points.size());
+    float area = 0.0F;
+    for (size_t i = 0; i < points.size(); ++i) {
+        indices[i] = static_cast<uint32_t>(i);
+        const auto& a = points[i];
+        const auto& b = points[(i + 1) % points.size()];
+        area += a.x_ * b.y_ - b.x_ * a.y_;
+    }
+    auto orientation = area > 0.0F ? 1.0F : -1.0F;
+    size_t guard = 0;
+    size_t i = 0;
+    while (indices.size() > 3) {
+        if (guard++ > indices.size()) {
+            return false;
+        }
+        auto count = indices.size();
+        const auto& a = points[indices[(i + count - 1) % count]];
+        const auto& b = points[indices[i % count]];
+        const auto& c = points[indices[(i + 1) % count]];
+        auto is_ear = Cross(a, b, c) * orientation > 0.0F;
+        for (size_t j = 0; is_ear && j < count; ++j) {
+            const auto& p = points[indices[j]];
+            if (&p == &a || &p == &b || &p == &c) {
+                continue;
+            }
+            if (Cross(a, b, p) * orientation >= 0.0F && Cross(b, c, p) * orientation >= 0.0F && Cross(c, a, p) * orientation >= 0.0F) {
+                is_ear = false;
+            }
+        }
+        if (is_ear) {
+            triangles.insert(triangles.end(), {a, b, c});
+            indices.erase(indices.begin() + static_cast<std::ptrdiff_t>(i % count));
+            guard = 0;
+        } else {
+            ++i;
+        }
+        i %= indices.size();
+    }
+    triangles.insert(triangles.end(), {points[indices[0]], points[indices[1]], points[indices[2]]});
+    return true;
+}
+
+static void Fan(const std::vector<NPoint>& points, std::vector<NPoint>& triangles) {
+    for (size_t i = 1; i + 1 < points.size(); ++i) {
+        triangles.insert(triangles.end(), {points[0], points[i], points[i + 1]});
+    }
+}
+
+static NRect Bounds(const std::vector<NPoint>& points) {
+    if (points.empty()) {
+        return {};
+    }
+    auto left = points[0].x_;
+    auto top = points[0].y_;
+    auto right = left;
+    auto bottom = top;
+    for (const auto& point : points) {
+        left = (std::min)(left, point.x_);
+        top = (std::min)(top, point.y_);
+        right = (std::max)(right, point.x_);
+        bottom = (std::max)(bottom, point.y_);
+    }
+    return {left, top, right - left, bottom - top};
+}
+
+bool NPathCache::Key::operator==(const Key& key) const {
+    return hash_ == key.hash_ && is_stroke_ == key.is_stroke_ && fill_rule_ == key.fill_rule_ && stroke_.width_ == key.stroke_.width_ && stroke_.join_ == key.stroke_.join_ && stroke_.cap_ == key.stroke_.cap_ && stroke_.miter_limit_ == key.stroke_.miter_limit_ && scale_class_ == key.scale_class_;
+}
+
+size_t NPathCache::KeyHash::operator()(const Key& key) const {
+    auto seed = static_cast<size_t>(key.hash_);
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(key.is_stroke_ ? 1 : 0);
+    combine(static_cast<size_t>(key.fill_rule_));
+    combine(std::bit_cast<uint32_t>(key.stroke_.width_));
+    combine(static_cast<size_t>(key.stroke_.join_) << 8 | static_cast<size_t>(key.stroke_.cap_));
+    combine(static_cast<size_t>(key.scale_class_));
+    return seed;
+}
+
+NPathCache::NPathCache(size_t capacity)
+    : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::runtime_error("Path cache needs room for at least one mesh.");
+    }
+}
+
+std::shared_ptr<const NPathMesh> NPathCache::Fill(const NPath& path, NFillRule rule, const NTransform& transform, bool is_dynamic) {
+    Key key{};
+    key.hash_ = path.Hash();
+    key.fill_rule_ = rule;
+    key.scale_class_ = static_cast<int32_t>(std::ceil(std::log2((std::max)(transform.MaxScale(), 1.0e-6F)) * SCALE_CLASSES_PER_OCTAVE));
+    auto tolerance = TOLERANCE / std::exp2(static_cast<float>(key.scale_class_) / SCALE_CLASSES_PER_OCTAVE);
+    if (is_dynamic) {
+        return TessellateFill(path, rule, tolerance, true);
+    }
+    if (auto mesh = Find(key, path)) {
+        return mesh;
+    }
+    std::shared_ptr<const NPathMesh> mesh = TessellateFill(path, rule, tolerance, false);
+    Insert(key, path, mesh);
+    return mesh;
+}
+
+std::shared_ptr<const NPathMesh> NPathCache::Stroke(const NPath& path, const NStrokeStyle& style, const NTransform& transform) {
+    Key key{};
+    key.hash_ = path.Hash();
+    key.is_stroke_ = true;
+    key.stroke_ = style;
+    key.scale_class_ = static_cast<int32_t>(std::ceil(std::log2((std::max)(transform.MaxScale(), 1.0e-6F)) * SCALE_CLASSES_PER_OCTAVE));
+    auto tolerance = TOLERANCE / std::exp2(static_cast<float>(key.scale_class_) / SCALE_CLASSES_PER_OCTAVE);
+    if (auto mesh = Find(key, path)) {
+        return mesh;
+    }
+    std::shared_ptr<const NPathMesh> mesh = TessellateStroke(path, style, tolerance);
+    Insert(key, path, mesh);
+    return mesh;
+}
+
+void NPathCache::SetStencilFallback(bool enabled) {
+    if (enabled != is_stencil_fallback_) {
+        is_stencil_fallback_ = enabled;
+        Clear();
+    }
+}
+
+void NPathCache::Clear() {
+    lookup_.clear();
+    entries_.clear();
+}
+
+size_t NPathCache::Size() const {
+    return entries_.size();
+}
+
+uint64_t NPathCache::TessellationCount() const {
+    return tessellation_count_;
+}
+
+std::shared_ptr<const NPathMesh> NPathCache::Find(const Key& key, const NPath& path) {
+    auto it = lookup_.find(key);
+    if (it == lookup_.end()) {
+        return nullptr;
+    }
+    for (auto entry : it->second) {
+        if (entry->path_ == path) {
+            entries_.splice(entries_.begin(), entries_, entry);
+            return entry->mesh_;
+        }
+    }
+    return nullptr;
+}
+
+void NPathCache::Insert(const Key& key, const NPath& path, const std::shared_ptr<const NPathMesh>& mesh) {
+    if (entries_.size() >= capacity_) {
+        auto& bucket = lookup_[entries_.back().key_];
+        bucket.erase(std::find(bucket.begin(), bucket.end(), std::prev(entries_.end())));
+        if (bucket.empty()) {
+            lookup_.erase(entries_.back().key_);
+        }
+        entries_.pop_back();
+    }
+    entries_.push_front({key, path, mesh});
+    lookup_[key].push_back(entries_.begin());
+}
+
+void NPathCache::Flatten(const NPath& path, float tolerance, std::vector<Contour>& contours, std::vector<bool>& closed) const {
+    contours.clear();
+    closed.clear();
+    const auto& points = path.Points();
+    size_t point = 0;
+    NPoint current{};
+    NPoint start{};
+    auto begin_contour = [&contours, &closed](const NPoint& at) {
+        contours.emplace_back().push_back(at);
+        closed.push_back(false);
+    };
+    for (auto verb : path.Verbs()) {
+        if (verb != NPathVerb::eMove && verb != NPathVerb::eClose && contours.empty()) {
+            begin_contour(current);
+        }
+        switch (verb) {
+            case NPathVerb::eMove:
+                current = start = points[point++];
+                begin_contour(current);
+                break;
+            case NPathVerb::eLine:
+                current = points[point++];
+                contours.back().push_back(current);
+                break;
+            case NPathVerb::eQuad: {
+                const auto& control = points[point];
+                const auto& end = points[point + 1];
+                auto deviation = Length(current.x_ - 2.0F * control.x_ + end.x_, current.y_ - 2.0F * control.y_ + end.y_) * 0.25F;
+                auto segments = CurveSegments(deviation, tolerance);
+                for (uint32_t i = 1; i <= segments; ++i) {
+                    auto t = static_cast<float>(i) / static_cast<float>(segments);
+                    contours.back().push_back(Lerp(Lerp(current, control, t), Lerp(control, end, t), t));
+                }
+                current = end;
+                point += 2;
+                break;
+            }
+            case NPathVerb::eCubic: {
+                const auto& control1 = points[point];
+                const auto& control2 = points[point + 1];
+                const auto& end = points[point + 2];
+                auto deviation = 0.75F * (std::max)(Length(current.x_ - 2.0F * control1.x_ + control2.x_, current.y_ - 2.0F * control1.y_ + control2.y_), Length(control1.x_ - 2.0F * control2.x_ + end.x_, control1.y_ - 2.0F * control2.y_ + end.y_));
+                auto segments = CurveSegments(deviation, tolerance);
+                for (uint32_t i = 1; i <= segments; ++i) {
+                    auto t = static_cast<float>(i) / static_cast<float>(segments);
+                    auto a = Lerp(current, control1, t);
+                    auto b = Lerp(control1, control2, t);
+                    auto c = Lerp(control2, end, t);
+                    contours.back().push_back(Lerp(Lerp(a, b, t), Lerp(b, c, t), t));
+                }
+                current = end;
+                point += 3;
+                break;
+            }
+            case NPathVerb::eClose:
+                if (!contours.empty()) {
+                    closed.back() = true;
+                }
+                current = start;
+                break;
+        }
+    }
+    // Drop repeated points, including a closing point that repeats the start.
+    for (size_t i = 0; i < contours.size(); ++i) {
+        auto& contour = contours[i];
+        contour.erase(std::unique(contour.begin(), contour.end(), [](const NPoint& a, const NPoint& b) {
+            return a.x_ == b.x_ && a.y_ == b.y_;
+        }), contour.end());
+        if (contour.size() > 1 && contour.front().x_ == contour.back().x_ && contour.front().y_ == contour.back().y_) {
+            contour.pop_back();
+            closed[i] = true;
+        }
+    }
+}
+
+std::shared_ptr<NPathMesh> NPathCache::TessellateFill(const NPath& path, NFillRule rule, float tolerance, bool is_dynamic) {
+    ++tessellation_count_;
+    Flatten(path, tolerance, contours_, closed_);
+    auto mesh = std::make_shared<NPathMesh>();
+    mesh->fill_rule_ = rule;
+    size_t point_count = 0;
+    size_t contour_count = 0;
+    const Contour* single = nullptr;
+    for (const auto& contour : contours_) {
+        if (contour.size() >= 3) {
+            point_count += contour.size();
+            ++contour_count;
+            single = &contour;
+        }
+    }
+    if (contour_count == 0) {
+        return mesh;
+    }
+    auto use_stencil = is_dynamic || contour_count > 1 || point_count > COMPLEX_POINT_COUNT;
+    if (!use_stencil) {
+        if (IsConvex(*single)) {
+            Fan(*single, mesh->vertices_);
+        } else if (!IsSimple(*single) || !EarClip(*single, mesh->vertices_)) {
+            mesh->vertices_.clear();
+            use_stencil = true;
+        }
+    }
+    if (use_stencil && !is_stencil_fallback_) {
+        // Without a stencil buffer every contour is triangulated on its own; overlaps and holes are lost.
+        for (const auto& contour : contours_) {
+            auto first = mesh->vertices_.size();
+            if (contour.size() >= 3 && !EarClip(contour, mesh->vertices_)) {
+                mesh->vertices_.resize(first);
+                Fan(contour, mesh->vertices_);
+            }
+        }
+        use_stencil = false;
+    }
+    if (use_stencil) {
+        for (const auto& contour : contours_) {
+            if (contour.size() >= 3) {
+                Fan(contour, mesh->vertices_);
+            }
+        }
+    }
+    mesh->bounds_ = Bounds(mesh->vertices_);
+    mesh->fill_vertex_count_ = static_cast<uint32_t>(mesh->vertices_.size());
+    mesh->is_stencil_ = use_stencil;
+    if (use_stencil) {
+        const auto& bounds = mesh->bounds_;
+        mesh->vertices_.insert(mesh->vertices_.end(), {
+            {bounds.x_, bounds.y_},
+            {bounds.Right(), bounds.y_},
+            {bounds.x_, bounds.Bottom()},
+            {bounds.Right(), bounds.y_},
+            {bounds.Right(), bounds.Bottom()},
+            {bounds.x_, bounds.Bottom()},
+        });
+    }
+    return mesh;
+}
+
+std::shared_ptr<NPathMesh> NPathCache::TessellateStroke(const NPath& path, const NStrokeStyle& style, float tolerance) {
+    ++tessellation_count_;
+    Flatten(path, tolerance, contours_, closed_);
+    auto mesh = std::make_shared<NPathMesh>();
+    auto half = style.width_ * 0.5F;
+    auto& out = mesh->vertices_;
+    for (size_t c = 0; c < contours_.size(); ++c) {
+        auto points = contours_[c];
+        auto is_closed = closed_[c] && points.size() > 2;
+        if (points.size() < 2) {
+            continue;
+        }
+        auto segment_count = is_closed ? points.size() : points.size() - 1;
+        auto direction = [&points](size_t i) {
+            const auto& a = points[i % points.size()];
+            const auto& b = points[(i + 1) % points.size()];
+            auto length = Length(b.x_ - a.x_, b.y_ - a.y_);
+            return NPoint{(b.x_ - a.x_) / length, (b.y_ - a.y_) / length};
+        };
+        if (!is_closed && style.cap_ == NLineCap::eSquare) {
+            auto first = direction(0);
+            auto last = direction(points.size() - 2);
+            points.front() = {points.front().x_ - first.x_ * half, points.front().y_ - first.y_ * half};
+            points.back() = {points.back().x_ + last.x_ * half, points.back().y_ + last.y_ * half};
+        }
+        for (size_t i = 0; i < segment_count; ++i) {
+            auto d = direction(i);
+            NPoint normal{-d.y_ * half, d.x_ * half};
+            const auto& a = points[i];
+            const auto& b = points[(i + 1) % points.size()];
+            NPoint a0{a.x_ + normal.x_, a.y_ + normal.y_};
+            NPoint a1{a.x_ - normal.x_, a.y_ - normal.y_};
+            NPoint b0{b.x_ + normal.x_, b.y_ + normal.y_};
+            NPoint b1{b.x_ - normal.x_, b.y_ - normal.y_};
+            out.insert(out.end(), {a0, b0, a1, a1, b0, b1});
+        }
+        // Joins fill the wedge on the outer side of each turn.
+        auto join_count = is_closed ? points.size() : points.size() - 2;
+        for (size_t j = 0; j < join_count; ++j) {
+            auto i = is_closed ? j : j + 1;
+            auto d0 = direction(i + points.size() - 1);
+            auto d1 = direction(i);
+            auto cross = d0.x_ * d1.y_ - d0.y_ * d1.x_;
+            if (cross == 0.0F) {
+                continue;
+            }
+            auto side = cross > 0.0F ? -half : half;
+            const auto& p = points[i % points.size()];
+            NPoint o0{p.x_ - d0.y_ * side, p.y_ + d0.x_ * side};
+            NPoint o1{p.x_ - d1.y_ * side, p.y_ + d1.x_ * side};
+            auto cos_half = std::sqrt((std::max)((1.0F + d0.x_ * d1.x_ + d0.y_ * d1.y_) * 0.5F, 0.0F));
+            if (style.join_ == NLineJoin::eMiter && cos_half > 0.0F && 1.0F / cos_half <= style.miter_limit_) {
+                NPoint bisector{o0.x_ + o1.x_ - 2.0F * p.x_, o0.y_ + o1.y_ - 2.0F * p.y_};
+                auto scale = half / cos_half / Length(bisector.x_, bisector.y_);
+                NPoint miter{p.x_ + bisector.x_ * scale, p.y_ + bisector.y_ * scale};
+                out.insert(out.end(), {p, o0, miter, p, miter, o1});
+            } else {
+                out.insert(out.end(), {p, o0, o1});
+            }
+        }
+    }
+    mesh->bounds_ = Bounds(out);
+    mesh->fill_vertex_count_ = static_cast<uint32_t>(out.size());
+    return mesh;
+}
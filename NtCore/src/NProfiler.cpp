@@ -0,0 +1,165 @@
+/**
+ * @file NProfiler.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static void WriteJsonString(std::ostringstream& stream, const std::string& value) {
+    stream << '"';
+    for (auto c : value) {
+        if (c == '"' || c == '\\') {
+            stream << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            stream << ' ';
+        } else {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+NProfiler::NProfiler() : epoch_(Now()) {
+}
+
+void NProfiler::Record(const char* name, int64_t begin, int64_t end, bool is_gpu) {
+    auto& ring = CurrentRing();
+    auto head = ring.head_.load(std::memory_order_relaxed);
+    if (head - ring.tail_.load(std::memory_order_acquire) == RING_SIZE) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring.events_[head % RING_SIZE] = NProfileEvent{name, begin, end, ring.thread_, is_gpu};
+    ring.head_.store(head + 1, std::memory_order_release);
+}
+
+void NProfiler::SetThreadName(const std::string& name) {
+    auto& ring = CurrentRing();
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring.name_ = name;
+}
+
+void NProfiler::Collect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& ring : rings_) {
+        auto tail = ring->tail_.load(std::memory_order_relaxed);
+        auto head = ring->head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            events_.push_back(ring->events_[tail % RING_SIZE]);
+        }
+        ring->tail_.store(tail, std::memory_order_release);
+    }
+}
+
+void NProfiler::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& ring : rings_) {
+        ring->tail_.store(ring->head_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    events_.clear();
+    exited_threads_.clear();
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+const std::vector<NProfileEvent>& NProfiler::Events() const {
+    return events_;
+}
+
+uint64_t NProfiler::DroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+size_t NProfiler::RingCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rings_.size();
+}
+
+std::string NProfiler::ChromeTrace() {
+    Collect();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // CPU threads are process 1 and the GPU timeline is process 2, so trace viewers keep them apart.
+    std::ostringstream stream{};
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    stream << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"CPU"}},)";
+    stream << R"({"name":"process_name","ph":"M","pid":2,"tid":0,"args":{"name":"GPU"}},)";
+    stream << R"({"name":"thread_name","ph":"M","pid":2,"tid":0,"args":{"name":"Graphics queue"}})";
+    for (const auto& ring : rings_) {
+        stream << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->thread_ << ",\"args\":{\"name\":";
+        WriteJsonString(stream, ring->name_.empty() ? "Thread " + std::to_string(ring->thread_) : ring->name_);
+        stream << "}}";
+    }
+    for (const auto& [thread, name] : exited_threads_) {
+        stream << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+        WriteJsonString(stream, name.empty() ? "Thread " + std::to_string(thread) : name);
+        stream << "}}";
+    }
+    stream.setf(std::ios::fixed);
+    stream.precision(3);
+    for (const auto& event : events_) {
+        stream << ",{\"name\":";
+        WriteJsonString(stream, event.name_ ? event.name_ : "");
+        stream << ",\"ph\":\"X\",\"pid\":" << (event.is_gpu_ ? 2 : 1) << ",\"tid\":" << (event.is_gpu_ ? 0 : event.thread_);
+        stream << ",\"ts\":" << static_cast<double>(event.begin_ - epoch_) / 1000.0;
+        stream << ",\"dur\":" << static_cast<double>((std::max)(event.end_ - event.begin_, int64_t{0})) / 1000.0 << "}";
+    }
+    stream << "]}";
+    return stream.str();
+}
+
+void NProfiler::WriteChromeTrace(const std::filesystem::path& path) {
+    auto trace = ChromeTrace();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open the trace file.");
+    }
+    file.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write the trace file.");
+    }
+}
+
+int64_t NProfiler::Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+NProfiler::ThreadRing& NProfiler::CurrentRing() {
+    // Rings belong to the profiler, so zones of threads that have exited are still collected.
+    struct RingOwner {
+        ThreadRing* ring_{nullptr};
+        ~RingOwner() {
+            if (ring_) {
+                NProfiler::Singleton().ReleaseRing(*ring_);
+            }
+        }
+    };
+    thread_local RingOwner owner{};
+    if (!owner.ring_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_rings_.empty()) {
+            owner.ring_ = free_rings_.back();
+            free_rings_.pop_back();
+            owner.ring_->name_.clear();
+        } else {
+            rings_.push_back(std::make_unique<ThreadRing>());
+            owner.ring_ = rings_.back().get();
+        }
+        // A recycled ring still holds the previous thread's zones, so the new thread gets its own id.
+        owner.ring_->thread_ = next_thread_++;
+    }
+    return *owner.ring_;
+}
+
+void NProfiler::ReleaseRing(ThreadRing& ring) {
+    // Events still in the ring stay there for the next Collect; the new owner appends after them.
+    // The exited thread's name is kept for its zones, collected or not.
+    std::lock_guard<std::mutex> lock(mutex_);
+    exited_threads_[ring.thread_] = ring.name_;
+    free_rings_.push_back(&ring);
+}
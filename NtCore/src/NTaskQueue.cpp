@@ -0,0 +1,82 @@
+/**
+ * @file NTaskQueue.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NTaskQueue.h"
+
+#include <memory>
+
+NTaskQueue::NTaskQueue() : head_(&stub_), tail_(&stub_) {
+}
+
+NTaskQueue::~NTaskQueue() {
+    while (auto* node = Pop()) {
+        delete node;
+    }
+}
+
+size_t NTaskQueue::Drain(std::chrono::steady_clock::duration budget) {
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    size_t count = 0;
+    while (auto* node = Pop()) {
+        std::unique_ptr<Node> task(node);
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        task->Run();
+        ++count;
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return count;
+}
+
+bool NTaskQueue::Empty() const {
+    return size_.load(std::memory_order_acquire) == 0;
+}
+
+size_t NTaskQueue::Size() const {
+    return size_.load(std::memory_order_acquire);
+}
+
+bool NTaskQueue::PushNode(Node* node) {
+    // Count before linking so the consumer can never decrement below zero.
+    auto was_empty = size_.fetch_add(1, std::memory_order_acq_rel) == 0;
+    Link(node);
+    return was_empty;
+}
+
+void NTaskQueue::Link(Node* node) {
+    node->next_.store(nullptr, std::memory_order_relaxed);
+    auto* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next_.store(node, std::memory_order_release);
+}
+
+NTaskQueue::Node* NTaskQueue::Pop() {
+    auto* tail = tail_;
+    auto* next = tail->next_.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+        if (!next) {
+            return nullptr;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next_.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail_ = next;
+        return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+        // A producer has swapped head but not linked its node yet.
+        return nullptr;
+    }
+    Link(&stub_);
+    next = tail->next_.load(std::memory_order_acquire);
+    if (next) {
+        tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
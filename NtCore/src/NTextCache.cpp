@@ -0,0 +1,169 @@
+/**
+ * @file NTextCache.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NTextCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+
+static size_t HashFont(size_t seed, const NFont& font) {
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<std::wstring>{}(font.family_));
+    combine(std::bit_cast<uint32_t>(font.size_));
+    combine(font.weight_);
+    combine(font.italic_ ? 1 : 0);
+    return seed;
+}
+
+static char32_t NextCodepoint(std::wstring_view text, size_t& index) {
+    auto unit = static_cast<char32_t>(text[index++]);
+    if constexpr (sizeof(wchar_t) == 2) {
+        if (unit >= 0xD800 && unit <= 0xDBFF && index < text.size()) {
+            auto low = static_cast<char32_t>(text[index]);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                ++index;
+                return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            }
+        }
+    }
+    return unit;
+}
+
+size_t NTextCache::KeyHash::operator()(const Key& key) const {
+    return HashFont(std::hash<std::wstring_view>{}(key.text_), key.font_);
+}
+
+size_t NTextCache::KeyHash::operator()(const KeyView& key) const {
+    return HashFont(std::hash<std::wstring_view>{}(key.text_), *key.font_);
+}
+
+bool NTextCache::KeyEqual::operator()(const Key& left, const Key& right) const {
+    return left.text_ == right.text_ && left.font_ == right.font_;
+}
+
+bool NTextCache::KeyEqual::operator()(const KeyView& left, const Key& right) const {
+    return left.text_ == right.text_ && *left.font_ == right.font_;
+}
+
+bool NTextCache::KeyEqual::operator()(const Key& left, const KeyView& right) const {
+    return left.text_ == right.text_ && left.font_ == *right.font_;
+}
+
+NTextCache::NTextCache(NGlyphRasterizer& rasterizer, NGlyphAtlas& atlas, size_t capacity)
+    : rasterizer_(rasterizer), atlas_(atlas), capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::runtime_error("Text cache needs room for at least one run.");
+    }
+}
+
+const NShapedRun& NTextCache::Shape(std::wstring_view text, const NFont& font) {
+    return Find(text, font);
+}
+
+void NTextCache::DrawText(NDrawList& list, std::wstring_view text, const NFont& font, const NPoint& baseline, const NColor& color) {
+    auto& run = Find(text, font);
+    if (!run.is_resolved_ || run.atlas_generation_ != atlas_.Generation()) {
+        Resolve(font, run);
+    } else {
+        for (auto page : run.pages_) {
+            atlas_.Touch(page);
+        }
+    }
+    list.DrawGlyphs(run.quads_, baseline, color);
+}
+
+void NTextCache::Clear() {
+    lookup_.clear();
+    entries_.clear();
+}
+
+size_t NTextCache::Size() const {
+    return entries_.size();
+}
+
+uint64_t NTextCache::ShapeCount() const {
+    return shape_count_;
+}
+
+NShapedRun& NTextCache::Find(std::wstring_view text, const NFont& font) {
+    auto it = lookup_.find(KeyView{text, &font});
+    if (it != lookup_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->run_;
+    }
+    if (entries_.size() >= capacity_) {
+        lookup_.erase(entries_.back().key_);
+        entries_.pop_back();
+    }
+    auto& entry = entries_.emplace_front();
+    entry.key_ = {std::wstring(text), font};
+    ShapeRun(text, font, entry.run_);
+    lookup_.emplace(entry.key_, entries_.begin());
+    return entry.run_;
+}
+
+void NTextCache::ShapeRun(std::wstring_view text, const NFont& font, NShapedRun& run) {
+    ++shape_count_;
+    auto metrics = rasterizer_.FontMetrics(font);
+    run.ascent_ = metrics.ascent_;
+    run.descent_ = metrics.descent_;
+    run.glyphs_.clear();
+    float pen = 0.0F;
+    char32_t previous = 0;
+    for (size_t i = 0; i < text.size();) {
+        auto codepoint = NextCodepoint(text, i);
+        if (codepoint == U'\n' || codepoint == U'\r') {
+            continue;
+        }
+        if (previous != 0) {
+            pen += rasterizer_.Kerning(font, previous, codepoint);
+        }
+        auto glyph = rasterizer_.GlyphIndex(font, codepoint);
+        run.glyphs_.push_back({glyph, pen});
+        pen += rasterizer_.Advance(font, glyph);
+        previous = codepoint;
+    }
+    run.width_ = pen;
+    run.is_resolved_ = false;
+}
+
+void NTextCache::Resolve(const NFont& font, NShapedRun& run) {
+    auto scale = font.size_ / NGlyphAtlas::REFERENCE_SIZE;
+    auto inverse_page_size = 1.0F / static_cast<float>(atlas_.PageSize());
+    run.quads_.clear();
+    run.pages_.clear();
+    run.is_resolved_ = true;
+    for (const auto& shaped : run.glyphs_) {
+        auto glyph = atlas_.Find(font, shaped.glyph_);
+        if (!glyph) {
+            // The atlas is full of glyphs on screen this frame; try again next frame.
+            run.is_resolved_ = false;
+            continue;
+        }
+        if (glyph->is_empty_) {
+            continue;
+        }
+        NGlyphQuad quad{};
+        quad.rect_ = {shaped.x_ + glyph->bearing_x_ * scale, glyph->bearing_y_ * scale, static_cast<float>(glyph->region_.width_) * scale, static_cast<float>(glyph->region_.height_) * scale};
+        quad.uv_ = {static_cast<float>(glyph->region_.x_) * inverse_page_size, static_cast<float>(glyph->region_.y_) * inverse_page_size, static_cast<float>(glyph->region_.width_) * inverse_page_size, static_cast<float>(glyph->region_.height_) * inverse_page_size};
+        quad.texture_ = glyph->texture_;
+        run.quads_.push_back(quad);
+        if (std::find(run.pages_.begin(), run.pages_.end(), glyph->page_) == run.pages_.end()) {
+            run.pages_.push_back(glyph->page_);
+        }
+    }
+    // Keep glyphs of one page together so a run costs one occupant per page in the draw list.
+    if (run.pages_.size() > 1) {
+        std::stable_sort(run.quads_.begin(), run.quads_.end(), [](const NGlyphQuad& left, const NGlyphQuad& right) {
+            return left.texture_ < right.texture_;
+        });
+    }
+    run.atlas_generation_ = atlas_.Generation();
+}
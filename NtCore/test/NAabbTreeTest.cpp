@@ -0,0 +1,95 @@
+/**
+ * @file NAabbTreeTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "NAabbTree.h"
+
+static std::set<uint32_t> QueryTree(const NAabbTree& tree, const std::vector<NRect>& bounds, const NRect& area) {
+    std::set<uint32_t> result;
+    tree.Query(area, [&](int32_t proxy) {
+        auto id = tree.UserData(proxy);
+        if (bounds[id].Intersects(area)) {
+            result.insert(id);
+        }
+        return true;
+    });
+    return result;
+}
+
+static std::set<uint32_t> QueryAll(const std::vector<NRect>& bounds, const std::vector<bool>& alive, const NRect& area) {
+    std::set<uint32_t> result;
+    for (uint32_t id = 0; id < bounds.size(); ++id) {
+        if (alive[id] && bounds[id].Intersects(area)) {
+            result.insert(id);
+        }
+    }
+    return result;
+}
+
+int main() {
+    static constexpr uint32_t COUNT{5000};
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(0.0F, 4000.0F);
+    std::uniform_real_distribution<float> size(1.0F, 40.0F);
+    std::uniform_real_distribution<float> step(-10.0F, 10.0F);
+
+    NAabbTree tree;
+    std::vector<NRect> bounds(COUNT);
+    std::vector<int32_t> proxies(COUNT);
+    std::vector<bool> alive(COUNT, true);
+    for (uint32_t id = 0; id < COUNT; ++id) {
+        bounds[id] = {position(random), position(random), size(random), size(random)};
+        proxies[id] = tree.Insert(bounds[id], id);
+    }
+    // A balanced tree over n leaves is about log2(n) high; allow the rotations some slack.
+    auto limit = static_cast<int32_t>(2.0 * std::log2(static_cast<double>(COUNT)));
+    if (tree.Size() != COUNT || tree.Height() > limit) {
+        return 1;
+    }
+
+    // Move everything a little, then drop every third item; queries must match a linear scan.
+    uint32_t reinserts = 0;
+    for (uint32_t id = 0; id < COUNT; ++id) {
+        bounds[id].x_ += step(random);
+        bounds[id].y_ += step(random);
+        reinserts += tree.Move(proxies[id], bounds[id]) ? 1 : 0;
+    }
+    for (uint32_t id = 0; id < COUNT; id += 3) {
+        tree.Remove(proxies[id]);
+        alive[id] = false;
+    }
+    for (int i = 0; i < 100; ++i) {
+        NRect area{position(random), position(random), 300.0F, 200.0F};
+        if (QueryTree(tree, bounds, area) != QueryAll(bounds, alive, area)) {
+            return 1;
+        }
+    }
+    std::cout << tree.Size() << " leaves, height " << tree.Height() << ", " << reinserts << " of " << COUNT << " moves reinserted" << std::endl;
+    if (tree.Height() > limit || reinserts == 0 || reinserts == COUNT) {
+        return 1;
+    }
+
+    // Freed nodes are reused and a visitor can stop the query early.
+    auto proxy = tree.Insert({0.0F, 0.0F, 10.0F, 10.0F}, COUNT);
+    if (static_cast<size_t>(proxy) >= 2 * COUNT) {
+        return 1;
+    }
+    size_t visited = 0;
+    tree.Query(NRect{0.0F, 0.0F, 4000.0F, 4000.0F}, [&visited](int32_t) {
+        ++visited;
+        return false;
+    });
+    if (visited != 1) {
+        return 1;
+    }
+    tree.Clear();
+    return tree.Size() == 0 && tree.Height() == 0 ? 0 : 1;
+}
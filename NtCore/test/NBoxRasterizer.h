@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ * @file NBoxRasterizer.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "NGlyphRasterizer.h"
+
+/**
+ * @brief Test rasterizer that draws every glyph but the space as a solid box, so tests do not depend
+ * on an installed font. "AV" is kerned so shaping has a pair to apply.
+ */
+class NBoxRasterizer : public NGlyphRasterizer {
+public:
+    explicit NBoxRasterizer(uint32_t width = 12, uint32_t height = 20) : width_(width), height_(height) {}
+
+public:
+    NFontMetrics FontMetrics(const NFont& font) override {
+        return {font.size_ * 0.8F, font.size_ * 0.2F, 0.0F};
+    }
+
+    uint32_t GlyphIndex(const NFont& /*font*/, char32_t codepoint) override {
+        return codepoint;
+    }
+
+    float Advance(const NFont& font, uint32_t /*glyph*/) override {
+        return font.size_ * 0.5F;
+    }
+
+    float Kerning(const NFont& font, char32_t left, char32_t right) override {
+        return left == U'A' && right == U'V' ? -font.size_ * 0.1F : 0.0F;
+    }
+
+    bool Rasterize(const NFont& font, uint32_t glyph, NGlyphBitmap& bitmap) override {
+        ++rasterize_count_;
+        bitmap.advance_ = font.size_ * 0.5F;
+        bitmap.width_ = glyph == U' ' ? 0 : width_;
+        bitmap.height_ = glyph == U' ' ? 0 : height_;
+        bitmap.bearing_x_ = 1.0F;
+        bitmap.bearing_y_ = -static_cast<float>(height_);
+        bitmap.coverage_.assign(static_cast<size_t>(bitmap.width_) * bitmap.height_, 255);
+        return true;
+    }
+
+public:
+    size_t rasterize_count_{0};
+
+private:
+    uint32_t width_{12};
+    uint32_t height_{20};
+};
@@ -0,0 +1,51 @@
+/**
+ * @file NDamageRegionTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <iostream>
+
+#include "NDamageRegion.h"
+
+int main() {
+    NDamageRegion region;
+    if (!region.Empty()) {
+        return 1;
+    }
+    // Overlapping and touching rects merge, including through a rect that bridges two others.
+    region.Add({0.0F, 0.0F, 10.0F, 10.0F});
+    region.Add({100.0F, 0.0F, 10.0F, 10.0F});
+    if (region.Rects().size() != 2) {
+        return 1;
+    }
+    region.Add({10.0F, 0.0F, 90.0F, 5.0F});
+    if (region.Rects().size() != 1 || region.Bounds().width_ != 110.0F) {
+        return 1;
+    }
+
+    // A monitoring screen updating many small values stays within MAX_RECTS.
+    region.Clear();
+    for (int i = 0; i < 40; ++i) {
+        region.Add({static_cast<float>(i % 8) * 200.0F, static_cast<float>(i / 8) * 100.0F, 50.0F, 20.0F});
+    }
+    std::cout << region.Rects().size() << " rects, bounds " << region.Bounds().width_ << "x" << region.Bounds().height_ << std::endl;
+    if (region.Rects().size() > NDamageRegion::MAX_RECTS) {
+        return 1;
+    }
+    for (size_t a = 0; a < region.Rects().size(); ++a) {
+        for (size_t b = a + 1; b < region.Rects().size(); ++b) {
+            if (region.Rects()[a].Intersects(region.Rects()[b])) {
+                return 1;
+            }
+        }
+    }
+
+    NDamageRegion full;
+    full.AddAll();
+    region.Add(full);
+    if (!region.IsFull() || !region.Rects().empty()) {
+        return 1;
+    }
+    return 0;
+}
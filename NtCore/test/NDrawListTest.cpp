@@ -0,0 +1,63 @@
+/**
+ * @file NDrawListTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "NDrawList.h"
+
+int main() {
+    constexpr uint32_t GRID_SIZE{100};
+    NDrawList list;
+    std::chrono::duration<double, std::milli> elapsed{};
+    // A dashboard-like grid: every cell has a background, an icon and a border line. The second frame
+    // reuses the storage of the first, as a real frame loop would.
+    for (int frame = 0; frame < 2; ++frame) {
+        list.Clear();
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t y = 0; y < GRID_SIZE; ++y) {
+            for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+                NRect cell{x * 24.0F, y * 24.0F, 18.0F, 18.0F};
+                list.DrawRoundedRect(cell, 3.0F, {0.2F, 0.2F, 0.2F, 1.0F});
+                list.DrawImage(1 + (x + y) % 2, {cell.x_ + 2.0F, cell.y_ + 2.0F, 14.0F, 14.0F});
+                list.DrawLine({cell.x_, cell.Bottom()}, {cell.Right(), cell.Bottom()}, 1.0F, {1.0F, 1.0F, 1.0F, 1.0F});
+            }
+        }
+        list.Finish();
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    std::cout << list.PrimitiveCount() << " primitives in " << list.Batches().size() << " batches, " << elapsed.count() << " ms" << std::endl;
+    if (list.Instances().size() != list.PrimitiveCount()) {
+        return 1;
+    }
+
+    // Overlapping primitives of different pipelines must keep their order.
+    list.Clear();
+    list.DrawRect({0.0F, 0.0F, 10.0F, 10.0F}, {});
+    list.DrawImage(1, {5.0F, 5.0F, 10.0F, 10.0F});
+    list.DrawRect({8.0F, 8.0F, 10.0F, 10.0F}, {});
+    list.Finish();
+    if (list.Batches().size() != 3) {
+        return 1;
+    }
+
+    // Disjoint ones can share a batch.
+    list.Clear();
+    list.DrawRect({0.0F, 0.0F, 10.0F, 10.0F}, {});
+    list.DrawImage(1, {20.0F, 20.0F, 10.0F, 10.0F});
+    list.DrawRect({40.0F, 40.0F, 10.0F, 10.0F}, {});
+    list.Finish();
+    const auto& batches = list.Batches();
+    if (batches.size() != 2 || batches[0].instance_count_ != 2 || list.Instances()[1].rect_[0] != 40.0F) {
+        return 1;
+    }
+    // A batch's bounds cover all of its primitives and nothing of the others.
+    const auto& bounds = batches[0].bounds_;
+    if (bounds.x_ > 0.0F || bounds.y_ > 0.0F || bounds.Right() < 50.0F || bounds.Bottom() < 50.0F || batches[1].bounds_.Intersects({0.0F, 0.0F, 20.0F, 20.0F})) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file NEventLoopRunModeTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "NEventLoop.h"
+
+int main() {
+    // The loop needs a display connection; without one there is nothing to drive.
+    std::unique_ptr<NEventLoop> event_loop{};
+    try {
+        event_loop = std::make_unique<NEventLoop>();
+    } catch (const std::runtime_error& error) {
+        std::cout << "skipped: " << error.what() << std::endl;
+        return 0;
+    }
+    auto& loop = *event_loop;
+
+    // Continuous runs a frame on every iteration until told to stop.
+    static constexpr int CONTINUOUS_FRAMES{100};
+    int frames = 0;
+    loop.SetRunMode(NRunMode::eContinuous);
+    loop.SetFrameCallback([&loop, &frames]() {
+        if (++frames == CONTINUOUS_FRAMES) {
+            loop.Quit(0);
+        }
+    });
+    if (loop.Exec() != 0 || frames != CONTINUOUS_FRAMES) {
+        return 1;
+    }
+
+    // On demand renders the initial frame, then only after an Invalidate; another thread invalidates four
+    // times and then asks the loop to quit.
+    static constexpr int INVALIDATIONS{4};
+    frames = 0;
+    loop.SetRunMode(NRunMode::eOnDemand);
+    loop.SetFrameCallback([&frames]() {
+        ++frames;
+    });
+    std::thread invalidator([&loop]() {
+        for (int i = 0; i < INVALIDATIONS; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            loop.Invalidate();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        loop.Post([&loop]() {
+            loop.Quit(0);
+        });
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto exit_code = loop.Exec();
+    std::chrono::duration<double, std::milli> on_demand_ms = std::chrono::steady_clock::now() - start;
+    invalidator.join();
+    // Invalidations that land before the previous frame ran coalesce, but an idle loop never renders.
+    if (exit_code != 0 || frames < 2 || frames > INVALIDATIONS + 1) {
+        return 1;
+    }
+    auto frames_on_demand = frames;
+
+    // Paced holds the target rate instead of running as fast as it can.
+    static constexpr uint32_t FRAME_RATE{100};
+    static constexpr int PACED_FRAMES{30};
+    frames = 0;
+    loop.SetRunMode(NRunMode::ePaced);
+    loop.SetTargetFrameRate(FRAME_RATE);
+    loop.SetFrameCallback([&loop, &frames]() {
+        if (++frames == PACED_FRAMES) {
+            loop.Quit(0);
+        }
+    });
+    start = std::chrono::steady_clock::now();
+    exit_code = loop.Exec();
+    std::chrono::duration<double, std::milli> paced_ms = std::chrono::steady_clock::now() - start;
+    // The first frame is due immediately, so PACED_FRAMES - 1 periods pass; allow scheduler slack.
+    auto expected_ms = 1000.0 * (PACED_FRAMES - 1) / FRAME_RATE;
+    if (exit_code != 0 || frames != PACED_FRAMES || paced_ms.count() < expected_ms * 0.9 || paced_ms.count() > expected_ms * 4.0) {
+        return 1;
+    }
+    std::cout << CONTINUOUS_FRAMES << " continuous frames, " << frames_on_demand << " on-demand frames in " << on_demand_ms.count() << " ms, "
+              << PACED_FRAMES << " paced frames in " << paced_ms.count() << " ms" << std::endl;
+    return 0;
+}
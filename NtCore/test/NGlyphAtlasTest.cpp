@@ -0,0 +1,88 @@
+/**
+ * @file NGlyphAtlasTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <iostream>
+
+#include "NBoxRasterizer.h"
+#include "NGlyphAtlas.h"
+
+int main() {
+    NBoxRasterizer rasterizer(16, 24);
+    // 24x32 padded glyphs in 25x33 cells: five per shelf, three shelves per page.
+    NGlyphAtlas atlas(rasterizer, 128, 2);
+    uint32_t next_texture = 100;
+    atlas.SetTextureProvider([&next_texture](uint32_t /*page*/) {
+        return next_texture++;
+    });
+    NFont font{L"Box", 16.0F};
+
+    auto glyph = atlas.Find(font, U'A');
+    if (!glyph || glyph->region_.width_ != 24 || glyph->region_.height_ != 32 || glyph->texture_ != 100) {
+        return 1;
+    }
+    // Inside the box the field is above the edge value, outside it falls off below.
+    const auto& pixels = atlas.PagePixels(0);
+    auto centre = pixels[(glyph->region_.y_ + 16) * 128 + glyph->region_.x_ + 12];
+    auto corner = pixels[glyph->region_.y_ * 128 + glyph->region_.x_];
+    if (centre <= 128 || corner >= 128) {
+        return 1;
+    }
+    // A new page is dirty in full, so the first upload also defines the zeroed gutter beside the glyph.
+    NAtlasRegion region{};
+    if (!atlas.TakeDirtyRegion(0, region) || region.width_ != 128 || region.height_ != 128 || atlas.TakeDirtyRegion(0, region)) {
+        return 1;
+    }
+    for (uint32_t y = 0; y <= glyph->region_.height_; ++y) {
+        if (pixels[(glyph->region_.y_ + y) * 128 + glyph->region_.x_ + glyph->region_.width_] != 0) {
+            return 1;
+        }
+    }
+    for (uint32_t x = 0; x < glyph->region_.width_; ++x) {
+        if (pixels[(glyph->region_.y_ + glyph->region_.height_) * 128 + glyph->region_.x_ + x] != 0) {
+            return 1;
+        }
+    }
+    // Later glyphs only dirty their own rectangle.
+    auto second = atlas.Find(font, U'B');
+    if (!second || second->region_.x_ != glyph->region_.x_ + glyph->region_.width_ + NGlyphAtlas::GUTTER || !atlas.TakeDirtyRegion(0, region) || region.width_ != 24) {
+        return 1;
+    }
+    // Sizes share one field; faces do not.
+    if (atlas.Find({L"Box", 48.0F}, U'A') != glyph || atlas.Find({L"Box", 16.0F, 700}, U'A') == glyph) {
+        return 1;
+    }
+    if (!atlas.Find(font, U' ')->is_empty_) {
+        return 1;
+    }
+
+    // Fill both pages; glyphs in use this frame can never be evicted.
+    for (char32_t c = U'a'; c < U'a' + 40; ++c) {
+        atlas.Find(font, c);
+    }
+    if (atlas.PageCount() != 2 || atlas.Find(font, U'0') != nullptr) {
+        return 1;
+    }
+    // Next frame only page 1 is touched, so page 0 goes.
+    atlas.BeginFrame();
+    atlas.Touch(1);
+    auto generation = atlas.Generation();
+    auto evicting = atlas.Find(font, U'0');
+    if (!evicting || evicting->page_ != 0 || atlas.Generation() == generation) {
+        return 1;
+    }
+    // The cleared page is uploaded in full again, without the evicted glyphs' fields.
+    if (!atlas.TakeDirtyRegion(0, region) || region.width_ != 128 || atlas.PagePixels(0)[16 * 128 + 37] != 0) {
+        return 1;
+    }
+    // A glyph larger than a page is refused up front, without taking or clearing a page for it.
+    NBoxRasterizer huge_rasterizer(200, 200);
+    NGlyphAtlas huge_atlas(huge_rasterizer, 128, 1);
+    if (huge_atlas.Find(font, U'A') != nullptr || huge_atlas.PageCount() != 0 || huge_atlas.Generation() != 0) {
+        return 1;
+    }
+    std::cout << atlas.GlyphCount() << " glyphs on " << atlas.PageCount() << " pages" << std::endl;
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file NImageLoaderTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "NImageLoader.h"
+
+static void AppendU32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value) {
+    for (size_t i = 0; i < 4; ++i) {
+        bytes[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+static std::vector<uint8_t> MakePpm(uint32_t width, uint32_t height) {
+    auto header = "P6\n# test\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    std::vector<uint8_t> bytes(header.begin(), header.end());
+    for (uint32_t i = 0; i < width * height; ++i) {
+        bytes.push_back(static_cast<uint8_t>(i));
+        bytes.push_back(10);
+        bytes.push_back(20);
+    }
+    return bytes;
+}
+
+static std::vector<uint8_t> MakeDds(uint32_t width, uint32_t height, uint32_t mip_count) {
+    // DX10 header with DXGI_FORMAT_BC7_UNORM_SRGB.
+    std::vector<uint8_t> bytes(148);
+    AppendU32(bytes, 0, 0x20534444);
+    AppendU32(bytes, 4, 124);
+    AppendU32(bytes, 12, height);
+    AppendU32(bytes, 16, width);
+    AppendU32(bytes, 28, mip_count);
+    AppendU32(bytes, 84, 0x30315844);
+    AppendU32(bytes, 128, 99);
+    AppendU32(bytes, 140, 1);
+    for (uint32_t i = 0; i < mip_count; ++i) {
+        bytes.resize(bytes.size() + NImage::LevelSize(NImageFormat::eBC7, (std::max)(width >> i, 1U), (std::max)(height >> i, 1U)), static_cast<uint8_t>(i));
+    }
+    return bytes;
+}
+
+int main() {
+    NImageLoader loader(4);
+
+    // Decodes run concurrently on the workers while the caller keeps going.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<NImage>> futures;
+    for (int i = 0; i < 32; ++i) {
+        futures.push_back(loader.Decode(MakePpm(512, 512)));
+    }
+    for (auto& future : futures) {
+        auto image = future.get();
+        if (image.Width() != 512 || image.levels_[0].data_[4] != 1 || image.levels_[0].data_[7] != 255) {
+            return 1;
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << futures.size() << " images on " << loader.ThreadCount() << " workers in " << elapsed.count() << " ms" << std::endl;
+
+    // Bottom-up 24-bit TGA is flipped to top-down RGBA.
+    std::vector<uint8_t> tga(18);
+    tga[2] = 2;
+    tga[12] = 1;
+    tga[14] = 2;
+    tga[16] = 24;
+    tga.insert(tga.end(), {1, 2, 3, 4, 5, 6});
+    auto flipped = loader.Decode(tga, true).get();
+    if (flipped.Height() != 2 || flipped.levels_[0].data_[0] != 6 || flipped.levels_[0].data_[2] != 4 || flipped.levels_.size() != 2) {
+        return 1;
+    }
+
+    // A pre-built compressed chain keeps all of its levels.
+    auto compressed = loader.Decode(MakeDds(256, 128, 9)).get();
+    if (compressed.format_ != NImageFormat::eBC7 || !compressed.is_srgb_ || !compressed.HasMipChain() || compressed.levels_[8].data_.size() != 16) {
+        return 1;
+    }
+
+    // Added decoders go first; unknown data fails through the future.
+    loader.AddDecoder([](const std::vector<uint8_t>& bytes, NImage& image) {
+        if (bytes.size() != 1) {
+            return false;
+        }
+        image.levels_.push_back({1, 1, {bytes[0], bytes[0], bytes[0], 255}});
+        return true;
+    });
+    if (loader.Decode({42}).get().levels_[0].data_[0] != 42) {
+        return 1;
+    }
+    try {
+        loader.Decode({1, 2, 3}).get();
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+    return 1;
+}
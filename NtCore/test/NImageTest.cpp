@@ -0,0 +1,49 @@
+/**
+ * @file NImageTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <iostream>
+#include <stdexcept>
+
+#include "NImage.h"
+
+int main() {
+    // A 5x3 checker of black and white averages to mid grey one level down, clamping the odd edges.
+    NImage image;
+    NImageLevel base{5, 3, std::vector<uint8_t>(5 * 3 * 4)};
+    for (uint32_t y = 0; y < 3; ++y) {
+        for (uint32_t x = 0; x < 5; ++x) {
+            auto value = static_cast<uint8_t>((x + y) % 2 == 0 ? 255 : 0);
+            for (uint32_t channel = 0; channel < 3; ++channel) {
+                base.data_[(y * 5 + x) * 4 + channel] = value;
+            }
+            base.data_[(y * 5 + x) * 4 + 3] = 255;
+        }
+    }
+    image.levels_.push_back(base);
+    image.GenerateMips();
+    std::cout << image.levels_.size() << " levels, level 1 is " << image.levels_[1].width_ << "x" << image.levels_[1].height_
+              << ", first texel " << static_cast<int>(image.levels_[1].data_[0]) << std::endl;
+    if (!image.HasMipChain() || image.levels_.size() != 3 || image.levels_[1].width_ != 2 || image.levels_[1].height_ != 1) {
+        return 1;
+    }
+    if (image.levels_[1].data_[0] != 128 || image.levels_[1].data_[3] != 255 || image.levels_[2].width_ != 1 || image.levels_[2].height_ != 1) {
+        return 1;
+    }
+
+    // Block-compressed levels round up to whole 4x4 blocks.
+    if (NImage::LevelSize(NImageFormat::eBC1, 5, 3) != 2 * 8 || NImage::LevelSize(NImageFormat::eBC7, 1, 1) != 16 || NImage::MipCount(1024, 1) != 11) {
+        return 1;
+    }
+    NImage compressed;
+    compressed.format_ = NImageFormat::eBC7;
+    compressed.levels_.push_back({4, 4, std::vector<uint8_t>(16)});
+    try {
+        compressed.GenerateMips();
+    } catch (const std::exception&) {
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file NItemTreeTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "NDamageRegion.h"
+#include "NDrawList.h"
+#include "NItemTree.h"
+
+int main() {
+    NItemTree tree;
+    NDamageRegion damage;
+    tree.SetInvalidateCallback([&damage](const NRect& rect) {
+        damage.Add(rect);
+    });
+
+    // Paint order is pre-order: a child added late still paints under a later sibling of its parent.
+    std::vector<NItemID> painted;
+    auto record = [&painted](NItemID id) {
+        return [&painted, id](NDrawList&, const NRect&) {
+            painted.push_back(id);
+        };
+    };
+    auto panel = tree.Add(NItemTree::ROOT, {0.0F, 0.0F, 100.0F, 100.0F});
+    auto overlay = tree.Add(NItemTree::ROOT, {50.0F, 50.0F, 100.0F, 100.0F});
+    auto button = tree.Add(panel, {60.0F, 60.0F, 20.0F, 20.0F});
+    tree.SetDraw(panel, record(panel));
+    tree.SetDraw(overlay, record(overlay));
+    tree.SetDraw(button, record(button));
+    NDrawList list;
+    if (tree.Record(list, {0.0F, 0.0F, 200.0F, 200.0F}) != 3 || painted != std::vector<NItemID>{panel, button, overlay}) {
+        return 1;
+    }
+    if (damage.Bounds().width_ != 150.0F) {
+        return 1;
+    }
+
+    // The overlay covers the button, so it wins the hit test until it is hidden.
+    if (tree.HitTest({70.0F, 70.0F}) != overlay || tree.HitTest({10.0F, 10.0F}) != panel || tree.HitTest({190.0F, 10.0F}) != NItemTree::ROOT) {
+        return 1;
+    }
+    damage.Clear();
+    tree.SetVisible(overlay, false);
+    if (tree.HitTest({70.0F, 70.0F}) != button || damage.Bounds().x_ != 50.0F) {
+        return 1;
+    }
+    // Events bubble from the button to the panel when the button does not handle them.
+    std::vector<NItemID> handled;
+    tree.SetMouseListener(button, [&handled](NItemID item, const NMouseEvent&) {
+        handled.push_back(item);
+        return false;
+    });
+    tree.SetMouseListener(panel, [&handled](NItemID item, const NMouseEvent& event) {
+        handled.push_back(item);
+        return event.type_ == NMouseEventType::ePress;
+    });
+    NMouseEvent press{NMouseEventType::ePress, {70.0F, 70.0F}, NMouseButton::eLeft};
+    if (!tree.DispatchMouseEvent(press) || handled != std::vector<NItemID>{button, panel}) {
+        return 1;
+    }
+    // Hiding a parent hides its subtree; removing it frees the subtree.
+    tree.SetVisible(panel, false);
+    if (tree.HitTest({70.0F, 70.0F}) != NItemTree::ROOT || tree.Index().Size() != 0) {
+        return 1;
+    }
+    tree.SetVisible(panel, true);
+    tree.SetVisible(overlay, true);
+    if (tree.Index().Size() != 3) {
+        return 1;
+    }
+    tree.Remove(panel);
+    if (tree.Size() != 1 || tree.Contains(button) || tree.Index().Size() != 1) {
+        return 1;
+    }
+    tree.Clear();
+
+    // A large diagram: 200k items of which a viewport sees a few thousand.
+    static constexpr uint32_t COLUMNS{500};
+    static constexpr uint32_t ROWS{400};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<NItemID> cells;
+    cells.reserve(COLUMNS * ROWS);
+    for (uint32_t y = 0; y < ROWS; ++y) {
+        for (uint32_t x = 0; x < COLUMNS; ++x) {
+            cells.push_back(tree.Add(NItemTree::ROOT, {x * 30.0F, y * 30.0F, 24.0F, 24.0F}, [](NDrawList& draw_list, const NRect& bounds) {
+                draw_list.DrawRect(bounds, {0.3F, 0.3F, 0.3F, 1.0F});
+            }));
+        }
+    }
+    // The first query also numbers the paint order after the inserts.
+    tree.Record(list, {0.0F, 0.0F, 1.0F, 1.0F});
+    std::chrono::duration<double, std::milli> build = std::chrono::steady_clock::now() - start;
+    list.Clear();
+    start = std::chrono::steady_clock::now();
+    auto drawn = tree.Record(list, {1000.0F, 1000.0F, 1920.0F, 1080.0F});
+    std::chrono::duration<double, std::milli> cull = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    size_t hits = 0;
+    for (int i = 0; i < 10000; ++i) {
+        hits += tree.HitTest({static_cast<float>(i % 1000) * 15.0F + 12.0F, static_cast<float>(i / 1000) * 30.0F + 5.0F}) != NItemTree::ROOT ? 1 : 0;
+    }
+    std::chrono::duration<double, std::micro> hit = std::chrono::steady_clock::now() - start;
+    // Scrolling every item one pixel stays within the fat bounds and never touches the tree.
+    for (auto id : cells) {
+        auto bounds = tree.Bounds(id);
+        bounds.x_ += 1.0F;
+        tree.SetBounds(id, bounds);
+    }
+    std::cout << tree.Size() << " items, height " << tree.Index().Height() << ", built in " << build.count() << " ms, "
+              << drawn << " drawn in " << cull.count() << " ms, " << hit.count() / 10000.0 << " us per hit test" << std::endl;
+    if (tree.Size() != COLUMNS * ROWS || drawn != 65 * 37 || hits != 5000) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file NPathCacheTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "NDrawList.h"
+#include "NPathCache.h"
+
+static float Area(const NPathMesh& mesh) {
+    float area = 0.0F;
+    for (uint32_t i = 0; i + 2 < mesh.fill_vertex_count_; i += 3) {
+        const auto& a = mesh.vertices_[i];
+        const auto& b = mesh.vertices_[i + 1];
+        const auto& c = mesh.vertices_[i + 2];
+        area += std::abs((b.x_ - a.x_) * (c.y_ - a.y_) - (b.y_ - a.y_) * (c.x_ - a.x_)) * 0.5F;
+    }
+    return area;
+}
+
+int main() {
+    NPathCache cache;
+    NDrawList list;
+
+    // An area chart: a concave single contour under a 200-point series.
+    NPath chart;
+    chart.MoveTo({0.0F, 100.0F});
+    for (int i = 0; i < 200; ++i) {
+        chart.LineTo({static_cast<float>(i) * 4.0F, 50.0F + 40.0F * std::sin(static_cast<float>(i) * 0.1F)});
+    }
+    chart.LineTo({796.0F, 100.0F});
+    chart.Close();
+
+    std::chrono::duration<double, std::milli> first{};
+    std::chrono::duration<double, std::milli> cached{};
+    for (int frame = 0; frame < 60; ++frame) {
+        list.Clear();
+        auto start = std::chrono::steady_clock::now();
+        // Panning the chart only changes the translation.
+        auto transform = NTransform::Translation(static_cast<float>(frame), 0.0F);
+        list.DrawPath(cache.Fill(chart, NFillRule::eNonZero, transform), transform, {0.2F, 0.5F, 1.0F, 0.5F});
+        list.DrawPath(cache.Stroke(chart, {2.0F}, transform), transform, {0.2F, 0.5F, 1.0F, 1.0F});
+        list.Finish();
+        (frame == 0 ? first : cached) += std::chrono::steady_clock::now() - start;
+    }
+    std::cout << "first frame " << first.count() << " ms, cached frames " << cached.count() / 59.0 << " ms, "
+              << cache.TessellationCount() << " tessellations" << std::endl;
+    if (cache.TessellationCount() != 2 || list.Batches().size() != 2 || list.Meshes().size() != 2) {
+        return 1;
+    }
+    auto fill = cache.Fill(chart, NFillRule::eNonZero, {});
+    if (fill->is_stencil_ || std::abs(Area(*fill) - 796.0F * 50.0F) > 796.0F * 3.0F) {
+        return 1;
+    }
+    // Zooming in past the scale class re-flattens; rotating does not.
+    cache.Fill(chart, NFillRule::eNonZero, NTransform::Rotation(0.5F));
+    if (cache.TessellationCount() != 2) {
+        return 1;
+    }
+    cache.Fill(chart, NFillRule::eNonZero, NTransform::Scale(3.0F, 3.0F));
+    if (cache.TessellationCount() != 3) {
+        return 1;
+    }
+
+    // A square with a hole goes to the stencil path, with the cover quad after the fans.
+    NPath ring;
+    ring.MoveTo({0.0F, 0.0F});
+    ring.LineTo({10.0F, 0.0F});
+    ring.LineTo({10.0F, 10.0F});
+    ring.LineTo({0.0F, 10.0F});
+    ring.Close();
+    ring.MoveTo({3.0F, 3.0F});
+    ring.LineTo({3.0F, 7.0F});
+    ring.LineTo({7.0F, 7.0F});
+    ring.LineTo({7.0F, 3.0F});
+    ring.Close();
+    auto stencil = cache.Fill(ring, NFillRule::eEvenOdd, {});
+    if (!stencil->is_stencil_ || stencil->fill_vertex_count_ != 12 || stencil->vertices_.size() != 18 || stencil->bounds_.width_ != 10.0F) {
+        return 1;
+    }
+
+    // A bow tie crosses itself.
+    NPath bow_tie;
+    bow_tie.MoveTo({0.0F, 0.0F});
+    bow_tie.LineTo({10.0F, 10.0F});
+    bow_tie.LineTo({10.0F, 0.0F});
+    bow_tie.LineTo({0.0F, 10.0F});
+    bow_tie.Close();
+    if (!cache.Fill(bow_tie, NFillRule::eNonZero, {})->is_stencil_) {
+        return 1;
+    }
+
+    // A quarter circle of radius 100 flattens to within the tolerance.
+    NPath arc;
+    arc.MoveTo({0.0F, 0.0F});
+    arc.LineTo({100.0F, 0.0F});
+    arc.CubicTo({100.0F, 55.228F}, {55.228F, 100.0F}, {0.0F, 100.0F});
+    arc.Close();
+    auto pie = cache.Fill(arc, NFillRule::eNonZero, {});
+    if (pie->is_stencil_ || std::abs(Area(*pie) - 7853.98F) > 40.0F) {
+        return 1;
+    }
+
+    // A 90 degree miter join adds a square corner.
+    NPath corner;
+    corner.MoveTo({0.0F, 0.0F});
+    corner.LineTo({10.0F, 0.0F});
+    corner.LineTo({10.0F, 10.0F});
+    auto stroke = cache.Stroke(corner, {2.0F}, {});
+    if (std::abs(Area(*stroke) - (20.0F + 20.0F + 1.0F)) > 0.01F || stroke->bounds_.Right() != 11.0F) {
+        return 1;
+    }
+    return 0;
+}
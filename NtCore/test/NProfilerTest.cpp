@@ -0,0 +1,116 @@
+/**
+ * @file NProfilerTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "NProfiler.h"
+
+static void Work() {
+    N_PROFILE_ZONE("Work");
+    NProfileZone zone("Inner");
+}
+
+int main() {
+    auto& profiler = NProfiler::Singleton();
+    profiler.SetThreadName("Main");
+
+    // Four threads record concurrently while the main thread keeps collecting.
+    constexpr int ZONES{10000};
+    std::vector<std::thread> threads{};
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&profiler, t]() {
+            profiler.SetThreadName("Worker " + std::to_string(t));
+            for (int i = 0; i < ZONES; ++i) {
+                Work();
+            }
+        });
+    }
+    for (int i = 0; i < 100; ++i) {
+        profiler.Collect();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    profiler.Collect();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+#if defined(NT_PROFILER)
+    constexpr size_t ZONES_PER_WORK{2};
+#else
+    constexpr size_t ZONES_PER_WORK{1};
+#endif
+    const auto& events = profiler.Events();
+    if (events.size() + profiler.DroppedCount() != 4 * ZONES * ZONES_PER_WORK) {
+        return 1;
+    }
+    if (std::any_of(events.begin(), events.end(), [](const NProfileEvent& event) { return event.end_ < event.begin_ || event.is_gpu_ || event.thread_ == 0; })) {
+        return 1;
+    }
+    std::cout << events.size() << " zones from 4 threads in " << elapsed.count() << " ms, " << profiler.DroppedCount() << " dropped" << std::endl;
+
+    // A ring that is never collected drops what no longer fits.
+    profiler.Clear();
+    auto now = NProfiler::Now();
+    for (size_t i = 0; i < NProfiler::RING_SIZE + 100; ++i) {
+        profiler.Record("Flood", now, now + 1);
+    }
+    profiler.Collect();
+    if (profiler.Events().size() != NProfiler::RING_SIZE || profiler.DroppedCount() != 100) {
+        return 1;
+    }
+
+    // GPU zones go to their own timeline; names are escaped.
+    profiler.Clear();
+    profiler.Record("Draw \"quad\"", now, now + 2000, true);
+    profiler.Record("Frame", now, now + 5000);
+    auto trace = profiler.ChromeTrace();
+    if (trace.front() != '{' || trace.back() != '}' || trace.find(R"("name":"Draw \"quad\"","ph":"X","pid":2,"tid":0)") == std::string::npos ||
+        trace.find(R"("args":{"name":"Worker 3"})") == std::string::npos || trace.find(R"("name":"Frame","ph":"X","pid":1)") == std::string::npos ||
+        trace.find(R"("dur":5.000)") == std::string::npos) {
+        return 1;
+    }
+    auto path = std::filesystem::temp_directory_path() / "NProfilerTest.json";
+    profiler.WriteChromeTrace(path);
+    std::ifstream file(path, std::ios::binary);
+    std::string written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::filesystem::remove(path);
+    if (written != trace) {
+        return 1;
+    }
+
+    // Short-lived threads take over the rings of exited ones instead of adding new rings.
+    profiler.Clear();
+    auto ring_count = profiler.RingCount();
+    for (int t = 0; t < 16; ++t) {
+        std::thread([&profiler, now, t]() {
+            profiler.SetThreadName("Recycled " + std::to_string(t));
+            profiler.Record("Recycled", now, now + 1);
+        }).join();
+    }
+    profiler.Collect();
+    if (profiler.RingCount() != ring_count || profiler.Events().size() != 16) {
+        return 1;
+    }
+    // Each of them still shows up as its own named thread.
+    std::set<uint32_t> recycled_threads{};
+    for (const auto& event : profiler.Events()) {
+        recycled_threads.insert(event.thread_);
+    }
+    auto recycled_trace = profiler.ChromeTrace();
+    if (recycled_threads.size() != 16 || recycled_trace.find("\"Recycled 0\"") == std::string::npos || recycled_trace.find("\"Recycled 15\"") == std::string::npos) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file NTaskQueueTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "NTaskQueue.h"
+
+int main() {
+    constexpr size_t PRODUCER_COUNT{4};
+    constexpr size_t TASK_COUNT{100000};
+    NTaskQueue queue;
+    size_t sum = 0;
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+        producers.emplace_back([&queue, &sum] {
+            for (size_t j = 0; j < TASK_COUNT; ++j) {
+                auto value = std::make_unique<size_t>(1);
+                queue.Push([&sum, value = std::move(value)] { sum += *value; });
+            }
+        });
+    }
+    size_t executed = 0;
+    while (executed < PRODUCER_COUNT * TASK_COUNT) {
+        executed += queue.Drain(std::chrono::milliseconds(4));
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    if (sum != PRODUCER_COUNT * TASK_COUNT || !queue.Empty()) {
+        return 1;
+    }
+
+    // Slow tasks stop the drain as soon as the budget is spent.
+    for (int i = 0; i < 20; ++i) {
+        queue.Push([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    }
+    auto slow = queue.Drain(std::chrono::milliseconds(2));
+    if (slow == 0 || slow > 3 || queue.Size() != 20 - slow) {
+        return 1;
+    }
+    std::cout << "executed " << executed << " tasks, sum " << sum << ", " << slow << " slow tasks in a 2 ms budget" << std::endl;
+    while (!queue.Empty()) {
+        queue.Drain(std::chrono::milliseconds(100));
+    }
+    return 0;
+}
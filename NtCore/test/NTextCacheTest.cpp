@@ -0,0 +1,63 @@
+/**
+ * @file NTextCacheTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "NBoxRasterizer.h"
+#include "NTextCache.h"
+
+int main() {
+    NBoxRasterizer rasterizer;
+    NGlyphAtlas atlas(rasterizer);
+    NTextCache cache(rasterizer, atlas, 512);
+    NDrawList list;
+    NFont font{L"Box", 16.0F};
+
+    // A dashboard of 400 labels redrawn for several frames: only the first frame shapes or rasterizes.
+    std::chrono::duration<double, std::milli> elapsed{};
+    for (int frame = 0; frame < 4; ++frame) {
+        atlas.BeginFrame();
+        list.Clear();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 400; ++i) {
+            cache.DrawText(list, L"Sensor " + std::to_wstring(i), font, {static_cast<float>(i % 10) * 120.0F, static_cast<float>(i / 10) * 20.0F + 16.0F}, {1.0F, 1.0F, 1.0F, 1.0F});
+        }
+        list.Finish();
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    std::cout << list.PrimitiveCount() << " glyphs in " << list.Batches().size() << " batches, " << elapsed.count() << " ms per frame, "
+              << cache.ShapeCount() << " runs shaped, " << rasterizer.rasterize_count_ << " glyphs rasterized" << std::endl;
+    if (cache.ShapeCount() != 400 || rasterizer.rasterize_count_ != 17 || list.Batches().size() != 1) {
+        return 1;
+    }
+
+    // Kerning and the size are part of the layout.
+    auto& kerned = cache.Shape(L"AV", font);
+    if (kerned.glyphs_.size() != 2 || kerned.glyphs_[1].x_ != 8.0F - 1.6F) {
+        return 1;
+    }
+    if (cache.Shape(L"AV", {L"Box", 32.0F}).width_ != 32.0F - 3.2F) {
+        return 1;
+    }
+
+    // Least recently used runs are dropped first.
+    NTextCache small(rasterizer, atlas, 2);
+    small.Shape(L"one", font);
+    small.Shape(L"two", font);
+    small.Shape(L"one", font);
+    small.Shape(L"three", font);
+    small.Shape(L"one", font);
+    if (small.ShapeCount() != 3 || small.Size() != 2) {
+        return 1;
+    }
+    small.Shape(L"two", font);
+    if (small.ShapeCount() != 4) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file NVulkanAllocator.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "NVulkanHeader.h"
+
+class NVulkanMemoryBlock;
+
+enum class NVulkanAllocationStrategy {
+    eFreeList,
+    eLinear,
+};
+
+struct NVulkanAllocationCreateInfo {
+    NVulkanAllocationStrategy strategy_{NVulkanAllocationStrategy::eFreeList};
+    bool linear_resource_{true};
+    bool dedicated_{false};
+};
+
+struct NVulkanAllocation {
+    vk::DeviceMemory memory_{};
+    vk::DeviceSize offset_{0};
+    vk::DeviceSize size_{0};
+    uint32_t memory_type_index_{0};
+    void* mapped_{nullptr};
+    NVulkanMemoryBlock* block_{nullptr};
+
+    operator bool() const {
+        return static_cast<bool>(memory_);
+    }
+};
+
+/**
+ * Sub-allocates device memory out of large per memory type blocks, so that a resource
+ * costs a driver allocation only when it is big enough to be given a dedicated one.
+ * Buffers and linear images never share a block with optimal images, which keeps every
+ * block free of bufferImageGranularity conflicts.
+ */
+class BDllExport NVulkanAllocator {
+public:
+    struct HeapStatistics {
+        vk::DeviceSize heap_size_{0};
+        uint32_t block_count_{0};
+        uint32_t dedicated_count_{0};
+        uint32_t allocation_count_{0};
+        vk::DeviceSize reserved_bytes_{0};
+        vk::DeviceSize used_bytes_{0};
+        uint32_t free_range_count_{0};
+        vk::DeviceSize largest_free_range_{0};
+    };
+
+public:
+    NVulkanAllocator(const vk::Device& device, const vk::PhysicalDeviceMemoryProperties& memory_properties);
+    NVulkanAllocator() = delete;
+    ~NVulkanAllocator();
+    NVulkanAllocator(const NVulkanAllocator& allocator) = delete;
+    NVulkanAllocator(NVulkanAllocator&& allocator) = delete;
+    NVulkanAllocator& operator=(const NVulkanAllocator& allocator) = delete;
+    NVulkanAllocator& operator=(NVulkanAllocator&& allocator) = delete;
+
+public:
+    NVulkanAllocation Allocate(const vk::MemoryRequirements& requirements, uint32_t memory_type_index, const NVulkanAllocationCreateInfo& info);
+    void Free(NVulkanAllocation& allocation);
+    std::vector<HeapStatistics> GetHeapStatistics() const;
+
+public:
+    static constexpr vk::DeviceSize LARGE_HEAP_BLOCK_SIZE{256ULL * 1024 * 1024};
+    static constexpr vk::DeviceSize SMALL_HEAP_MAX_SIZE{1024ULL * 1024 * 1024};
+
+private:
+    using PoolKey = std::tuple<uint32_t, NVulkanAllocationStrategy, bool>;
+
+private:
+    vk::DeviceSize PreferredBlockSize(uint32_t memory_type_index) const;
+    NVulkanAllocation AllocateDedicated(vk::DeviceSize size, uint32_t memory_type_index);
+    vk::DeviceMemory AllocateDeviceMemory(vk::DeviceSize size, uint32_t memory_type_index, void*& mapped);
+    bool IsHostVisible(uint32_t memory_type_index) const;
+
+private:
+    vk::Device device_{};
+    vk::PhysicalDeviceMemoryProperties memory_properties_{};
+    std::map<PoolKey, std::vector<std::unique_ptr<NVulkanMemoryBlock>>> pools_{};
+    std::vector<vk::DeviceMemory> dedicated_memories_{};
+    std::vector<uint32_t> dedicated_counts_{};
+    std::vector<vk::DeviceSize> dedicated_bytes_{};
+    mutable std::mutex mutex_{};
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file NVulkanAsyncCompute.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "NVulkanCommandAllocator.h"
+#include "NVulkanDevice.h"
+#include "NVulkanHeader.h"
+#include "NVulkanSwapchain.h"
+
+/**
+ * @brief Records and submits compute work on the async compute family so it overlaps with graphics.
+ * Results are handed to the graphics family through release barriers recorded at Submit and the acquire
+ * barriers from RecordAcquireBarriers. Without an async family the work runs on the graphics queue and
+ * Submit returns an empty sync. Not thread-safe.
+ */
+class BDllExport NVulkanAsyncCompute {
+public:
+    NVulkanAsyncCompute();
+    ~NVulkanAsyncCompute();
+    NVulkanAsyncCompute(const NVulkanAsyncCompute& compute) = delete;
+    NVulkanAsyncCompute(NVulkanAsyncCompute&& compute) = delete;
+    NVulkanAsyncCompute& operator=(const NVulkanAsyncCompute& compute) = delete;
+    NVulkanAsyncCompute& operator=(NVulkanAsyncCompute&& compute) = delete;
+
+public:
+    vk::CommandBuffer Begin();
+    void AddWaitSemaphore(const vk::Semaphore& semaphore, const vk::PipelineStageFlags& wait_stages);
+    void ReleaseBuffer(const vk::Buffer& buffer, vk::DeviceSize offset, vk::DeviceSize size, const vk::AccessFlags& src_access, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access);
+    void ReleaseImage(const vk::Image& image, vk::ImageLayout old_layout, vk::ImageLayout new_layout, const vk::ImageSubresourceRange& range, const vk::AccessFlags& src_access, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access);
+    NVulkanQueueSync Submit();
+    void RecordAcquireBarriers(const vk::CommandBuffer& command_buffer);
+    void WaitIdle();
+    bool HasAsyncQueue() const;
+    uint32_t QueueFamily() const;
+
+public:
+    static constexpr uint32_t BATCH_COUNT{NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT + 1};
+
+private:
+    struct Batch {
+        vk::Fence fence_{};
+        vk::Semaphore semaphore_{};
+        vk::CommandBuffer command_buffer_{};
+        bool is_in_flight_{false};
+    };
+
+private:
+    void Reclaim(Batch& batch);
+
+private:
+    uint32_t graphics_family_{0};
+    uint32_t compute_family_{0};
+    std::unique_ptr<NVulkanCommandAllocator> command_allocator_{};
+    std::array<Batch, BATCH_COUNT> batches_{};
+    size_t current_batch_{0};
+    bool is_recording_{false};
+    std::vector<vk::Semaphore> wait_semaphores_{};
+    std::vector<vk::PipelineStageFlags> wait_stages_{};
+    std::vector<vk::BufferMemoryBarrier> release_buffer_barriers_{};
+    std::vector<vk::ImageMemoryBarrier> release_image_barriers_{};
+    std::vector<vk::BufferMemoryBarrier> acquire_buffer_barriers_{};
+    std::vector<vk::ImageMemoryBarrier> acquire_image_barriers_{};
+    vk::PipelineStageFlags pending_dst_stages_{};
+    vk::PipelineStageFlags acquire_dst_stages_{};
+};
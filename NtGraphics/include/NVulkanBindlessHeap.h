@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file NVulkanBindlessHeap.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "NVulkanHeader.h"
+#include "NVulkanSwapchain.h"
+
+using NVulkanBindlessHandle = uint32_t;
+
+/**
+ * @brief One update-after-bind descriptor set holding every texture, sampler and storage buffer.
+ * Bind it once per command buffer; shaders index the arrays with the handles, so batches never rebind
+ * descriptors. In GLSL: set 0, binding 0 is "texture2D textures[]", binding 1 "sampler samplers[]" and
+ * binding 2 a runtime array of storage buffers, indexed with nonuniformEXT where the index varies.
+ * Handles are stable until released; a released slot is reused only after RETIRE_FRAMES calls to
+ * BeginFrame, when no frame in flight can still read it. Needs NVulkanDevice::HasBindless().
+ */
+class BDllExport NVulkanBindlessHeap {
+public:
+    explicit NVulkanBindlessHeap(uint32_t texture_capacity = DEFAULT_TEXTURE_CAPACITY, uint32_t buffer_capacity = DEFAULT_BUFFER_CAPACITY);
+    ~NVulkanBindlessHeap();
+    NVulkanBindlessHeap(const NVulkanBindlessHeap& heap) = delete;
+    NVulkanBindlessHeap(NVulkanBindlessHeap&& heap) = delete;
+    NVulkanBindlessHeap& operator=(const NVulkanBindlessHeap& heap) = delete;
+    NVulkanBindlessHeap& operator=(NVulkanBindlessHeap&& heap) = delete;
+
+public:
+    NVulkanBindlessHandle AddTexture(const vk::ImageView& image_view, vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal);
+    NVulkanBindlessHandle AddBuffer(const vk::Buffer& buffer, vk::DeviceSize offset = 0, vk::DeviceSize range = VK_WHOLE_SIZE);
+    void ReleaseTexture(NVulkanBindlessHandle texture);
+    void ReleaseBuffer(NVulkanBindlessHandle buffer);
+
+    /**
+     * @brief Returns the slot of an equal sampler, creating it on first use. Samplers live as long as the heap.
+     */
+    NVulkanBindlessHandle GetSampler(const vk::SamplerCreateInfo& info);
+
+    void BeginFrame();
+    void Bind(const vk::CommandBuffer& command_buffer, vk::PipelineBindPoint bind_point, const vk::PipelineLayout& layout, uint32_t set = 0) const;
+    const vk::DescriptorSetLayout& Layout() const;
+    uint32_t TextureCapacity() const;
+    uint32_t BufferCapacity() const;
+    uint32_t TextureCount() const;
+    uint32_t BufferCount() const;
+    uint32_t SamplerCount() const;
+
+public:
+    static constexpr uint32_t TEXTURE_BINDING{0};
+    static constexpr uint32_t SAMPLER_BINDING{1};
+    static constexpr uint32_t BUFFER_BINDING{2};
+    static constexpr uint32_t DEFAULT_TEXTURE_CAPACITY{16384};
+    static constexpr uint32_t DEFAULT_BUFFER_CAPACITY{4096};
+    static constexpr uint32_t SAMPLER_CAPACITY{64};
+    static constexpr uint32_t RETIRE_FRAMES{NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT + 1};
+
+private:
+    struct Slots {
+        uint32_t capacity_{0};
+        uint32_t count_{0};
+        uint32_t next_{0};
+        std::vector<bool> is_used_{};
+        std::vector<uint32_t> free_{};
+        std::deque<std::pair<uint32_t, uint64_t>> retired_{};
+
+        uint32_t Acquire();
+        void Release(uint32_t slot, uint64_t frame);
+        void Reclaim(uint64_t frame);
+    };
+
+private:
+    vk::DescriptorSetLayout layout_{};
+    vk::DescriptorPool pool_{};
+    vk::DescriptorSet set_{};
+    Slots textures_{};
+    Slots buffers_{};
+    std::vector<std::pair<vk::SamplerCreateInfo, vk::Sampler>> samplers_{};
+    uint32_t sampler_capacity_{0};
+    uint64_t frame_{0};
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file NVulkanCommandAllocator.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "NVulkanHeader.h"
+
+/**
+ * @brief Transient command pools, one per recording thread per frame in flight.
+ * Each thread allocates from its own pool without locking. BeginFrame resets every pool of a frame
+ * slot with one vkResetCommandPool and recycles the buffers, so it must only be called once that
+ * slot's fence has signalled and no worker is still recording into it.
+ * Pools are keyed by thread id, so a thread that stops recording for good calls ReleaseThread;
+ * its pools are destroyed as their frame slots come round again.
+ */
+class BDllExport NVulkanCommandAllocator {
+public:
+    NVulkanCommandAllocator(uint32_t queue_family_index, uint32_t frames_in_flight);
+    NVulkanCommandAllocator() = delete;
+    ~NVulkanCommandAllocator();
+    NVulkanCommandAllocator(const NVulkanCommandAllocator& allocator) = delete;
+    NVulkanCommandAllocator(NVulkanCommandAllocator&& allocator) = delete;
+    NVulkanCommandAllocator& operator=(const NVulkanCommandAllocator& allocator) = delete;
+    NVulkanCommandAllocator& operator=(NVulkanCommandAllocator&& allocator) = delete;
+
+public:
+    void BeginFrame(size_t frame_index);
+    vk::CommandBuffer AllocatePrimary();
+    vk::CommandBuffer AllocateSecondary();
+    vk::CommandBuffer BeginSecondary(const vk::CommandBufferInheritanceInfo& inheritance_info);
+
+    /**
+     * @brief Retire the calling thread's pools. Its buffers may still be in flight, so each pool is
+     * destroyed by the BeginFrame that next reuses its slot.
+     */
+    void ReleaseThread();
+    uint32_t FramesInFlight() const;
+    size_t ThreadCount() const;
+    size_t RetiredCount() const;
+
+private:
+    struct FramePool {
+        vk::CommandPool command_pool_{};
+        std::vector<vk::CommandBuffer> primary_command_buffers_{};
+        std::vector<vk::CommandBuffer> secondary_command_buffers_{};
+        size_t primary_used_{0};
+        size_t secondary_used_{0};
+    };
+
+    struct ThreadPools {
+        std::vector<FramePool> frame_pools_{};
+    };
+
+private:
+    FramePool& CurrentPool();
+    vk::CommandBuffer Allocate(FramePool& pool, vk::CommandBufferLevel level);
+    void DestroyRetired(size_t frame_index);
+
+private:
+    uint32_t queue_family_index_{0};
+    uint32_t frames_in_flight_{0};
+    size_t current_frame_{0};
+    mutable std::shared_mutex mutex_{};
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadPools>> thread_pools_{};
+    std::vector<std::unique_ptr<ThreadPools>> retired_pools_{};
+};
@@ -6,10 +6,40 @@
  * @date 2023-06-01
  */
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include "NVulkanAllocator.h"
 #include "NVulkanHeader.h"
 
+/**
+ * @brief What a submission on another queue has to wait on before using the results of a cross-queue submission.
+ * semaphore_ is null when the work went through the graphics queue and submission order is enough.
+ */
+struct NVulkanQueueSync {
+    vk::Semaphore semaphore_{};
+    vk::PipelineStageFlags wait_stages_{};
+
+    operator bool() const {
+        return static_cast<bool>(semaphore_);
+    }
+};
+
+struct NVulkanHeapBudget {
+    vk::DeviceSize heap_size_{0};
+    vk::DeviceSize budget_{0};
+    vk::DeviceSize usage_{0};
+    vk::DeviceSize allocated_{0};
+    bool is_device_local_{false};
+};
+
+/**
+ * @brief The logical device and its queues.
+ * Submit, Present and WaitIdle may be called from any thread. Each distinct VkQueue has its own lock,
+ * shared when families alias, and WaitIdle takes all of them.
+ */
 class BDllExport NVulkanDevice {
 public:
     static NVulkanDevice& Singleton() {
@@ -22,35 +52,100 @@ private:
 
 public:
     ~NVulkanDevice() = default;
-    NVulkanDevice(const NVulkanDevice& device) = default;
+    NVulkanDevice(const NVulkanDevice& device) = delete;
     NVulkanDevice(NVulkanDevice&& device) = delete;
-    NVulkanDevice& operator=(const NVulkanDevice& device) = default;
+    NVulkanDevice& operator=(const NVulkanDevice& device) = delete;
     NVulkanDevice& operator=(NVulkanDevice&& device) = delete;
 
 public:
     vk::SwapchainKHR CreateSwapchain(const vk::SwapchainCreateInfoKHR& info);
+    void DestroySwapchain(const vk::SwapchainKHR& swapchain);
     std::vector<vk::Image> GetSwapchainImages(const vk::SwapchainKHR& swapchain);
-    vk::ImageView CreateImageView(const vk::Image& image, const vk::Format& format, vk::ImageAspectFlagBits flag);
+    vk::ImageView CreateImageView(const vk::Image& image, const vk::Format& format, const vk::ImageAspectFlags& aspect);
+    vk::ImageView CreateImageView(const vk::ImageViewCreateInfo& info);
+    void DestroyImageView(const vk::ImageView& image_view);
     vk::Format FindSupportFormat(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling, const vk::FormatFeatureFlags& features) const;
     vk::RenderPass CreateRenderPass(const vk::RenderPassCreateInfo& info);
-    void CreateImage(uint32_t width, uint32_t height, vk::Format format, vk::ImageTiling tiling, const vk::ImageUsageFlags& usage, const vk::MemoryPropertyFlags& properties, vk::Image& image, vk::DeviceMemory& memory);
+    void DestroyRenderPass(const vk::RenderPass& render_pass);
+    /**
+     * @brief Backs the image with memory that has all of properties, and also preferred_properties when a type the image allows has them.
+     */
+    void CreateImage(uint32_t width, uint32_t height, vk::Format format, vk::ImageTiling tiling, const vk::ImageUsageFlags& usage, const vk::MemoryPropertyFlags& properties, vk::Image& image, NVulkanAllocation& allocation, const vk::MemoryPropertyFlags& preferred_properties = {});
+    void CreateImage(const vk::ImageCreateInfo& info, const vk::MemoryPropertyFlags& properties, vk::Image& image, NVulkanAllocation& allocation, const vk::MemoryPropertyFlags& preferred_properties = {});
+    void DestroyImage(vk::Image& image, NVulkanAllocation& allocation);
+    void CreateBuffer(vk::DeviceSize size, const vk::BufferUsageFlags& usage, const vk::MemoryPropertyFlags& properties, vk::Buffer& buffer, NVulkanAllocation& allocation, NVulkanAllocationStrategy strategy = NVulkanAllocationStrategy::eFreeList, const vk::MemoryPropertyFlags& preferred_properties = {});
+    void DestroyBuffer(vk::Buffer& buffer, NVulkanAllocation& allocation);
+    std::vector<NVulkanAllocator::HeapStatistics> GetHeapStatistics() const;
+    std::vector<NVulkanHeapBudget> GetHeapBudgets() const;
     vk::Framebuffer CreateFramebuffer(const vk::FramebufferCreateInfo& info);
+    void DestroyFramebuffer(const vk::Framebuffer& framebuffer);
     vk::Semaphore CreateSemaphore(const vk::SemaphoreCreateInfo& info);
     vk::Fence CreateFence(const vk::FenceCreateInfo& info);
+    void DestroySemaphore(const vk::Semaphore& semaphore);
+    void DestroyFence(const vk::Fence& fence);
+    void WaitForFences(const std::vector<vk::Fence>& fences) const;
+    void ResetFence(const vk::Fence& fence);
+    vk::Result AcquireNextImage(const vk::SwapchainKHR& swapchain, const vk::Semaphore& semaphore, uint32_t& image_index);
+    void SubmitGraphics(const vk::SubmitInfo& info, const vk::Fence& fence);
+    void SubmitTransfer(const vk::SubmitInfo& info, const vk::Fence& fence);
+    void SubmitCompute(const vk::SubmitInfo& info, const vk::Fence& fence);
+    bool IsFenceSignaled(const vk::Fence& fence) const;
+    vk::Result Present(const vk::PresentInfoKHR& info);
     void WaitIdle() const;
     const vk::CommandPool& CommandPool() const;
+    vk::CommandPool CreateCommandPool(const vk::CommandPoolCreateInfo& info);
+    void ResetCommandPool(const vk::CommandPool& command_pool);
+    void DestroyCommandPool(const vk::CommandPool& command_pool);
     std::vector<vk::CommandBuffer> AllocateCommandBuffers(const vk::CommandBufferAllocateInfo& info);
+    void FreeCommandBuffers(const std::vector<vk::CommandBuffer>& command_buffers);
+    vk::DescriptorSetLayout CreateDescriptorSetLayout(const vk::DescriptorSetLayoutCreateInfo& info);
+    void DestroyDescriptorSetLayout(const vk::DescriptorSetLayout& layout);
+    vk::DescriptorPool CreateDescriptorPool(const vk::DescriptorPoolCreateInfo& info);
+    void DestroyDescriptorPool(const vk::DescriptorPool& pool);
+    std::vector<vk::DescriptorSet> AllocateDescriptorSets(const vk::DescriptorSetAllocateInfo& info);
+    void FreeDescriptorSets(const vk::DescriptorPool& pool, const std::vector<vk::DescriptorSet>& descriptor_sets);
+    void UpdateDescriptorSets(const std::vector<vk::WriteDescriptorSet>& writes);
+    vk::Sampler CreateSampler(const vk::SamplerCreateInfo& info);
+    void DestroySampler(const vk::Sampler& sampler);
+    vk::QueryPool CreateQueryPool(const vk::QueryPoolCreateInfo& info);
+    void DestroyQueryPool(const vk::QueryPool& pool);
+    bool GetQueryPoolResults(const vk::QueryPool& pool, uint32_t first, uint32_t count, std::vector<uint64_t>& results) const;
+    vk::ShaderModule CreateShaderModule(const vk::ShaderModuleCreateInfo& info);
+    void DestroyShaderModule(const vk::ShaderModule& module);
+    vk::PipelineLayout CreatePipelineLayout(const vk::PipelineLayoutCreateInfo& info);
+    void DestroyPipelineLayout(const vk::PipelineLayout& layout);
+    vk::Pipeline CreateGraphicsPipeline(const vk::PipelineCache& cache, const vk::GraphicsPipelineCreateInfo& info);
+    vk::Pipeline CreateComputePipeline(const vk::PipelineCache& cache, const vk::ComputePipelineCreateInfo& info);
+    void DestroyPipeline(const vk::Pipeline& pipeline);
+    vk::PipelineCache CreatePipelineCache(const vk::PipelineCacheCreateInfo& info);
+    void MergePipelineCaches(const vk::PipelineCache& destination, const vk::PipelineCache& source);
+    void DestroyPipelineCache(const vk::PipelineCache& cache);
+    std::vector<uint8_t> GetPipelineCacheData(const vk::PipelineCache& cache) const;
+    bool HasBindless() const;
 
 private:
     void CreateDevice();
     void CreateCommandPool();
+    void CreateAllocator();
+
+private:
+    static constexpr size_t QUEUE_COUNT{4};
 
 private:
-    uint32_t FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties);
+    uint32_t FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties, vk::MemoryPropertyFlags preferred_properties);
 
 private:
     vk::Device device_{};
     vk::Queue graphics_queue_{};
     vk::Queue present_queue_{};
+    vk::Queue transfer_queue_{};
+    vk::Queue compute_queue_{};
+    mutable std::array<std::mutex, QUEUE_COUNT> queue_mutexes_{};
+    size_t graphics_lock_{0};
+    size_t present_lock_{0};
+    size_t transfer_lock_{0};
+    size_t compute_lock_{0};
     vk::CommandPool command_pool_{};
+    std::shared_ptr<NVulkanAllocator> allocator_{};
+    bool has_bindless_{false};
 };
\ No newline at end of file
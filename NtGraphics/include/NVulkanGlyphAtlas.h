@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file NVulkanGlyphAtlas.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <vector>
+
+#include "NGlyphAtlas.h"
+#include "NVulkanAllocator.h"
+#include "NVulkanHeader.h"
+#include "NVulkanPrimitiveRenderer.h"
+
+/**
+ * @brief GPU pages for an NGlyphAtlas, registered as textures of an NVulkanPrimitiveRenderer.
+ * Update copies the regions the atlas changed since the last call on the graphics queue, through
+ * the frame slot's own staging buffer; record it after NVulkanRender::BeginFrame and before the
+ * render pass that draws the text. frame_index is the swapchain frame slot; slots are added when it
+ * grows past the count given at construction.
+ */
+class BDllExport NVulkanGlyphAtlas {
+public:
+    NVulkanGlyphAtlas(NGlyphAtlas& atlas, NVulkanPrimitiveRenderer& renderer, uint32_t frames_in_flight);
+    NVulkanGlyphAtlas() = delete;
+    ~NVulkanGlyphAtlas();
+    NVulkanGlyphAtlas(const NVulkanGlyphAtlas& atlas) = delete;
+    NVulkanGlyphAtlas(NVulkanGlyphAtlas&& atlas) = delete;
+    NVulkanGlyphAtlas& operator=(const NVulkanGlyphAtlas& atlas) = delete;
+    NVulkanGlyphAtlas& operator=(NVulkanGlyphAtlas&& atlas) = delete;
+
+public:
+    void Update(const vk::CommandBuffer& command_buffer, size_t frame_index);
+    vk::DeviceSize UploadedBytes() const;
+
+public:
+    static constexpr vk::Format FORMAT{vk::Format::eR8Unorm};
+
+private:
+    struct Page {
+        vk::Image image_{};
+        NVulkanAllocation allocation_{};
+        vk::ImageView image_view_{};
+        NTextureID texture_{0};
+        bool is_initialized_{false};
+    };
+
+    struct FrameResources {
+        vk::Buffer buffer_{};
+        NVulkanAllocation allocation_{};
+        vk::DeviceSize capacity_{0};
+    };
+
+    struct Upload {
+        uint32_t page_{0};
+        NAtlasRegion region_{};
+        vk::DeviceSize offset_{0};
+    };
+
+private:
+    NTextureID CreatePage(uint32_t page);
+    void EnsureCapacity(FrameResources& frame, vk::DeviceSize size);
+
+private:
+    NGlyphAtlas& atlas_;
+    NVulkanPrimitiveRenderer& renderer_;
+    vk::Sampler sampler_{};
+    std::vector<Page> pages_{};
+    std::vector<FrameResources> frames_{};
+    std::vector<Upload> uploads_{};
+    vk::DeviceSize uploaded_bytes_{0};
+};
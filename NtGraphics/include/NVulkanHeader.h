@@ -22,6 +22,12 @@
 #define VK_USE_PLATFORM_WIN32_KHR
 #endif  // VK_USE_PLATFORM_WIN32_KHR
 
+#else
+
+#if !defined(BDllExport)
+#define BDllExport __attribute__((visibility("default")))
+#endif
+
 #endif
 
 #include "vulkan/vulkan.hpp"
\ No newline at end of file
@@ -32,15 +32,21 @@ public:
 #if defined(_WIN32)
     vk::SurfaceKHR CreateSurface(const vk::Win32SurfaceCreateInfoKHR& info);
 #endif
+    vk::SurfaceKHR CreateHeadlessSurface();
+    void DestroySurface(const vk::SurfaceKHR& surface);
+    bool IsExtensionEnabled(const char* name) const;
+    PFN_vkVoidFunction GetProcAddr(const char* name) const;
 
 private:
     void CheckValidationLayerSupport() const;
     void CheckExtensionsSupport() const;
     std::vector<const char*> GetRequiredExtensions() const;
+    std::vector<const char*> GetOptionalExtensions() const;
     static void PopulateDebugMessengerCreateInfo(vk::DebugUtilsMessengerCreateInfoEXT& create_info);
 
 private:
     vk::Instance instance_{};
+    std::vector<const char*> enabled_extensions_{};
 
 private:
 #if defined(NOT_DEBUG)
@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * @file NVulkanMultiRender.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "NVulkanCommandAllocator.h"
+#include "NVulkanHeader.h"
+#include "NVulkanSwapchain.h"
+
+/**
+ * @brief Renders many canvases against the shared device.
+ * Every due canvas is recorded into one command buffer, submitted once and presented with a single
+ * vkQueuePresentKHR. Canvases with a refresh rate only take part once their own interval has elapsed.
+ */
+class BDllExport NVulkanMultiRender {
+public:
+    using CanvasID = uint32_t;
+    using RecordCallback = std::function<void(CanvasID canvas_id, const vk::CommandBuffer& command_buffer, const vk::Extent2D& extent)>;
+
+public:
+    explicit NVulkanMultiRender(uint32_t frames_in_flight = NVulkanSwapchain::DEFAULT_FRAMES_IN_FLIGHT);
+    ~NVulkanMultiRender();
+    NVulkanMultiRender(const NVulkanMultiRender& render) = delete;
+    NVulkanMultiRender(NVulkanMultiRender&& render) = delete;
+    NVulkanMultiRender& operator=(const NVulkanMultiRender& render) = delete;
+    NVulkanMultiRender& operator=(NVulkanMultiRender&& render) = delete;
+
+public:
+#if defined(_WIN32)
+    CanvasID AddCanvas(HWND hwnd, uint32_t width, uint32_t height, uint32_t refresh_rate = 0);
+#endif
+    CanvasID AddCanvas(NVulkanSwapchain::Backend backend, uint32_t width, uint32_t height, uint32_t refresh_rate = 0);
+    void RemoveCanvas(CanvasID canvas_id);
+    void ResizeCanvas(CanvasID canvas_id, uint32_t width, uint32_t height);
+    void SetRefreshRate(CanvasID canvas_id, uint32_t refresh_rate);
+    size_t CanvasCount() const;
+    const NVulkanSwapchain& Swapchain(CanvasID canvas_id) const;
+    uint32_t FramesInFlight() const;
+    std::chrono::steady_clock::time_point NextDeadline() const;
+    size_t RenderFrame(const RecordCallback& record);
+
+private:
+    struct Canvas {
+        std::unique_ptr<NVulkanSwapchain> swapchain_{};
+        vk::Extent2D extent_{};
+        bool is_resized_{false};
+        std::chrono::steady_clock::duration interval_{};
+        std::chrono::steady_clock::time_point next_present_time_{};
+        std::vector<vk::Semaphore> image_available_semaphores_{};
+        std::vector<vk::Semaphore> render_finished_semaphores_{};
+        uint32_t image_index_{0};
+    };
+
+private:
+    CanvasID InsertCanvas(std::unique_ptr<NVulkanSwapchain> swapchain, uint32_t width, uint32_t height, uint32_t refresh_rate);
+    bool IsDue(const Canvas& canvas, std::chrono::steady_clock::time_point now) const;
+    void BeginRenderPass(const vk::CommandBuffer& command_buffer, const Canvas& canvas) const;
+    static std::chrono::steady_clock::duration Interval(uint32_t refresh_rate);
+    static void DestroyCanvas(Canvas& canvas);
+
+private:
+    uint32_t frames_in_flight_{NVulkanSwapchain::DEFAULT_FRAMES_IN_FLIGHT};
+    size_t current_frame_{0};
+    uint64_t submissions_{0};
+    CanvasID next_canvas_id_{1};
+    std::map<CanvasID, Canvas> canvases_{};
+    std::unique_ptr<NVulkanCommandAllocator> command_allocator_{};
+    std::vector<vk::Fence> in_flight_fences_{};
+};
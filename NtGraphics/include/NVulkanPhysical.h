@@ -15,13 +15,32 @@ public:
     struct QueueFamilyIndices {
         uint32_t graphics_family_;
         uint32_t present_family_;
+        uint32_t transfer_family_;
+        uint32_t compute_family_;
+        uint32_t compute_queue_index_ = 0;
 
         bool has_graphics_family_ = false;
         bool has_present_family_ = false;
 
-        operator bool() {
+        operator bool() const {
             return has_graphics_family_ && has_present_family_;
         }
+
+        bool HasAsyncCompute() const {
+            return compute_family_ != graphics_family_;
+        }
+    };
+
+    struct Capabilities {
+        vk::PhysicalDeviceProperties properties_;
+        vk::PhysicalDeviceFeatures features_;
+        vk::PhysicalDeviceMemoryProperties memory_properties_;
+        std::vector<vk::QueueFamilyProperties> queue_family_properties_;
+        QueueFamilyIndices queue_families_;
+        std::vector<vk::FormatProperties> format_properties_;
+        std::vector<vk::ExtensionProperties> extensions_;
+        vk::PhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features_;
+        vk::PhysicalDeviceDescriptorIndexingPropertiesEXT descriptor_indexing_properties_;
     };
 
     struct SwapchainSupportDetails {
@@ -47,24 +66,33 @@ public:
     NVulkanPhysical& operator=(NVulkanPhysical&& physical) = delete;
 
 public:
-    QueueFamilyIndices QueueFamilies() const;
+    const Capabilities& GetCapabilities() const;
+    const QueueFamilyIndices& QueueFamilies() const;
     const std::vector<const char*>& DeviceExtensions() const;
+    bool HasExtension(const char* name) const;
     vk::Device CreateDevice(const vk::DeviceCreateInfo& info);
     SwapchainSupportDetails QuerySwapchainSupport(const vk::SurfaceKHR& surface);
-    vk::FormatProperties GetFormatProperties(const vk::Format& format);
-    vk::PhysicalDeviceMemoryProperties GetMemoryProperties();
+    vk::FormatProperties GetFormatProperties(const vk::Format& format) const;
+    bool IsFormatSupported(const vk::Format& format, vk::ImageTiling tiling, const vk::FormatFeatureFlags& features) const;
+    const vk::PhysicalDeviceMemoryProperties& GetMemoryProperties() const;
+    bool QueryMemoryBudget(vk::PhysicalDeviceMemoryBudgetPropertiesEXT& budget) const;
+    bool HasBindlessSupport() const;
 
 private:
     bool IsPhysicalDeviceSuitable(const vk::PhysicalDevice& device) const;
-    QueueFamilyIndices FindQueueFamilies(const vk::PhysicalDevice& device) const;
+    QueueFamilyIndices FindQueueFamilies(const vk::PhysicalDevice& device, const std::vector<vk::QueueFamilyProperties>& properties) const;
+    void CreateCapabilities();
+    void QueryDescriptorIndexing();
+
+private:
+    static constexpr uint32_t CORE_FORMAT_COUNT{VK_FORMAT_ASTC_12x12_SRGB_BLOCK + 1};
 
 private:
     vk::PhysicalDevice physical_{};
+    Capabilities capabilities_{};
+    PFN_vkGetPhysicalDeviceMemoryProperties2KHR get_memory_properties2_{};
 
 private:
-#if defined(_WIN32)
     std::vector<const char*> device_extensions_ = {"VK_KHR_swapchain"};
-#else
-    std::vector<const char*> device_extensions_ = {"VK_KHR_portability_subset", "VK_KHR_swapchain"};
-#endif
+    std::vector<const char*> optional_device_extensions_ = {"VK_KHR_portability_subset", "VK_EXT_memory_budget", "VK_KHR_incremental_present", "VK_KHR_maintenance3", "VK_EXT_descriptor_indexing"};
 };
\ No newline at end of file
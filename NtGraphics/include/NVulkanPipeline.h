@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file NVulkanPipeline.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <string>
+#include <vector>
+
+#include "NVulkanHeader.h"
+
+struct NVulkanShaderStage {
+    vk::ShaderStageFlagBits stage_{vk::ShaderStageFlagBits::eVertex};
+    std::vector<uint32_t> code_{};
+    std::string entry_{"main"};
+
+    bool operator==(const NVulkanShaderStage& stage) const = default;
+};
+
+struct NVulkanPipelineState {
+    std::vector<NVulkanShaderStage> stages_{};
+    std::vector<vk::VertexInputBindingDescription> vertex_bindings_{};
+    std::vector<vk::VertexInputAttributeDescription> vertex_attributes_{};
+    vk::PrimitiveTopology topology_{vk::PrimitiveTopology::eTriangleList};
+    vk::PolygonMode polygon_mode_{vk::PolygonMode::eFill};
+    vk::CullModeFlags cull_mode_{vk::CullModeFlagBits::eNone};
+    vk::FrontFace front_face_{vk::FrontFace::eClockwise};
+    bool depth_test_{true};
+    bool depth_write_{true};
+    vk::CompareOp depth_compare_op_{vk::CompareOp::eLess};
+    bool stencil_test_{false};
+    vk::StencilOpState stencil_front_{};
+    vk::StencilOpState stencil_back_{};
+    bool blend_{false};
+    vk::ColorComponentFlags color_write_mask_{vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA};
+    std::vector<vk::DescriptorSetLayout> descriptor_set_layouts_{};
+    std::vector<vk::PushConstantRange> push_constant_ranges_{};
+    vk::RenderPass render_pass_{};
+    uint32_t subpass_{0};
+
+    size_t Hash() const;
+    bool operator==(const NVulkanPipelineState& state) const = default;
+};
+
+struct NVulkanComputePipelineState {
+    NVulkanShaderStage stage_{vk::ShaderStageFlagBits::eCompute};
+    std::vector<vk::DescriptorSetLayout> descriptor_set_layouts_{};
+    std::vector<vk::PushConstantRange> push_constant_ranges_{};
+
+    size_t Hash() const;
+    bool operator==(const NVulkanComputePipelineState& state) const = default;
+};
+
+class BDllExport NVulkanPipeline {
+public:
+    NVulkanPipeline(const vk::Pipeline& pipeline, const vk::PipelineLayout& layout, vk::PipelineBindPoint bind_point);
+    NVulkanPipeline() = delete;
+    ~NVulkanPipeline();
+    NVulkanPipeline(const NVulkanPipeline& pipeline) = delete;
+    NVulkanPipeline(NVulkanPipeline&& pipeline) = delete;
+    NVulkanPipeline& operator=(const NVulkanPipeline& pipeline) = delete;
+    NVulkanPipeline& operator=(NVulkanPipeline&& pipeline) = delete;
+
+public:
+    const vk::Pipeline& Pipeline() const;
+    const vk::PipelineLayout& Layout() const;
+    void Bind(const vk::CommandBuffer& command_buffer) const;
+
+private:
+    vk::Pipeline pipeline_{};
+    vk::PipelineLayout layout_{};
+    vk::PipelineBindPoint bind_point_{vk::PipelineBindPoint::eGraphics};
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * @file NVulkanPipelineManager.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "NVulkanHeader.h"
+#include "NVulkanPipeline.h"
+
+class BDllExport NVulkanPipelineManager {
+public:
+    static NVulkanPipelineManager& Singleton() {
+        static NVulkanPipelineManager manager;
+        return manager;
+    }
+
+private:
+    NVulkanPipelineManager();
+
+public:
+    ~NVulkanPipelineManager();
+    NVulkanPipelineManager(const NVulkanPipelineManager& manager) = delete;
+    NVulkanPipelineManager(NVulkanPipelineManager&& manager) = delete;
+    NVulkanPipelineManager& operator=(const NVulkanPipelineManager& manager) = delete;
+    NVulkanPipelineManager& operator=(NVulkanPipelineManager&& manager) = delete;
+
+public:
+    std::shared_ptr<NVulkanPipeline> CreateGraphicsPipeline(const NVulkanPipelineState& state);
+    std::shared_ptr<NVulkanPipeline> CreateComputePipeline(const NVulkanComputePipelineState& state);
+    void SetCacheDirectory(const std::filesystem::path& directory);
+    void SaveCache();
+
+    /**
+     * @brief Merges the cache file of the current directory into the pipeline cache.
+     * Returns false when there is no file, or when it was written by another device or driver.
+     */
+    bool LoadCache();
+    static std::vector<uint32_t> LoadShader(const std::filesystem::path& path);
+
+private:
+    struct CacheHeader {
+        uint64_t data_size_;
+        uint32_t magic_;
+        uint32_t version_;
+        uint32_t vendor_id_;
+        uint32_t device_id_;
+        uint32_t driver_version_;
+        uint8_t uuid_[VK_UUID_SIZE];
+        uint32_t reserved_;
+    };
+
+private:
+    std::filesystem::path CachePath() const;
+    vk::PipelineLayout GetPipelineLayout(const std::vector<vk::DescriptorSetLayout>& set_layouts, const std::vector<vk::PushConstantRange>& push_constant_ranges);
+    CacheHeader MakeCacheHeader(uint64_t data_size) const;
+
+private:
+    static constexpr uint32_t CACHE_MAGIC{0x4350544E};
+    static constexpr uint32_t CACHE_VERSION{1};
+
+private:
+    std::filesystem::path cache_directory_{};
+    vk::PipelineCache pipeline_cache_{};
+    std::unordered_map<size_t, std::vector<std::pair<NVulkanPipelineState, std::shared_ptr<NVulkanPipeline>>>> pipelines_{};
+    std::unordered_map<size_t, std::vector<std::pair<NVulkanComputePipelineState, std::shared_ptr<NVulkanPipeline>>>> compute_pipelines_{};
+    std::vector<std::pair<std::pair<std::vector<vk::DescriptorSetLayout>, std::vector<vk::PushConstantRange>>, vk::PipelineLayout>> layouts_{};
+    bool is_cache_dirty_{false};
+    std::mutex mutex_{};
+};
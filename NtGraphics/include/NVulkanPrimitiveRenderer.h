@@ -0,0 +1,114 @@
+#pragma once
+
+/**
+ * @file NVulkanPrimitiveRenderer.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "NDrawList.h"
+#include "NVulkanAllocator.h"
+#include "NVulkanHeader.h"
+#include "NVulkanPipeline.h"
+#include "NVulkanSwapchain.h"
+
+/**
+ * @brief Draws an NDrawList with one instanced draw per batch.
+ * Every primitive is one instance of a four-vertex strip; instance data for a frame is written into
+ * that frame slot's persistently mapped buffer, so Prepare must be called after the slot's fence has
+ * signalled, i.e. after NVulkanRender::BeginFrame. Path meshes referenced by the list are copied into a
+ * second per-frame buffer; stencil meshes need a render pass whose depth attachment has a stencil aspect.
+ * frame_index is the swapchain frame slot; slots are added when it grows past the count given at construction.
+ */
+class BDllExport NVulkanPrimitiveRenderer {
+public:
+    NVulkanPrimitiveRenderer(const vk::RenderPass& render_pass, uint32_t frames_in_flight);
+    NVulkanPrimitiveRenderer() = delete;
+    ~NVulkanPrimitiveRenderer();
+    NVulkanPrimitiveRenderer(const NVulkanPrimitiveRenderer& renderer) = delete;
+    NVulkanPrimitiveRenderer(NVulkanPrimitiveRenderer&& renderer) = delete;
+    NVulkanPrimitiveRenderer& operator=(const NVulkanPrimitiveRenderer& renderer) = delete;
+    NVulkanPrimitiveRenderer& operator=(NVulkanPrimitiveRenderer&& renderer) = delete;
+
+public:
+    NTextureID RegisterTexture(const vk::ImageView& image_view, const vk::Sampler& sampler);
+
+    /**
+     * @brief Stops drawing the texture; its descriptor set is freed once the frames in flight are done with it.
+     * The image view must stay alive until then as well.
+     */
+    void UnregisterTexture(NTextureID texture);
+    void Prepare(NDrawList& draw_list, size_t frame_index);
+    void Draw(const vk::CommandBuffer& command_buffer, const vk::Extent2D& extent) const;
+
+    /**
+     * @brief Draw only the batches whose bounds reach into scissor, for one rect of NVulkanRender::RecordRepaint.
+     */
+    void Draw(const vk::CommandBuffer& command_buffer, const vk::Extent2D& extent, const vk::Rect2D& scissor) const;
+
+    /**
+     * @brief Draws recorded since the last Prepare, after culling, summed over every Draw call.
+     */
+    size_t DrawCallCount() const;
+
+public:
+    static constexpr uint32_t MAX_TEXTURES{1024};
+    static constexpr vk::DeviceSize MIN_INSTANCE_CAPACITY{4096};
+    static constexpr uint32_t RETIRE_FRAMES{NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT + 1};
+
+private:
+    struct PushConstants {
+        float scale_[2];
+        float translate_[2];
+    };
+
+    struct FrameResources {
+        vk::Buffer buffer_{};
+        NVulkanAllocation allocation_{};
+        vk::DeviceSize capacity_{0};
+        vk::Buffer mesh_buffer_{};
+        NVulkanAllocation mesh_allocation_{};
+        vk::DeviceSize mesh_capacity_{0};
+    };
+
+    struct Retired {
+        vk::DescriptorSet descriptor_set_{};
+        uint64_t frame_{0};
+    };
+
+    struct MeshRange {
+        uint32_t first_vertex_{0};
+        uint32_t fill_vertex_count_{0};
+        NFillRule fill_rule_{NFillRule::eNonZero};
+    };
+
+private:
+    void CreateDescriptors();
+    void CreatePipelines(const vk::RenderPass& render_pass);
+    void EnsureCapacity(vk::Buffer& buffer, NVulkanAllocation& allocation, vk::DeviceSize& capacity, vk::DeviceSize count, vk::DeviceSize stride);
+
+private:
+    vk::DescriptorSetLayout descriptor_set_layout_{};
+    vk::DescriptorPool descriptor_pool_{};
+    std::unordered_map<NTextureID, vk::DescriptorSet> textures_{};
+    std::vector<Retired> retired_{};
+    NTextureID next_texture_id_{1};
+    uint64_t frame_{0};
+    std::shared_ptr<NVulkanPipeline> shape_pipeline_{};
+    std::shared_ptr<NVulkanPipeline> image_pipeline_{};
+    std::shared_ptr<NVulkanPipeline> text_pipeline_{};
+    std::shared_ptr<NVulkanPipeline> path_pipeline_{};
+    std::shared_ptr<NVulkanPipeline> stencil_non_zero_pipeline_{};
+    std::shared_ptr<NVulkanPipeline> stencil_even_odd_pipeline_{};
+    std::shared_ptr<NVulkanPipeline> cover_pipeline_{};
+    std::vector<FrameResources> frames_{};
+    size_t current_frame_{0};
+    std::vector<NDrawBatch> batches_{};
+    std::vector<MeshRange> meshes_{};
+    mutable size_t draw_call_count_{0};
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+/**
+ * @file NVulkanProfiler.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "NProfiler.h"
+#include "NVulkanHeader.h"
+#include "NVulkanSwapchain.h"
+
+/**
+ * @brief Times command buffer ranges with timestamp queries and records them as GPU zones in NProfiler.
+ * Each frame in flight has its own query pool. BeginFrame must be called outside a render pass after the
+ * slot's previous submission completed, as NVulkanRender does once it has acquired; it resolves that
+ * submission's zones and resets the pool. Ticks are mapped onto NProfiler::Now by Calibrate, which the
+ * constructor runs once; call it again during long sessions while no other thread submits to the graphics queue.
+ * If the graphics queue has no timestamps every call does nothing.
+ */
+class BDllExport NVulkanProfiler {
+public:
+    explicit NVulkanProfiler(uint32_t max_zones = DEFAULT_MAX_ZONES);
+    ~NVulkanProfiler();
+    NVulkanProfiler(const NVulkanProfiler& profiler) = delete;
+    NVulkanProfiler(NVulkanProfiler&& profiler) = delete;
+    NVulkanProfiler& operator=(const NVulkanProfiler& profiler) = delete;
+    NVulkanProfiler& operator=(NVulkanProfiler&& profiler) = delete;
+
+public:
+    void BeginFrame(const vk::CommandBuffer& command_buffer, size_t frame_index);
+    void BeginZone(const vk::CommandBuffer& command_buffer, const char* name, vk::PipelineStageFlagBits stage = vk::PipelineStageFlagBits::eTopOfPipe);
+    void EndZone(const vk::CommandBuffer& command_buffer, vk::PipelineStageFlagBits stage = vk::PipelineStageFlagBits::eBottomOfPipe);
+    void Calibrate();
+    bool IsSupported() const;
+    uint32_t MaxZones() const;
+
+    /**
+     * @brief Half the CPU window the calibration timestamp was taken in, in nanoseconds.
+     */
+    int64_t CalibrationError() const;
+
+public:
+    static constexpr uint32_t DEFAULT_MAX_ZONES{256};
+    static constexpr uint32_t CALIBRATION_SAMPLES{8};
+
+private:
+    struct Frame {
+        vk::QueryPool pool_{};
+        std::vector<const char*> zones_{};
+    };
+
+private:
+    void Resolve(Frame& frame);
+    int64_t ToCpuTime(uint64_t ticks) const;
+
+private:
+    static constexpr uint32_t NO_ZONE{UINT32_MAX};
+
+private:
+    bool is_supported_{false};
+    uint32_t max_zones_{0};
+    double timestamp_period_{1.0};
+    uint64_t timestamp_mask_{UINT64_MAX};
+    std::array<Frame, NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT> frames_{};
+    Frame* current_{nullptr};
+    std::vector<uint32_t> open_zones_{};
+    std::vector<uint64_t> results_{};
+    uint64_t gpu_base_{0};
+    int64_t cpu_base_{0};
+    int64_t calibration_error_{0};
+};
+
+/**
+ * @brief Times the enclosing scope of a command buffer as a GPU zone.
+ */
+class NVulkanProfileZone {
+public:
+    NVulkanProfileZone(NVulkanProfiler& profiler, const vk::CommandBuffer& command_buffer, const char* name) : profiler_(profiler), command_buffer_(command_buffer) {
+        profiler_.BeginZone(command_buffer_, name);
+    }
+    ~NVulkanProfileZone() {
+        profiler_.EndZone(command_buffer_);
+    }
+    NVulkanProfileZone(const NVulkanProfileZone& zone) = delete;
+    NVulkanProfileZone(NVulkanProfileZone&& zone) = delete;
+    NVulkanProfileZone& operator=(const NVulkanProfileZone& zone) = delete;
+    NVulkanProfileZone& operator=(NVulkanProfileZone&& zone) = delete;
+
+private:
+    NVulkanProfiler& profiler_;
+    vk::CommandBuffer command_buffer_{};
+};
+
+#if defined(NT_PROFILER)
+#define N_PROFILE_GPU_ZONE(profiler, command_buffer, name) NVulkanProfileZone N_PROFILE_CONCAT(n_profile_gpu_zone_, __LINE__)(profiler, command_buffer, name)
+#else
+#define N_PROFILE_GPU_ZONE(profiler, command_buffer, name) ((void)0)
+#endif
@@ -6,30 +6,133 @@
  * @date 2023-06-01
  */
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+#include "NDamageRegion.h"
+#include "NVulkanCommandAllocator.h"
 #include "NVulkanHeader.h"
+#include "NVulkanProfiler.h"
+#include "NVulkanSwapchain.h"
 
-class NVulkanSwapchain;
+/**
+ * @brief Snapshot handed from the UI thread to the render thread.
+ * payload_ is owned by the producer and treated as immutable once published. damage_ is what changed
+ * since the previous state, normally NCanvas::TakeDamage; left empty, the state is drawn in full.
+ */
+struct NVulkanRenderState {
+    vk::Extent2D extent_{};
+    uint64_t version_{0};
+    std::shared_ptr<const void> payload_{};
+    NDamageRegion damage_{};
+};
 
-class NVulkanRender {
+/**
+ * @brief Records and presents frames for one swapchain.
+ * A frame redraws the whole image unless SetDamage is called between BeginFrame and
+ * BeginSwapchainRenderPass. Then the pass loads the previous contents, and only the damage
+ * accumulated over the image's age is cleared and repainted through RecordRepaint.
+ * The render thread calls SetDamage with each state's damage, so its record callback draws through
+ * RecordRepaint; the damage of states it never drew is merged into the next one. More than
+ * MAX_REPAINT_RECTS rects are repainted as their bounds. If the render thread throws it stops:
+ * IsRenderThreadRunning turns false and the next PublishState or StopRenderThread rethrows the exception.
+ * With a profiler set, NT_PROFILER builds time every frame's command buffer as a "Frame" GPU zone.
+ */
+class BDllExport NVulkanRender {
 public:
-    NVulkanRender(HWND hwnd, uint32_t width, uint32_t height);
+#if defined(_WIN32)
+    NVulkanRender(HWND hwnd, uint32_t width, uint32_t height, uint32_t frames_in_flight = NVulkanSwapchain::DEFAULT_FRAMES_IN_FLIGHT);
+#endif
+    NVulkanRender(NVulkanSwapchain::Backend backend, uint32_t width, uint32_t height, uint32_t frames_in_flight = NVulkanSwapchain::DEFAULT_FRAMES_IN_FLIGHT);
     NVulkanRender() = delete;
-    ~NVulkanRender() = default;
+    ~NVulkanRender();
     NVulkanRender(const NVulkanRender& render) = delete;
     NVulkanRender(NVulkanRender&& render) = delete;
     NVulkanRender& operator=(const NVulkanRender& render) = delete;
     NVulkanRender& operator=(NVulkanRender&& render) = delete;
 
+public:
+    using RecordCallback = std::function<void(const vk::CommandBuffer& command_buffer, const NVulkanRenderState& state)>;
+    using RepaintCallback = std::function<void(const vk::Rect2D& scissor)>;
+
+public:
+    vk::CommandBuffer BeginFrame();
+    void EndFrame();
+    void BeginSwapchainRenderPass(const vk::CommandBuffer& command_buffer, vk::SubpassContents contents = vk::SubpassContents::eInline);
+    void EndSwapchainRenderPass(const vk::CommandBuffer& command_buffer);
+    void SetDamage(const NDamageRegion& damage);
+    bool IsPartialRepaint() const;
+    const std::vector<vk::Rect2D>& RepaintRects() const;
+    void RecordRepaint(const vk::CommandBuffer& command_buffer, const RepaintCallback& record);
+    vk::CommandBuffer BeginSecondaryCommandBuffer();
+    void AddWaitSemaphore(const vk::Semaphore& semaphore, const vk::PipelineStageFlags& wait_stages);
+    void AddSignalSemaphore(const vk::Semaphore& semaphore);
+    NVulkanCommandAllocator& CommandAllocator();
+    void Resize(uint32_t width, uint32_t height);
+    uint32_t FramesInFlight() const;
+    void SetFramesInFlight(uint32_t frames_in_flight);
+    size_t CurrentFrameIndex() const;
+    bool IsFrameInProgress() const;
+    const vk::CommandBuffer& CurrentCommandBuffer() const;
+    const vk::RenderPass& RenderPass() const;
+    const NVulkanSwapchain& Swapchain() const;
+    uint32_t CurrentImageIndex() const;
+    void StartRenderThread(RecordCallback callback);
+    void StopRenderThread();
+    bool IsRenderThreadRunning() const;
+    void PublishState(NVulkanRenderState state);
+    void SetProfiler(NVulkanProfiler* profiler);
+
+public:
+    static constexpr size_t MAX_DAMAGE_HISTORY{8};
+    static constexpr size_t MAX_REPAINT_RECTS{4};
+
 private:
-    void CreateSwapchain(HWND hwnd, uint32_t width, uint32_t height);
-    void CreateCommandBuffers();
+    void CreateSwapchain(uint32_t width, uint32_t height);
+    void CreateCommandAllocator();
+    void RenderThreadMain();
+    void CheckRenderThreadAccess() const;
 
 private:
+    NVulkanSwapchain::Backend backend_{NVulkanSwapchain::Backend::eWindow};
+#if defined(_WIN32)
+    HWND hwnd_{};
+#endif
+    vk::Extent2D extent_{};
+    uint32_t frames_in_flight_{NVulkanSwapchain::DEFAULT_FRAMES_IN_FLIGHT};
+    bool is_resized_{false};
     std::unique_ptr<NVulkanSwapchain> swapchain_{};
-    std::vector<vk::CommandBuffer> command_buffers_{};
+    std::unique_ptr<NVulkanCommandAllocator> command_allocator_{};
+    vk::CommandBuffer command_buffer_{};
+    std::vector<vk::Semaphore> wait_semaphores_{};
+    std::vector<vk::PipelineStageFlags> wait_stages_{};
+    std::vector<vk::Semaphore> signal_semaphores_{};
     uint32_t current_image_index_{};
     bool is_frame_started_{false};
-};
\ No newline at end of file
+    NDamageRegion damage_{};
+    std::deque<NDamageRegion> damage_history_{};
+    std::vector<vk::Rect2D> repaint_rects_{};
+    bool is_partial_repaint_{false};
+    std::thread render_thread_{};
+    std::atomic<std::thread::id> render_thread_id_{};
+    std::atomic<bool> is_render_thread_running_{false};
+    RecordCallback record_callback_{};
+    std::mutex state_mutex_{};
+    std::condition_variable state_condition_{};
+    std::array<NVulkanRenderState, 2> states_{};
+    size_t front_state_{0};
+    bool is_state_dirty_{false};
+    bool is_render_thread_stopping_{false};
+    vk::Extent2D pending_extent_{};
+    bool has_pending_extent_{false};
+    std::exception_ptr render_thread_exception_{};
+    NVulkanProfiler* profiler_{nullptr};
+};
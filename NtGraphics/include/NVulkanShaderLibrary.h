@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @file NVulkanShaderLibrary.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "NVulkanHeader.h"
+#include "NVulkanPipeline.h"
+
+struct NVulkanShaderBinding {
+    uint32_t set_{0};
+    uint32_t binding_{0};
+    vk::DescriptorType type_{vk::DescriptorType::eSampler};
+    // 0 for a runtime-sized array; the layout decides the bound.
+    uint32_t count_{1};
+};
+
+struct NVulkanEmbeddedShader {
+    std::string_view name_{};
+    vk::ShaderStageFlagBits stage_{vk::ShaderStageFlagBits::eVertex};
+    std::span<const uint32_t> code_{};
+    std::span<const NVulkanShaderBinding> bindings_{};
+    uint32_t push_constant_offset_{0};
+    uint32_t push_constant_size_{0};
+};
+
+/**
+ * @brief The shaders under shaders/Vulkan, compiled and reflected at build time.
+ * The SPIR-V and its descriptor bindings and push-constant block live in a TU that NShaderEmbed
+ * generates, so nothing is read from disk or reflected at startup. Shaders are named by their source
+ * file, e.g. "Primitive.vert".
+ */
+class BDllExport NVulkanShaderLibrary {
+public:
+    NVulkanShaderLibrary() = delete;
+
+public:
+    static std::span<const NVulkanEmbeddedShader> Shaders();
+    static const NVulkanEmbeddedShader& Shader(std::string_view name);
+    static NVulkanShaderStage Stage(std::string_view name);
+
+    /**
+     * @brief Bindings of one set across the given shaders, with the stage flags of every user merged.
+     */
+    static std::vector<vk::DescriptorSetLayoutBinding> SetLayoutBindings(std::initializer_list<std::string_view> names, uint32_t set);
+    static std::vector<vk::PushConstantRange> PushConstantRanges(std::initializer_list<std::string_view> names);
+};
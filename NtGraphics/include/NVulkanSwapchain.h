@@ -8,30 +8,96 @@
 
 #include <vector>
 
+#include "NVulkanAllocator.h"
 #include "NVulkanHeader.h"
 
 class BDllExport NVulkanSwapchain {
 public:
-    NVulkanSwapchain(HWND hwnd, uint32_t width, uint32_t height);
+    enum class Backend {
+        eWindow,
+        eHeadlessSurface,
+        eOffscreen,
+    };
+
+public:
+#if defined(_WIN32)
+    NVulkanSwapchain(HWND hwnd, uint32_t width, uint32_t height, uint32_t frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT);
+#endif
+    NVulkanSwapchain(Backend backend, uint32_t width, uint32_t height, uint32_t frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT);
     NVulkanSwapchain() = delete;
-    ~NVulkanSwapchain() = default;
+    ~NVulkanSwapchain();
     NVulkanSwapchain(const NVulkanSwapchain& swapchain) = delete;
     NVulkanSwapchain(NVulkanSwapchain&& swapchain) = delete;
     NVulkanSwapchain& operator=(const NVulkanSwapchain& swapchain) = delete;
     NVulkanSwapchain& operator=(NVulkanSwapchain&& swapchain) = delete;
 
 public:
+    Backend GetBackend() const;
     size_t GetImageCount() const;
+    uint32_t FramesInFlight() const;
+    void SetFramesInFlight(uint32_t frames_in_flight);
+    size_t CurrentFrame() const;
+    const vk::RenderPass& RenderPass() const;
+    const vk::RenderPass& LoadRenderPass() const;
+    const vk::Image& Image(uint32_t image_index) const;
+    vk::Format ImageFormat() const;
+    const vk::Framebuffer& Framebuffer(uint32_t image_index) const;
+    const vk::Extent2D& Extent() const;
+    bool HasStencil() const;
+    vk::Result AcquireNextImage(uint32_t& image_index);
+    vk::Result SubmitCommandBuffers(const vk::CommandBuffer& command_buffer, uint32_t image_index, const std::vector<vk::Semaphore>& wait_semaphores = {}, const std::vector<vk::PipelineStageFlags>& wait_stages = {}, const std::vector<vk::Semaphore>& signal_semaphores = {});
+    void Recreate(uint32_t width, uint32_t height);
+    const vk::SwapchainKHR& Handle() const;
+
+    // Partial redraw. LoadRenderPass is compatible with RenderPass and keeps the previous color contents.
+    // ImageAge is 0 while an image's contents are undefined, otherwise the number of submissions since it was
+    // last rendered. Present regions apply to the next present only and are ignored without VK_KHR_incremental_present.
+    uint64_t ImageAge(uint32_t image_index) const;
+    bool HasIncrementalPresent() const;
+    void SetPresentRegions(const std::vector<vk::Rect2D>& rects);
+
+    // Externally synchronized path for renderers that batch several swapchains into one submission.
+    // Submissions are numbered by the caller; MarkCompleted releases resources retired up to that number.
+    // frame_index selects the depth attachment, so it must be the caller's fenced frame-in-flight slot.
+    vk::Result AcquireNextImage(const vk::Semaphore& semaphore, size_t frame_index, uint32_t& image_index);
+    void MarkSubmitted(const vk::Fence& fence, uint32_t image_index, uint64_t submission);
+    void MarkCompleted(uint64_t submission);
 
 public:
-    static constexpr int MAX_FRAMES_IN_FLIGHT{2};
+    static constexpr uint32_t MIN_FRAMES_IN_FLIGHT{1};
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT{4};
+    static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT{2};
+    static constexpr uint32_t DEPTH_EXTENT_GRANULARITY{256};
+
+private:
+    struct RetiredResources {
+        uint64_t frame_{0};
+        vk::SwapchainKHR swapchain_{};
+        std::vector<vk::Image> offscreen_images_{};
+        std::vector<NVulkanAllocation> offscreen_image_allocations_{};
+        std::vector<vk::ImageView> image_views_{};
+        std::vector<vk::Framebuffer> framebuffers_{};
+        vk::RenderPass render_pass_{};
+        vk::RenderPass load_render_pass_{};
+        std::vector<vk::Image> depth_images_{};
+        std::vector<NVulkanAllocation> depth_image_allocations_{};
+        std::vector<vk::ImageView> depth_image_views_{};
+    };
 
 private:
-    void CreateSwapchain();
+    void Create();
+    void CreateSwapchain(const vk::SwapchainKHR& old_swapchain = nullptr);
+    void CreateOffscreenImages();
+    void CreateImageViews();
     void CreateRenderPass();
+    vk::RenderPass CreateRenderPass(vk::AttachmentLoadOp color_load_op) const;
     void CreateDepthResources();
     void CreateFramebuffers();
     void CreateSyncObjects();
+    void DestroySyncObjects();
+    void RetireDepthResources(RetiredResources& retired);
+    void CollectRetiredResources();
+    static void DestroyResources(RetiredResources& resources);
 
 private:
     vk::SurfaceFormatKHR ChooseSwapSurfaceFormat(const std::vector<vk::SurfaceFormatKHR>& available_formats);
@@ -40,21 +106,33 @@ private:
     vk::Format FindDepthFormat() const;
 
 private:
+    Backend backend_{Backend::eWindow};
     vk::SurfaceKHR surface_{};
     vk::Extent2D window_extent_{};
     vk::Format swapchain_image_format_{};
     vk::Extent2D swapchain_extent_{};
     vk::SwapchainKHR swapchain_{};
     std::vector<vk::Image> swapchain_images_{};
+    std::vector<NVulkanAllocation> offscreen_image_allocations_{};
+    uint32_t next_offscreen_image_{0};
     std::vector<vk::ImageView> swapchain_image_views_{};
     vk::RenderPass render_pass_{};
+    vk::RenderPass load_render_pass_{};
     std::vector<vk::Image> depth_images_{};
-    std::vector<vk::DeviceMemory> depth_image_memories_{};
+    std::vector<NVulkanAllocation> depth_image_allocations_{};
     std::vector<vk::ImageView> depth_image_views_{};
+    vk::Extent2D depth_extent_{};
+    size_t depth_slot_{0};
     std::vector<vk::Framebuffer> swapchain_framebuffers_{};
     std::vector<vk::Semaphore> image_available_semaphores_{};
     std::vector<vk::Semaphore> render_finished_semaphores_{};
     std::vector<vk::Fence> in_flight_fences_{};
     std::vector<vk::Fence> images_in_flight_{};
+    std::vector<uint64_t> image_frames_{};
+    std::vector<vk::RectLayerKHR> present_rects_{};
+    uint32_t frames_in_flight_{DEFAULT_FRAMES_IN_FLIGHT};
     size_t current_frame_{0};
+    uint64_t submitted_frames_{0};
+    uint64_t completed_frames_{0};
+    std::vector<RetiredResources> retired_{};
 };
\ No newline at end of file
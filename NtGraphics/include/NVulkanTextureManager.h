@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file NVulkanTextureManager.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <unordered_map>
+#include <vector>
+
+#include "NImageLoader.h"
+#include "NVulkanAllocator.h"
+#include "NVulkanHeader.h"
+#include "NVulkanSwapchain.h"
+#include "NVulkanUploader.h"
+
+using NVulkanTextureID = uint32_t;
+
+struct NVulkanTexture {
+    vk::Image image_{};
+    NVulkanAllocation allocation_{};
+    vk::ImageView image_view_{};
+    vk::Format format_{vk::Format::eUndefined};
+    vk::Extent2D extent_{};
+    uint32_t mip_levels_{1};
+    uint32_t layers_{1};
+    bool is_ready_{false};
+};
+
+/**
+ * @brief Mip-mapped 2D and 2D array textures, decoded off the render thread.
+ * Pre-built chains are uploaded as they are; compressed formats must be sampleable on the device.
+ * An RGBA8 image without a chain gets its mips blitted on the GPU when the format supports linear
+ * blits, otherwise box-filtered on the CPU. Call Update once per frame, after the uploader's Flush
+ * and RecordAcquireBarriers and outside any render pass; a texture may be sampled once IsReady.
+ */
+class BDllExport NVulkanTextureManager {
+public:
+    explicit NVulkanTextureManager(NVulkanUploader& uploader, size_t decode_threads = 0);
+    NVulkanTextureManager() = delete;
+    ~NVulkanTextureManager();
+    NVulkanTextureManager(const NVulkanTextureManager& manager) = delete;
+    NVulkanTextureManager(NVulkanTextureManager&& manager) = delete;
+    NVulkanTextureManager& operator=(const NVulkanTextureManager& manager) = delete;
+    NVulkanTextureManager& operator=(NVulkanTextureManager&& manager) = delete;
+
+public:
+    /**
+     * @brief Stages decoded images, one per array layer. All layers must share format and size.
+     */
+    NVulkanTextureID Create(std::vector<NImage> layers);
+
+    /**
+     * @brief Decodes the files on the loader's workers and stages them from a later Update.
+     * A failed decode is rethrown from that Update and the texture is dropped.
+     */
+    NVulkanTextureID Load(const std::vector<std::filesystem::path>& layers);
+
+    void Update(const vk::CommandBuffer& command_buffer);
+    void Destroy(NVulkanTextureID texture);
+    bool IsReady(NVulkanTextureID texture) const;
+    const NVulkanTexture& Texture(NVulkanTextureID texture) const;
+    const vk::Sampler& Sampler() const;
+    NImageLoader& Loader();
+    size_t PendingCount() const;
+
+    static vk::Format ToFormat(NImageFormat format, bool is_srgb);
+    static bool IsFormatSupported(NImageFormat format, bool is_srgb);
+
+public:
+    static constexpr uint32_t RETIRE_FRAMES{NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT + 1};
+    static constexpr float MAX_ANISOTROPY{16.0F};
+
+private:
+    struct Entry {
+        NVulkanTexture texture_{};
+        std::vector<std::future<NImage>> decodes_{};
+        uint64_t flush_{0};
+        bool is_staged_{false};
+        bool needs_mips_{false};
+    };
+
+    struct Retired {
+        NVulkanTexture texture_{};
+        uint64_t frame_{0};
+    };
+
+private:
+    void Stage(Entry& entry, std::vector<NImage>& layers);
+    void GenerateMips(const vk::CommandBuffer& command_buffer, const NVulkanTexture& texture) const;
+    void DestroyTexture(NVulkanTexture& texture) const;
+
+private:
+    NVulkanUploader& uploader_;
+    NImageLoader loader_;
+    vk::Sampler sampler_{};
+    std::unordered_map<NVulkanTextureID, Entry> entries_{};
+    std::vector<NVulkanTextureID> pending_{};
+    std::vector<Retired> retired_{};
+    NVulkanTextureID next_id_{1};
+    uint64_t frame_{0};
+};
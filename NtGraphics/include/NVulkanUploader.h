@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file NVulkanUploader.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "NVulkanAllocator.h"
+#include "NVulkanCommandAllocator.h"
+#include "NVulkanDevice.h"
+#include "NVulkanHeader.h"
+#include "NVulkanSwapchain.h"
+
+/**
+ * @brief Batches buffer and image uploads through a persistently mapped staging ring.
+ * Copies run on the dedicated transfer family when the device has one and hand ownership over to the
+ * graphics family; otherwise they run on the graphics queue. Not thread-safe: call Flush at most once
+ * per frame, after NVulkanRender::BeginFrame, and wait on the returned semaphore in that frame.
+ */
+class BDllExport NVulkanUploader {
+public:
+    explicit NVulkanUploader(vk::DeviceSize staging_size = DEFAULT_STAGING_SIZE);
+    ~NVulkanUploader();
+    NVulkanUploader(const NVulkanUploader& uploader) = delete;
+    NVulkanUploader(NVulkanUploader&& uploader) = delete;
+    NVulkanUploader& operator=(const NVulkanUploader& uploader) = delete;
+    NVulkanUploader& operator=(NVulkanUploader&& uploader) = delete;
+
+public:
+    void UploadBuffer(const void* data, vk::DeviceSize size, const vk::Buffer& buffer, vk::DeviceSize offset, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access);
+
+    /**
+     * @brief Copies data into the extent at offset of one mip level.
+     * current_layout eUndefined discards the rest of the subresource. Any other layout keeps it, and the
+     * image must be in that layout when the copy runs; with a dedicated transfer queue such a copy is
+     * recorded on the graphics queue by RecordAcquireBarriers, since the graphics family owns the contents.
+     */
+    void UploadImage(const void* data, vk::DeviceSize size, const vk::Image& image, const vk::Extent3D& extent, vk::ImageLayout final_layout, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access, const vk::ImageSubresourceLayers& subresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1}, const vk::Offset3D& offset = {}, vk::ImageLayout current_layout = vk::ImageLayout::eUndefined);
+    NVulkanQueueSync Flush();
+    void RecordAcquireBarriers(const vk::CommandBuffer& command_buffer);
+    void WaitIdle();
+    bool HasDedicatedTransferQueue() const;
+    vk::DeviceSize StagingSize() const;
+    vk::DeviceSize StagingUsed() const;
+    uint64_t FlushCount() const;
+
+public:
+    static constexpr vk::DeviceSize DEFAULT_STAGING_SIZE{64ULL * 1024 * 1024};
+    static constexpr uint32_t BATCH_COUNT{NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT + 1};
+
+private:
+    struct Batch {
+        vk::Fence fence_{};
+        vk::Semaphore semaphore_{};
+        vk::CommandBuffer command_buffer_{};
+        vk::DeviceSize ring_end_{0};
+        vk::DeviceSize ring_bytes_{0};
+        std::vector<vk::Buffer> dedicated_buffers_{};
+        std::vector<NVulkanAllocation> dedicated_allocations_{};
+        bool is_in_flight_{false};
+    };
+
+    struct GraphicsCopy {
+        vk::Buffer buffer_{};
+        NVulkanAllocation allocation_{};
+        vk::Image image_{};
+        vk::BufferImageCopy region_{};
+        vk::ImageLayout current_layout_{vk::ImageLayout::eUndefined};
+        vk::ImageLayout final_layout_{vk::ImageLayout::eUndefined};
+        vk::PipelineStageFlags dst_stages_{};
+        vk::AccessFlags dst_access_{};
+        uint64_t flush_{0};
+    };
+
+private:
+    Batch& PendingBatch();
+    vk::CommandBuffer PendingCommandBuffer();
+    void Stage(const void* data, vk::DeviceSize size, vk::DeviceSize alignment, vk::Buffer& buffer, vk::DeviceSize& offset);
+    bool TryAllocate(vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize& offset);
+    void Submit(bool signal_semaphore);
+    void Reclaim(Batch& batch, bool wait);
+    void ReclaimOldest();
+    void ReclaimGraphicsCopies();
+
+private:
+    vk::DeviceSize capacity_{0};
+    vk::DeviceSize alignment_{16};
+    vk::Buffer staging_buffer_{};
+    NVulkanAllocation staging_allocation_{};
+    vk::DeviceSize head_{0};
+    vk::DeviceSize tail_{0};
+    vk::DeviceSize used_{0};
+    vk::DeviceSize pending_bytes_{0};
+    uint32_t graphics_family_{0};
+    uint32_t transfer_family_{0};
+    std::unique_ptr<NVulkanCommandAllocator> command_allocator_{};
+    std::array<Batch, BATCH_COUNT> batches_{};
+    size_t current_batch_{0};
+    size_t oldest_batch_{0};
+    bool is_recording_{false};
+    uint64_t flush_count_{0};
+    std::vector<vk::BufferMemoryBarrier> release_buffer_barriers_{};
+    std::vector<vk::ImageMemoryBarrier> release_image_barriers_{};
+    std::vector<vk::BufferMemoryBarrier> acquire_buffer_barriers_{};
+    std::vector<vk::ImageMemoryBarrier> acquire_image_barriers_{};
+    vk::PipelineStageFlags pending_dst_stages_{};
+    vk::PipelineStageFlags acquire_dst_stages_{};
+    std::vector<GraphicsCopy> graphics_copies_{};
+    std::vector<GraphicsCopy> retired_copies_{};
+};
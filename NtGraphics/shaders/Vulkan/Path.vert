@@ -0,0 +1,21 @@
+#version 450
+
+// A path mesh vertex placed by its instance's transform; see NDrawList::DrawPath.
+
+layout(location = 0) in vec4 in_linear;
+layout(location = 1) in vec4 in_translate;
+layout(location = 2) in vec4 in_color;
+layout(location = 3) in vec2 in_position;
+
+layout(push_constant) uniform PushConstants {
+    vec2 scale;
+    vec2 translate;
+} push_constants;
+
+layout(location = 0) out vec4 out_color;
+
+void main() {
+    vec2 position = mat2(in_linear.xy, in_linear.zw) * in_position + in_translate.xy;
+    out_color = in_color;
+    gl_Position = vec4(position * push_constants.scale + push_constants.translate, 0.0, 1.0);
+}
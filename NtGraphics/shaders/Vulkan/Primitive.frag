@@ -0,0 +1,19 @@
+#version 450
+
+layout(location = 0) in vec4 in_color;
+layout(location = 1) in vec2 in_uv;
+layout(location = 2) in vec2 in_local;
+layout(location = 3) in vec2 in_half_size;
+layout(location = 4) in float in_radius;
+
+layout(location = 0) out vec4 out_color;
+
+float RoundedBoxDistance(vec2 position, vec2 half_size, float radius) {
+    vec2 q = abs(position) - half_size + radius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+}
+
+void main() {
+    float coverage = clamp(0.5 - RoundedBoxDistance(in_local, in_half_size, in_radius), 0.0, 1.0);
+    out_color = vec4(in_color.rgb, in_color.a * coverage);
+}
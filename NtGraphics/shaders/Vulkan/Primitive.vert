@@ -0,0 +1,54 @@
+#version 450
+
+// Expands one NDrawInstance into a quad; see NDrawList.h for the instance layout.
+
+layout(location = 0) in vec4 in_rect;
+layout(location = 1) in vec4 in_uv;
+layout(location = 2) in vec4 in_color;
+layout(location = 3) in vec2 in_shape;
+layout(location = 4) in uint in_primitive;
+
+layout(push_constant) uniform PushConstants {
+    vec2 scale;
+    vec2 translate;
+} push_constants;
+
+layout(location = 0) out vec4 out_color;
+layout(location = 1) out vec2 out_uv;
+layout(location = 2) out vec2 out_local;
+layout(location = 3) out vec2 out_half_size;
+layout(location = 4) out float out_radius;
+
+const uint PRIMITIVE_LINE = 2;
+const uint PRIMITIVE_IMAGE = 3;
+const uint PRIMITIVE_GLYPH = 4;
+const float AA_MARGIN = 1.0;
+
+void main() {
+    vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    float margin = in_primitive == PRIMITIVE_IMAGE || in_primitive == PRIMITIVE_GLYPH ? 0.0 : AA_MARGIN;
+    vec2 center;
+    vec2 axis = vec2(1.0, 0.0);
+    vec2 half_size;
+    if (in_primitive == PRIMITIVE_LINE) {
+        vec2 direction = in_rect.zw - in_rect.xy;
+        float length_ = length(direction);
+        if (length_ > 0.0) {
+            axis = direction / length_;
+        }
+        center = (in_rect.xy + in_rect.zw) * 0.5;
+        half_size = vec2(length_, in_shape.y) * 0.5;
+    } else {
+        half_size = in_rect.zw * 0.5;
+        center = in_rect.xy + half_size;
+    }
+    vec2 local = (corner * 2.0 - 1.0) * (half_size + margin);
+    vec2 position = center + axis * local.x + vec2(-axis.y, axis.x) * local.y;
+
+    out_color = in_color;
+    out_uv = in_uv.xy + in_uv.zw * corner;
+    out_local = local;
+    out_half_size = half_size;
+    out_radius = min(in_shape.x, min(half_size.x, half_size.y));
+    gl_Position = vec4(position * push_constants.scale + push_constants.translate, 0.0, 1.0);
+}
@@ -0,0 +1,17 @@
+#version 450
+
+// Single-channel distance field glyphs from NGlyphAtlas: 0.5 is the outline.
+
+layout(set = 0, binding = 0) uniform sampler2D atlas;
+
+layout(location = 0) in vec4 in_color;
+layout(location = 1) in vec2 in_uv;
+
+layout(location = 0) out vec4 out_color;
+
+void main() {
+    float distance = texture(atlas, in_uv).r;
+    float width = max(fwidth(distance), 1.0e-4);
+    float coverage = smoothstep(0.5 - width, 0.5 + width, distance);
+    out_color = vec4(in_color.rgb, in_color.a * coverage);
+}
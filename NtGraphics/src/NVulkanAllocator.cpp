@@ -0,0 +1,268 @@
+/**
+ * @file NVulkanAllocator.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanAllocator.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+static vk::DeviceSize AlignUp(vk::DeviceSize value, vk::DeviceSize alignment) {
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+class NVulkanMemoryBlock {
+public:
+    NVulkanMemoryBlock(vk::DeviceMemory memory, vk::DeviceSize size, uint32_t memory_type_index, NVulkanAllocationStrategy strategy, bool linear_resource, void* mapped)
+        : memory_(memory), size_(size), memory_type_index_(memory_type_index), strategy_(strategy), linear_resource_(linear_resource), mapped_(mapped) {
+        free_ranges_.emplace(0, size_);
+    }
+
+public:
+    bool Allocate(vk::DeviceSize size, vk::DeviceSize alignment, NVulkanAllocation& allocation) {
+        vk::DeviceSize offset{0};
+        if (strategy_ == NVulkanAllocationStrategy::eLinear) {
+            offset = AlignUp(linear_top_, alignment);
+            if (offset + size > size_) {
+                return false;
+            }
+            linear_top_ = offset + size;
+        } else {
+            auto best = free_ranges_.end();
+            vk::DeviceSize best_offset{0};
+            vk::DeviceSize best_waste{(std::numeric_limits<vk::DeviceSize>::max)()};
+            for (auto it = free_ranges_.begin(); it != free_ranges_.end(); ++it) {
+                auto aligned = AlignUp(it->first, alignment);
+                auto end = it->first + it->second;
+                if (aligned + size > end) {
+                    continue;
+                }
+                auto waste = end - aligned - size;
+                if (waste < best_waste) {
+                    best = it;
+                    best_offset = aligned;
+                    best_waste = waste;
+                    if (waste == 0) {
+                        break;
+                    }
+                }
+            }
+            if (best == free_ranges_.end()) {
+                return false;
+            }
+            auto range_offset = best->first;
+            auto range_end = best->first + best->second;
+            free_ranges_.erase(best);
+            if (best_offset > range_offset) {
+                free_ranges_.emplace(range_offset, best_offset - range_offset);
+            }
+            if (best_offset + size < range_end) {
+                free_ranges_.emplace(best_offset + size, range_end - best_offset - size);
+            }
+            offset = best_offset;
+        }
+        used_bytes_ += size;
+        ++allocation_count_;
+        allocation.memory_ = memory_;
+        allocation.offset_ = offset;
+        allocation.size_ = size;
+        allocation.memory_type_index_ = memory_type_index_;
+        allocation.mapped_ = mapped_ ? static_cast<char*>(mapped_) + offset : nullptr;
+        allocation.block_ = this;
+        return true;
+    }
+
+    void Free(const NVulkanAllocation& allocation) {
+        used_bytes_ -= allocation.size_;
+        --allocation_count_;
+        if (strategy_ == NVulkanAllocationStrategy::eLinear) {
+            if (allocation_count_ == 0) {
+                linear_top_ = 0;
+            } else if (allocation.offset_ + allocation.size_ == linear_top_) {
+                linear_top_ = allocation.offset_;
+            }
+            return;
+        }
+        auto offset = allocation.offset_;
+        auto size = allocation.size_;
+        auto next = free_ranges_.lower_bound(offset);
+        if (next != free_ranges_.end() && offset + size == next->first) {
+            size += next->second;
+            next = free_ranges_.erase(next);
+        }
+        if (next != free_ranges_.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                offset = previous->first;
+                size += previous->second;
+                free_ranges_.erase(previous);
+            }
+        }
+        free_ranges_.emplace(offset, size);
+    }
+
+    void AccumulateStatistics(NVulkanAllocator::HeapStatistics& statistics) const {
+        ++statistics.block_count_;
+        statistics.allocation_count_ += allocation_count_;
+        statistics.reserved_bytes_ += size_;
+        statistics.used_bytes_ += used_bytes_;
+        if (strategy_ == NVulkanAllocationStrategy::eLinear) {
+            if (linear_top_ < size_) {
+                ++statistics.free_range_count_;
+                statistics.largest_free_range_ = (std::max)(statistics.largest_free_range_, size_ - linear_top_);
+            }
+            return;
+        }
+        for (const auto& [offset, size] : free_ranges_) {
+            ++statistics.free_range_count_;
+            statistics.largest_free_range_ = (std::max)(statistics.largest_free_range_, size);
+        }
+    }
+
+    bool Empty() const {
+        return allocation_count_ == 0;
+    }
+
+    vk::DeviceMemory Memory() const {
+        return memory_;
+    }
+
+    std::tuple<uint32_t, NVulkanAllocationStrategy, bool> PoolKey() const {
+        return {memory_type_index_, strategy_, linear_resource_};
+    }
+
+private:
+    vk::DeviceMemory memory_{};
+    vk::DeviceSize size_{0};
+    uint32_t memory_type_index_{0};
+    NVulkanAllocationStrategy strategy_{NVulkanAllocationStrategy::eFreeList};
+    bool linear_resource_{true};
+    void* mapped_{nullptr};
+    std::map<vk::DeviceSize, vk::DeviceSize> free_ranges_{};
+    vk::DeviceSize linear_top_{0};
+    vk::DeviceSize used_bytes_{0};
+    uint32_t allocation_count_{0};
+};
+
+NVulkanAllocator::NVulkanAllocator(const vk::Device& device, const vk::PhysicalDeviceMemoryProperties& memory_properties)
+    : device_(device), memory_properties_(memory_properties) {
+    dedicated_counts_.resize(memory_properties_.memoryHeapCount, 0);
+    dedicated_bytes_.resize(memory_properties_.memoryHeapCount, 0);
+}
+
+NVulkanAllocator::~NVulkanAllocator() {
+    for (auto& [key, blocks] : pools_) {
+        for (auto& block : blocks) {
+            device_.freeMemory(block->Memory());
+        }
+    }
+    // Dedicated allocations that were never freed would otherwise leak past the device.
+    for (const auto& memory : dedicated_memories_) {
+        device_.freeMemory(memory);
+    }
+}
+
+NVulkanAllocation NVulkanAllocator::Allocate(const vk::MemoryRequirements& requirements, uint32_t memory_type_index, const NVulkanAllocationCreateInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto block_size = PreferredBlockSize(memory_type_index);
+    if (info.dedicated_ || requirements.size > block_size / 2) {
+        return AllocateDedicated(requirements.size, memory_type_index);
+    }
+    NVulkanAllocation allocation{};
+    auto& blocks = pools_[{memory_type_index, info.strategy_, info.linear_resource_}];
+    for (auto& block : blocks) {
+        if (block->Allocate(requirements.size, requirements.alignment, allocation)) {
+            return allocation;
+        }
+    }
+    void* mapped{nullptr};
+    auto memory = AllocateDeviceMemory(block_size, memory_type_index, mapped);
+    blocks.push_back(std::make_unique<NVulkanMemoryBlock>(memory, block_size, memory_type_index, info.strategy_, info.linear_resource_, mapped));
+    if (!blocks.back()->Allocate(requirements.size, requirements.alignment, allocation)) {
+        throw std::runtime_error("Failed to sub-allocate device memory.");
+    }
+    return allocation;
+}
+
+void NVulkanAllocator::Free(NVulkanAllocation& allocation) {
+    if (!allocation) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto heap_index = memory_properties_.memoryTypes[allocation.memory_type_index_].heapIndex;
+    if (!allocation.block_) {
+        dedicated_memories_.erase(std::find(dedicated_memories_.begin(), dedicated_memories_.end(), allocation.memory_));
+        device_.freeMemory(allocation.memory_);
+        --dedicated_counts_[heap_index];
+        dedicated_bytes_[heap_index] -= allocation.size_;
+        allocation = {};
+        return;
+    }
+    auto* block = allocation.block_;
+    block->Free(allocation);
+    allocation = {};
+    if (!block->Empty()) {
+        return;
+    }
+    auto& blocks = pools_[block->PoolKey()];
+    auto empty_count = std::count_if(blocks.begin(), blocks.end(), [](const auto& item) { return item->Empty(); });
+    if (empty_count > 1) {
+        auto it = std::find_if(blocks.begin(), blocks.end(), [block](const auto& item) { return item.get() == block; });
+        device_.freeMemory(block->Memory());
+        blocks.erase(it);
+    }
+}
+
+std::vector<NVulkanAllocator::HeapStatistics> NVulkanAllocator::GetHeapStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<HeapStatistics> statistics(memory_properties_.memoryHeapCount);
+    for (uint32_t i = 0; i < memory_properties_.memoryHeapCount; ++i) {
+        statistics[i].heap_size_ = memory_properties_.memoryHeaps[i].size;
+        statistics[i].dedicated_count_ = dedicated_counts_[i];
+        statistics[i].allocation_count_ = dedicated_counts_[i];
+        statistics[i].reserved_bytes_ = dedicated_bytes_[i];
+        statistics[i].used_bytes_ = dedicated_bytes_[i];
+    }
+    for (const auto& [key, blocks] : pools_) {
+        auto heap_index = memory_properties_.memoryTypes[std::get<0>(key)].heapIndex;
+        for (const auto& block : blocks) {
+            block->AccumulateStatistics(statistics[heap_index]);
+        }
+    }
+    return statistics;
+}
+
+vk::DeviceSize NVulkanAllocator::PreferredBlockSize(uint32_t memory_type_index) const {
+    auto heap_size = memory_properties_.memoryHeaps[memory_properties_.memoryTypes[memory_type_index].heapIndex].size;
+    return heap_size <= SMALL_HEAP_MAX_SIZE ? AlignUp(heap_size / 8, 32) : LARGE_HEAP_BLOCK_SIZE;
+}
+
+NVulkanAllocation NVulkanAllocator::AllocateDedicated(vk::DeviceSize size, uint32_t memory_type_index) {
+    NVulkanAllocation allocation{};
+    allocation.memory_ = AllocateDeviceMemory(size, memory_type_index, allocation.mapped_);
+    allocation.size_ = size;
+    allocation.memory_type_index_ = memory_type_index;
+    dedicated_memories_.push_back(allocation.memory_);
+    auto heap_index = memory_properties_.memoryTypes[memory_type_index].heapIndex;
+    ++dedicated_counts_[heap_index];
+    dedicated_bytes_[heap_index] += size;
+    return allocation;
+}
+
+vk::DeviceMemory NVulkanAllocator::AllocateDeviceMemory(vk::DeviceSize size, uint32_t memory_type_index, void*& mapped) {
+    vk::MemoryAllocateInfo allocate_info{};
+    allocate_info
+        .setAllocationSize(size)
+        .setMemoryTypeIndex(memory_type_index);
+    auto memory = device_.allocateMemory(allocate_info);
+    mapped = IsHostVisible(memory_type_index) ? device_.mapMemory(memory, 0, VK_WHOLE_SIZE) : nullptr;
+    return memory;
+}
+
+bool NVulkanAllocator::IsHostVisible(uint32_t memory_type_index) const {
+    return static_cast<bool>(memory_properties_.memoryTypes[memory_type_index].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible);
+}
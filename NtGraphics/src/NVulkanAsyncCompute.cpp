@@ -0,0 +1,176 @@
+/**
+ * @file NVulkanAsyncCompute.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanAsyncCompute.h"
+
+#include <stdexcept>
+
+#include "NVulkanPhysical.h"
+
+NVulkanAsyncCompute::NVulkanAsyncCompute() {
+    auto& device = NVulkanDevice::Singleton();
+    const auto& queue_families = NVulkanPhysical::Singleton().QueueFamilies();
+    graphics_family_ = queue_families.graphics_family_;
+    compute_family_ = queue_families.compute_family_;
+    command_allocator_ = std::make_unique<NVulkanCommandAllocator>(compute_family_, BATCH_COUNT);
+    vk::FenceCreateInfo fence_info{};
+    fence_info.setFlags(vk::FenceCreateFlagBits::eSignaled);
+    vk::SemaphoreCreateInfo semaphore_info{};
+    for (auto& batch : batches_) {
+        batch.fence_ = device.CreateFence(fence_info);
+        batch.semaphore_ = device.CreateSemaphore(semaphore_info);
+    }
+}
+
+NVulkanAsyncCompute::~NVulkanAsyncCompute() {
+    auto& device = NVulkanDevice::Singleton();
+    if (is_recording_) {
+        batches_[current_batch_].command_buffer_.end();
+        is_recording_ = false;
+    }
+    WaitIdle();
+    for (auto& batch : batches_) {
+        device.DestroyFence(batch.fence_);
+        device.DestroySemaphore(batch.semaphore_);
+    }
+    command_allocator_.reset();
+}
+
+vk::CommandBuffer NVulkanAsyncCompute::Begin() {
+    auto& batch = batches_[current_batch_];
+    if (is_recording_) {
+        return batch.command_buffer_;
+    }
+    Reclaim(batch);
+    command_allocator_->BeginFrame(current_batch_);
+    batch.command_buffer_ = command_allocator_->AllocatePrimary();
+    vk::CommandBufferBeginInfo begin_info{};
+    begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    batch.command_buffer_.begin(begin_info);
+    is_recording_ = true;
+    return batch.command_buffer_;
+}
+
+void NVulkanAsyncCompute::AddWaitSemaphore(const vk::Semaphore& semaphore, const vk::PipelineStageFlags& wait_stages) {
+    wait_semaphores_.push_back(semaphore);
+    wait_stages_.push_back(wait_stages);
+}
+
+void NVulkanAsyncCompute::ReleaseBuffer(const vk::Buffer& buffer, vk::DeviceSize offset, vk::DeviceSize size, const vk::AccessFlags& src_access, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access) {
+    auto is_async = HasAsyncQueue();
+    vk::BufferMemoryBarrier barrier{};
+    barrier
+        .setSrcAccessMask(src_access)
+        .setDstAccessMask(is_async ? vk::AccessFlags{} : dst_access)
+        .setSrcQueueFamilyIndex(is_async ? compute_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(is_async ? graphics_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setBuffer(buffer)
+        .setOffset(offset)
+        .setSize(size);
+    release_buffer_barriers_.push_back(barrier);
+    if (is_async) {
+        barrier
+            .setSrcAccessMask({})
+            .setDstAccessMask(dst_access);
+        acquire_buffer_barriers_.push_back(barrier);
+    }
+    pending_dst_stages_ |= dst_stages;
+}
+
+void NVulkanAsyncCompute::ReleaseImage(const vk::Image& image, vk::ImageLayout old_layout, vk::ImageLayout new_layout, const vk::ImageSubresourceRange& range, const vk::AccessFlags& src_access, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access) {
+    auto is_async = HasAsyncQueue();
+    vk::ImageMemoryBarrier barrier{};
+    barrier
+        .setSrcAccessMask(src_access)
+        .setDstAccessMask(is_async ? vk::AccessFlags{} : dst_access)
+        .setOldLayout(old_layout)
+        .setNewLayout(new_layout)
+        .setSrcQueueFamilyIndex(is_async ? compute_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(is_async ? graphics_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setImage(image)
+        .setSubresourceRange(range);
+    release_image_barriers_.push_back(barrier);
+    if (is_async) {
+        barrier
+            .setSrcAccessMask({})
+            .setDstAccessMask(dst_access);
+        acquire_image_barriers_.push_back(barrier);
+    }
+    pending_dst_stages_ |= dst_stages;
+}
+
+NVulkanQueueSync NVulkanAsyncCompute::Submit() {
+    if (!is_recording_) {
+        throw std::runtime_error("Can't submit compute work that was not begun.");
+    }
+    auto is_async = HasAsyncQueue();
+    auto& batch = batches_[current_batch_];
+    const auto& command_buffer = batch.command_buffer_;
+    if (!release_buffer_barriers_.empty() || !release_image_barriers_.empty()) {
+        auto dst_stages = is_async ? vk::PipelineStageFlags{vk::PipelineStageFlagBits::eBottomOfPipe} : pending_dst_stages_;
+        if (!dst_stages) {
+            dst_stages = vk::PipelineStageFlagBits::eAllCommands;
+        }
+        command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, dst_stages, {}, {}, release_buffer_barriers_, release_image_barriers_);
+    }
+    command_buffer.end();
+    vk::SubmitInfo submit_info{};
+    submit_info
+        .setCommandBuffers(command_buffer)
+        .setWaitSemaphores(wait_semaphores_)
+        .setWaitDstStageMask(wait_stages_);
+    if (is_async) {
+        submit_info.setSignalSemaphores(batch.semaphore_);
+    }
+    NVulkanDevice::Singleton().ResetFence(batch.fence_);
+    NVulkanDevice::Singleton().SubmitCompute(submit_info, batch.fence_);
+    batch.is_in_flight_ = true;
+    is_recording_ = false;
+    current_batch_ = (current_batch_ + 1) % BATCH_COUNT;
+    wait_semaphores_.clear();
+    wait_stages_.clear();
+    release_buffer_barriers_.clear();
+    release_image_barriers_.clear();
+    acquire_dst_stages_ |= pending_dst_stages_;
+    pending_dst_stages_ = {};
+    if (!is_async) {
+        return {};
+    }
+    // The semaphore is signalled on every async submission, so the graphics side has to wait on it.
+    return {batch.semaphore_, acquire_dst_stages_ ? acquire_dst_stages_ : vk::PipelineStageFlags{vk::PipelineStageFlagBits::eAllCommands}};
+}
+
+void NVulkanAsyncCompute::RecordAcquireBarriers(const vk::CommandBuffer& command_buffer) {
+    if (acquire_buffer_barriers_.empty() && acquire_image_barriers_.empty()) {
+        return;
+    }
+    command_buffer.pipelineBarrier(acquire_dst_stages_, acquire_dst_stages_, {}, {}, acquire_buffer_barriers_, acquire_image_barriers_);
+    acquire_buffer_barriers_.clear();
+    acquire_image_barriers_.clear();
+    acquire_dst_stages_ = {};
+}
+
+void NVulkanAsyncCompute::WaitIdle() {
+    for (auto& batch : batches_) {
+        Reclaim(batch);
+    }
+}
+
+bool NVulkanAsyncCompute::HasAsyncQueue() const {
+    return compute_family_ != graphics_family_;
+}
+
+uint32_t NVulkanAsyncCompute::QueueFamily() const {
+    return compute_family_;
+}
+
+void NVulkanAsyncCompute::Reclaim(Batch& batch) {
+    if (!batch.is_in_flight_) {
+        return;
+    }
+    NVulkanDevice::Singleton().WaitForFences({batch.fence_});
+    batch.is_in_flight_ = false;
+}
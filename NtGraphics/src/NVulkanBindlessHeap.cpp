@@ -0,0 +1,207 @@
+/**
+ * @file NVulkanBindlessHeap.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanBindlessHeap.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "NVulkanDevice.h"
+#include "NVulkanPhysical.h"
+
+NVulkanBindlessHeap::NVulkanBindlessHeap(uint32_t texture_capacity, uint32_t buffer_capacity) {
+    auto& device = NVulkanDevice::Singleton();
+    if (!device.HasBindless()) {
+        throw std::runtime_error("Descriptor indexing is not supported by the device.");
+    }
+    const auto& limits = NVulkanPhysical::Singleton().GetCapabilities().descriptor_indexing_properties_;
+    sampler_capacity_ = (std::min)({SAMPLER_CAPACITY, limits.maxDescriptorSetUpdateAfterBindSamplers, limits.maxPerStageDescriptorUpdateAfterBindSamplers});
+    buffers_.capacity_ = (std::min)({buffer_capacity, limits.maxDescriptorSetUpdateAfterBindStorageBuffers, limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+    textures_.capacity_ = (std::min)({texture_capacity, limits.maxDescriptorSetUpdateAfterBindSampledImages, limits.maxPerStageDescriptorUpdateAfterBindSampledImages});
+    // Textures give way when the three arrays together exceed what one stage may see.
+    if (limits.maxPerStageUpdateAfterBindResources < sampler_capacity_ + buffers_.capacity_ + textures_.capacity_) {
+        textures_.capacity_ = limits.maxPerStageUpdateAfterBindResources - (std::min)(limits.maxPerStageUpdateAfterBindResources, sampler_capacity_ + buffers_.capacity_);
+    }
+    if (textures_.capacity_ == 0 || buffers_.capacity_ == 0 || sampler_capacity_ == 0) {
+        throw std::runtime_error("Descriptor indexing limits are too small for a bindless heap.");
+    }
+    textures_.is_used_.resize(textures_.capacity_);
+    buffers_.is_used_.resize(buffers_.capacity_);
+
+    std::array<vk::DescriptorSetLayoutBinding, 3> bindings{
+        vk::DescriptorSetLayoutBinding{TEXTURE_BINDING, vk::DescriptorType::eSampledImage, textures_.capacity_, vk::ShaderStageFlagBits::eAll},
+        vk::DescriptorSetLayoutBinding{SAMPLER_BINDING, vk::DescriptorType::eSampler, sampler_capacity_, vk::ShaderStageFlagBits::eAll},
+        vk::DescriptorSetLayoutBinding{BUFFER_BINDING, vk::DescriptorType::eStorageBuffer, buffers_.capacity_, vk::ShaderStageFlagBits::eAll},
+    };
+    vk::DescriptorBindingFlags binding_flags = vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+    std::array<vk::DescriptorBindingFlags, 3> flags{binding_flags, binding_flags, binding_flags};
+    vk::DescriptorSetLayoutBindingFlagsCreateInfoEXT flags_info{};
+    flags_info.setBindingFlags(flags);
+    vk::DescriptorSetLayoutCreateInfo layout_info{};
+    layout_info
+        .setPNext(&flags_info)
+        .setFlags(vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPoolEXT)
+        .setBindings(bindings);
+    layout_ = device.CreateDescriptorSetLayout(layout_info);
+
+    std::array<vk::DescriptorPoolSize, 3> pool_sizes{
+        vk::DescriptorPoolSize{vk::DescriptorType::eSampledImage, textures_.capacity_},
+        vk::DescriptorPoolSize{vk::DescriptorType::eSampler, sampler_capacity_},
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, buffers_.capacity_},
+    };
+    vk::DescriptorPoolCreateInfo pool_info{};
+    pool_info
+        .setFlags(vk::DescriptorPoolCreateFlagBits::eUpdateAfterBindEXT)
+        .setMaxSets(1)
+        .setPoolSizes(pool_sizes);
+    pool_ = device.CreateDescriptorPool(pool_info);
+    vk::DescriptorSetAllocateInfo alloc_info{};
+    alloc_info
+        .setDescriptorPool(pool_)
+        .setSetLayouts(layout_);
+    set_ = device.AllocateDescriptorSets(alloc_info).front();
+    samplers_.reserve(sampler_capacity_);
+}
+
+NVulkanBindlessHeap::~NVulkanBindlessHeap() {
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    for (const auto& [info, sampler] : samplers_) {
+        device.DestroySampler(sampler);
+    }
+    device.DestroyDescriptorPool(pool_);
+    device.DestroyDescriptorSetLayout(layout_);
+}
+
+NVulkanBindlessHandle NVulkanBindlessHeap::AddTexture(const vk::ImageView& image_view, vk::ImageLayout layout) {
+    auto slot = textures_.Acquire();
+    vk::DescriptorImageInfo image_info{nullptr, image_view, layout};
+    vk::WriteDescriptorSet write{};
+    write
+        .setDstSet(set_)
+        .setDstBinding(TEXTURE_BINDING)
+        .setDstArrayElement(slot)
+        .setDescriptorType(vk::DescriptorType::eSampledImage)
+        .setImageInfo(image_info);
+    NVulkanDevice::Singleton().UpdateDescriptorSets({write});
+    return slot;
+}
+
+NVulkanBindlessHandle NVulkanBindlessHeap::AddBuffer(const vk::Buffer& buffer, vk::DeviceSize offset, vk::DeviceSize range) {
+    auto slot = buffers_.Acquire();
+    vk::DescriptorBufferInfo buffer_info{buffer, offset, range};
+    vk::WriteDescriptorSet write{};
+    write
+        .setDstSet(set_)
+        .setDstBinding(BUFFER_BINDING)
+        .setDstArrayElement(slot)
+        .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+        .setBufferInfo(buffer_info);
+    NVulkanDevice::Singleton().UpdateDescriptorSets({write});
+    return slot;
+}
+
+void NVulkanBindlessHeap::ReleaseTexture(NVulkanBindlessHandle texture) {
+    textures_.Release(texture, frame_);
+}
+
+void NVulkanBindlessHeap::ReleaseBuffer(NVulkanBindlessHandle buffer) {
+    buffers_.Release(buffer, frame_);
+}
+
+NVulkanBindlessHandle NVulkanBindlessHeap::GetSampler(const vk::SamplerCreateInfo& info) {
+    if (info.pNext) {
+        throw std::runtime_error("Samplers with extension structures cannot be shared through the heap.");
+    }
+    for (size_t i = 0; i < samplers_.size(); ++i) {
+        if (samplers_[i].first == info) {
+            return static_cast<NVulkanBindlessHandle>(i);
+        }
+    }
+    if (samplers_.size() == sampler_capacity_) {
+        throw std::runtime_error("Bindless sampler slots are exhausted.");
+    }
+    auto slot = static_cast<NVulkanBindlessHandle>(samplers_.size());
+    auto sampler = NVulkanDevice::Singleton().CreateSampler(info);
+    vk::DescriptorImageInfo image_info{sampler, nullptr, vk::ImageLayout::eUndefined};
+    vk::WriteDescriptorSet write{};
+    write
+        .setDstSet(set_)
+        .setDstBinding(SAMPLER_BINDING)
+        .setDstArrayElement(slot)
+        .setDescriptorType(vk::DescriptorType::eSampler)
+        .setImageInfo(image_info);
+    NVulkanDevice::Singleton().UpdateDescriptorSets({write});
+    samplers_.emplace_back(info, sampler);
+    return slot;
+}
+
+void NVulkanBindlessHeap::BeginFrame() {
+    ++frame_;
+    textures_.Reclaim(frame_);
+    buffers_.Reclaim(frame_);
+}
+
+void NVulkanBindlessHeap::Bind(const vk::CommandBuffer& command_buffer, vk::PipelineBindPoint bind_point, const vk::PipelineLayout& layout, uint32_t set) const {
+    command_buffer.bindDescriptorSets(bind_point, layout, set, set_, {});
+}
+
+const vk::DescriptorSetLayout& NVulkanBindlessHeap::Layout() const {
+    return layout_;
+}
+
+uint32_t NVulkanBindlessHeap::TextureCapacity() const {
+    return textures_.capacity_;
+}
+
+uint32_t NVulkanBindlessHeap::BufferCapacity() const {
+    return buffers_.capacity_;
+}
+
+uint32_t NVulkanBindlessHeap::TextureCount() const {
+    return textures_.count_;
+}
+
+uint32_t NVulkanBindlessHeap::BufferCount() const {
+    return buffers_.count_;
+}
+
+uint32_t NVulkanBindlessHeap::SamplerCount() const {
+    return static_cast<uint32_t>(samplers_.size());
+}
+
+uint32_t NVulkanBindlessHeap::Slots::Acquire() {
+    uint32_t slot = 0;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+    } else {
+        if (next_ == capacity_) {
+            throw std::runtime_error("Bindless descriptor slots are exhausted.");
+        }
+        slot = next_++;
+    }
+    is_used_[slot] = true;
+    ++count_;
+    return slot;
+}
+
+void NVulkanBindlessHeap::Slots::Release(uint32_t slot, uint64_t frame) {
+    if (slot >= capacity_ || !is_used_[slot]) {
+        throw std::runtime_error("Bindless handle is not in use.");
+    }
+    is_used_[slot] = false;
+    --count_;
+    retired_.emplace_back(slot, frame);
+}
+
+void NVulkanBindlessHeap::Slots::Reclaim(uint64_t frame) {
+    while (!retired_.empty() && retired_.front().second + RETIRE_FRAMES <= frame) {
+        free_.push_back(retired_.front().first);
+        retired_.pop_front();
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file NVulkanCommandAllocator.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanCommandAllocator.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "NVulkanDevice.h"
+
+NVulkanCommandAllocator::NVulkanCommandAllocator(uint32_t queue_family_index, uint32_t frames_in_flight)
+    : queue_family_index_(queue_family_index), frames_in_flight_(frames_in_flight) {
+}
+
+NVulkanCommandAllocator::~NVulkanCommandAllocator() {
+    for (auto& [thread_id, pools] : thread_pools_) {
+        for (auto& pool : pools->frame_pools_) {
+            NVulkanDevice::Singleton().DestroyCommandPool(pool.command_pool_);
+        }
+    }
+    for (uint32_t i = 0; i < frames_in_flight_; ++i) {
+        DestroyRetired(i);
+    }
+}
+
+void NVulkanCommandAllocator::BeginFrame(size_t frame_index) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    current_frame_ = frame_index % frames_in_flight_;
+    DestroyRetired(current_frame_);
+    for (auto& [thread_id, pools] : thread_pools_) {
+        auto& pool = pools->frame_pools_[current_frame_];
+        if (pool.primary_used_ == 0 && pool.secondary_used_ == 0) {
+            continue;
+        }
+        NVulkanDevice::Singleton().ResetCommandPool(pool.command_pool_);
+        pool.primary_used_ = 0;
+        pool.secondary_used_ = 0;
+    }
+}
+
+vk::CommandBuffer NVulkanCommandAllocator::AllocatePrimary() {
+    return Allocate(CurrentPool(), vk::CommandBufferLevel::ePrimary);
+}
+
+vk::CommandBuffer NVulkanCommandAllocator::AllocateSecondary() {
+    return Allocate(CurrentPool(), vk::CommandBufferLevel::eSecondary);
+}
+
+vk::CommandBuffer NVulkanCommandAllocator::BeginSecondary(const vk::CommandBufferInheritanceInfo& inheritance_info) {
+    auto command_buffer = AllocateSecondary();
+    vk::CommandBufferBeginInfo begin_info{};
+    begin_info
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+        .setPInheritanceInfo(&inheritance_info);
+    command_buffer.begin(begin_info);
+    return command_buffer;
+}
+
+void NVulkanCommandAllocator::ReleaseThread() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = thread_pools_.find(std::this_thread::get_id());
+    if (it == thread_pools_.end()) {
+        return;
+    }
+    retired_pools_.push_back(std::move(it->second));
+    thread_pools_.erase(it);
+}
+
+uint32_t NVulkanCommandAllocator::FramesInFlight() const {
+    return frames_in_flight_;
+}
+
+size_t NVulkanCommandAllocator::ThreadCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return thread_pools_.size();
+}
+
+size_t NVulkanCommandAllocator::RetiredCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return retired_pools_.size();
+}
+
+NVulkanCommandAllocator::FramePool& NVulkanCommandAllocator::CurrentPool() {
+    auto thread_id = std::this_thread::get_id();
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = thread_pools_.find(thread_id);
+        if (it != thread_pools_.end()) {
+            return it->second->frame_pools_[current_frame_];
+        }
+    }
+    auto pools = std::make_unique<ThreadPools>();
+    pools->frame_pools_.resize(frames_in_flight_);
+    vk::CommandPoolCreateInfo pool_info{};
+    pool_info
+        .setFlags(vk::CommandPoolCreateFlagBits::eTransient)
+        .setQueueFamilyIndex(queue_family_index_);
+    for (auto& pool : pools->frame_pools_) {
+        pool.command_pool_ = NVulkanDevice::Singleton().CreateCommandPool(pool_info);
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& inserted = thread_pools_.emplace(thread_id, std::move(pools)).first->second;
+    return inserted->frame_pools_[current_frame_];
+}
+
+vk::CommandBuffer NVulkanCommandAllocator::Allocate(FramePool& pool, vk::CommandBufferLevel level) {
+    auto is_primary = level == vk::CommandBufferLevel::ePrimary;
+    auto& command_buffers = is_primary ? pool.primary_command_buffers_ : pool.secondary_command_buffers_;
+    auto& used = is_primary ? pool.primary_used_ : pool.secondary_used_;
+    if (used == command_buffers.size()) {
+        vk::CommandBufferAllocateInfo alloc_info{};
+        alloc_info
+            .setLevel(level)
+            .setCommandPool(pool.command_pool_)
+            .setCommandBufferCount(1);
+        command_buffers.push_back(NVulkanDevice::Singleton().AllocateCommandBuffers(alloc_info).front());
+    }
+    return command_buffers[used++];
+}
+
+void NVulkanCommandAllocator::DestroyRetired(size_t frame_index) {
+    for (auto& pools : retired_pools_) {
+        auto& pool = pools->frame_pools_[frame_index];
+        if (pool.command_pool_) {
+            NVulkanDevice::Singleton().DestroyCommandPool(pool.command_pool_);
+            pool.command_pool_ = nullptr;
+        }
+    }
+    std::erase_if(retired_pools_, [](const std::unique_ptr<ThreadPools>& pools) {
+        return std::ranges::none_of(pools->frame_pools_, [](const FramePool& pool) {
+            return static_cast<bool>(pool.command_pool_);
+        });
+    });
+}
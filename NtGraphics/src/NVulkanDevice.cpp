@@ -6,6 +6,11 @@
 
 #include "NVulkanDevice.h"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include "NVulkanInstance.h"
@@ -14,37 +19,47 @@
 NVulkanDevice::NVulkanDevice() {
     CreateDevice();
     CreateCommandPool();
+    CreateAllocator();
 }
 
 vk::SwapchainKHR NVulkanDevice::CreateSwapchain(const vk::SwapchainCreateInfoKHR& info) {
     return device_.createSwapchainKHR(info);
 }
 
+void NVulkanDevice::DestroySwapchain(const vk::SwapchainKHR& swapchain) {
+    device_.destroySwapchainKHR(swapchain);
+}
+
 std::vector<vk::Image> NVulkanDevice::GetSwapchainImages(const vk::SwapchainKHR& swapchain) {
     return device_.getSwapchainImagesKHR(swapchain);
 }
 
-vk::ImageView NVulkanDevice::CreateImageView(const vk::Image& image, const vk::Format& format, vk::ImageAspectFlagBits flag) {
+vk::ImageView NVulkanDevice::CreateImageView(const vk::Image& image, const vk::Format& format, const vk::ImageAspectFlags& aspect) {
     vk::ImageViewCreateInfo view_info{};
     view_info
         .setImage(image)
         .setViewType(vk::ImageViewType::e2D)
         .setFormat(format);
     view_info.subresourceRange
-        .setAspectMask(flag)
+        .setAspectMask(aspect)
         .setBaseMipLevel(0)
         .setLevelCount(1)
         .setBaseArrayLayer(0)
         .setLayerCount(1);
-    return device_.createImageView(view_info);
+    return CreateImageView(view_info);
+}
+
+vk::ImageView NVulkanDevice::CreateImageView(const vk::ImageViewCreateInfo& info) {
+    return device_.createImageView(info);
+}
+
+void NVulkanDevice::DestroyImageView(const vk::ImageView& image_view) {
+    device_.destroyImageView(image_view);
 }
 
 vk::Format NVulkanDevice::FindSupportFormat(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling, const vk::FormatFeatureFlags& features) const {
     for (const auto& format : candidates) {
-        auto properties = NVulkanPhysical::Singleton().GetFormatProperties(format);
-        if (tiling == vk::ImageTiling::eLinear && (properties.linearTilingFeatures & features) == features) {
-            return format;
-        } else if (tiling == vk::ImageTiling::eOptimal && (properties.optimalTilingFeatures & features) == features) {
+        if (NVulkanPhysical::Singleton().IsFormatSupported(format, tiling, features)) {
             return format;
         }
     }
@@ -55,7 +70,11 @@ vk::RenderPass NVulkanDevice::CreateRenderPass(const vk::RenderPassCreateInfo& i
     return device_.createRenderPass(info);
 }
 
-void NVulkanDevice::CreateImage(uint32_t width, uint32_t height, vk::Format format, vk::ImageTiling tiling, const vk::ImageUsageFlags& usage, const vk::MemoryPropertyFlags& properties, vk::Image& image, vk::DeviceMemory& memory) {
+void NVulkanDevice::DestroyRenderPass(const vk::RenderPass& render_pass) {
+    device_.destroyRenderPass(render_pass);
+}
+
+void NVulkanDevice::CreateImage(uint32_t width, uint32_t height, vk::Format format, vk::ImageTiling tiling, const vk::ImageUsageFlags& usage, const vk::MemoryPropertyFlags& properties, vk::Image& image, NVulkanAllocation& allocation, const vk::MemoryPropertyFlags& preferred_properties) {
     vk::ImageCreateInfo image_info{};
     image_info
         .setImageType(vk::ImageType::e2D)
@@ -71,20 +90,79 @@ void NVulkanDevice::CreateImage(uint32_t width, uint32_t height, vk::Format form
         .setWidth(width)
         .setHeight(height)
         .setDepth(1);
-    image = device_.createImage(image_info);
+    CreateImage(image_info, properties, image, allocation, preferred_properties);
+}
+
+void NVulkanDevice::CreateImage(const vk::ImageCreateInfo& info, const vk::MemoryPropertyFlags& properties, vk::Image& image, NVulkanAllocation& allocation, const vk::MemoryPropertyFlags& preferred_properties) {
+    image = device_.createImage(info);
     auto memory_requirements = device_.getImageMemoryRequirements(image);
-    vk::MemoryAllocateInfo allocate_info{};
-    allocate_info
-        .setAllocationSize(memory_requirements.size)
-        .setMemoryTypeIndex(FindMemoryType(memory_requirements.memoryTypeBits, properties));
-    memory = device_.allocateMemory(allocate_info);
-    device_.bindImageMemory(image, memory, 0);
+    NVulkanAllocationCreateInfo allocation_info{};
+    allocation_info.linear_resource_ = info.tiling == vk::ImageTiling::eLinear;
+    allocation = allocator_->Allocate(memory_requirements, FindMemoryType(memory_requirements.memoryTypeBits, properties, preferred_properties), allocation_info);
+    device_.bindImageMemory(image, allocation.memory_, allocation.offset_);
+}
+
+void NVulkanDevice::DestroyImage(vk::Image& image, NVulkanAllocation& allocation) {
+    device_.destroyImage(image);
+    image = nullptr;
+    allocator_->Free(allocation);
+}
+
+void NVulkanDevice::CreateBuffer(vk::DeviceSize size, const vk::BufferUsageFlags& usage, const vk::MemoryPropertyFlags& properties, vk::Buffer& buffer, NVulkanAllocation& allocation, NVulkanAllocationStrategy strategy, const vk::MemoryPropertyFlags& preferred_properties) {
+    vk::BufferCreateInfo buffer_info{};
+    buffer_info
+        .setSize(size)
+        .setUsage(usage)
+        .setSharingMode(vk::SharingMode::eExclusive);
+    buffer = device_.createBuffer(buffer_info);
+    auto memory_requirements = device_.getBufferMemoryRequirements(buffer);
+    NVulkanAllocationCreateInfo allocation_info{};
+    allocation_info.strategy_ = strategy;
+    allocation = allocator_->Allocate(memory_requirements, FindMemoryType(memory_requirements.memoryTypeBits, properties, preferred_properties), allocation_info);
+    device_.bindBufferMemory(buffer, allocation.memory_, allocation.offset_);
+}
+
+void NVulkanDevice::DestroyBuffer(vk::Buffer& buffer, NVulkanAllocation& allocation) {
+    device_.destroyBuffer(buffer);
+    buffer = nullptr;
+    allocator_->Free(allocation);
+}
+
+std::vector<NVulkanAllocator::HeapStatistics> NVulkanDevice::GetHeapStatistics() const {
+    return allocator_->GetHeapStatistics();
+}
+
+std::vector<NVulkanHeapBudget> NVulkanDevice::GetHeapBudgets() const {
+    const auto& memory_properties = NVulkanPhysical::Singleton().GetMemoryProperties();
+    auto statistics = allocator_->GetHeapStatistics();
+    vk::PhysicalDeviceMemoryBudgetPropertiesEXT budget_properties{};
+    auto has_budget = NVulkanPhysical::Singleton().QueryMemoryBudget(budget_properties);
+    std::vector<NVulkanHeapBudget> budgets(memory_properties.memoryHeapCount);
+    for (uint32_t i = 0; i < memory_properties.memoryHeapCount; ++i) {
+        auto& budget = budgets[i];
+        budget.heap_size_ = memory_properties.memoryHeaps[i].size;
+        budget.allocated_ = statistics[i].reserved_bytes_;
+        budget.is_device_local_ = static_cast<bool>(memory_properties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal);
+        if (has_budget) {
+            budget.budget_ = budget_properties.heapBudget[i];
+            budget.usage_ = budget_properties.heapUsage[i];
+        } else {
+            // Without VK_EXT_memory_budget only our own allocations are known; assume most of the heap is ours.
+            budget.budget_ = budget.heap_size_ / 10 * 8;
+            budget.usage_ = budget.allocated_;
+        }
+    }
+    return budgets;
 }
 
 vk::Framebuffer NVulkanDevice::CreateFramebuffer(const vk::FramebufferCreateInfo& info) {
     return device_.createFramebuffer(info);
 }
 
+void NVulkanDevice::DestroyFramebuffer(const vk::Framebuffer& framebuffer) {
+    device_.destroyFramebuffer(framebuffer);
+}
+
 vk::Semaphore NVulkanDevice::CreateSemaphore(const vk::SemaphoreCreateInfo& info) {
     return device_.createSemaphore(info);
 }
@@ -93,7 +171,58 @@ vk::Fence NVulkanDevice::CreateFence(const vk::FenceCreateInfo& info) {
     return device_.createFence(info);
 }
 
+void NVulkanDevice::DestroySemaphore(const vk::Semaphore& semaphore) {
+    device_.destroySemaphore(semaphore);
+}
+
+void NVulkanDevice::DestroyFence(const vk::Fence& fence) {
+    device_.destroyFence(fence);
+}
+
+void NVulkanDevice::WaitForFences(const std::vector<vk::Fence>& fences) const {
+    if (fences.empty()) {
+        return;
+    }
+    if (device_.waitForFences(fences, true, (std::numeric_limits<uint64_t>::max)()) != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed to wait for fences.");
+    }
+}
+
+void NVulkanDevice::ResetFence(const vk::Fence& fence) {
+    device_.resetFences(fence);
+}
+
+vk::Result NVulkanDevice::AcquireNextImage(const vk::SwapchainKHR& swapchain, const vk::Semaphore& semaphore, uint32_t& image_index) {
+    return device_.acquireNextImageKHR(swapchain, (std::numeric_limits<uint64_t>::max)(), semaphore, nullptr, &image_index);
+}
+
+void NVulkanDevice::SubmitGraphics(const vk::SubmitInfo& info, const vk::Fence& fence) {
+    std::lock_guard<std::mutex> lock(queue_mutexes_[graphics_lock_]);
+    graphics_queue_.submit(info, fence);
+}
+
+void NVulkanDevice::SubmitTransfer(const vk::SubmitInfo& info, const vk::Fence& fence) {
+    std::lock_guard<std::mutex> lock(queue_mutexes_[transfer_lock_]);
+    transfer_queue_.submit(info, fence);
+}
+
+void NVulkanDevice::SubmitCompute(const vk::SubmitInfo& info, const vk::Fence& fence) {
+    std::lock_guard<std::mutex> lock(queue_mutexes_[compute_lock_]);
+    compute_queue_.submit(info, fence);
+}
+
+bool NVulkanDevice::IsFenceSignaled(const vk::Fence& fence) const {
+    return device_.getFenceStatus(fence) == vk::Result::eSuccess;
+}
+
+vk::Result NVulkanDevice::Present(const vk::PresentInfoKHR& info) {
+    std::lock_guard<std::mutex> lock(queue_mutexes_[present_lock_]);
+    return present_queue_.presentKHR(&info);
+}
+
 void NVulkanDevice::WaitIdle() const {
+    // vkDeviceWaitIdle externally synchronizes every queue of the device.
+    std::scoped_lock lock(queue_mutexes_[0], queue_mutexes_[1], queue_mutexes_[2], queue_mutexes_[3]);
     device_.waitIdle();
 }
 
@@ -101,29 +230,155 @@ const vk::CommandPool& NVulkanDevice::CommandPool() const {
     return command_pool_;
 }
 
+vk::CommandPool NVulkanDevice::CreateCommandPool(const vk::CommandPoolCreateInfo& info) {
+    return device_.createCommandPool(info);
+}
+
+void NVulkanDevice::ResetCommandPool(const vk::CommandPool& command_pool) {
+    device_.resetCommandPool(command_pool);
+}
+
+void NVulkanDevice::DestroyCommandPool(const vk::CommandPool& command_pool) {
+    device_.destroyCommandPool(command_pool);
+}
+
 std::vector<vk::CommandBuffer> NVulkanDevice::AllocateCommandBuffers(const vk::CommandBufferAllocateInfo& info) {
     return device_.allocateCommandBuffers(info);
 }
 
+void NVulkanDevice::FreeCommandBuffers(const std::vector<vk::CommandBuffer>& command_buffers) {
+    if (!command_buffers.empty()) {
+        device_.freeCommandBuffers(command_pool_, command_buffers);
+    }
+}
+
+vk::DescriptorSetLayout NVulkanDevice::CreateDescriptorSetLayout(const vk::DescriptorSetLayoutCreateInfo& info) {
+    return device_.createDescriptorSetLayout(info);
+}
+
+void NVulkanDevice::DestroyDescriptorSetLayout(const vk::DescriptorSetLayout& layout) {
+    device_.destroyDescriptorSetLayout(layout);
+}
+
+vk::DescriptorPool NVulkanDevice::CreateDescriptorPool(const vk::DescriptorPoolCreateInfo& info) {
+    return device_.createDescriptorPool(info);
+}
+
+void NVulkanDevice::DestroyDescriptorPool(const vk::DescriptorPool& pool) {
+    device_.destroyDescriptorPool(pool);
+}
+
+std::vector<vk::DescriptorSet> NVulkanDevice::AllocateDescriptorSets(const vk::DescriptorSetAllocateInfo& info) {
+    return device_.allocateDescriptorSets(info);
+}
+
+void NVulkanDevice::FreeDescriptorSets(const vk::DescriptorPool& pool, const std::vector<vk::DescriptorSet>& descriptor_sets) {
+    if (!descriptor_sets.empty()) {
+        device_.freeDescriptorSets(pool, descriptor_sets);
+    }
+}
+
+void NVulkanDevice::UpdateDescriptorSets(const std::vector<vk::WriteDescriptorSet>& writes) {
+    device_.updateDescriptorSets(writes, {});
+}
+
+vk::Sampler NVulkanDevice::CreateSampler(const vk::SamplerCreateInfo& info) {
+    return device_.createSampler(info);
+}
+
+void NVulkanDevice::DestroySampler(const vk::Sampler& sampler) {
+    device_.destroySampler(sampler);
+}
+
+vk::QueryPool NVulkanDevice::CreateQueryPool(const vk::QueryPoolCreateInfo& info) {
+    return device_.createQueryPool(info);
+}
+
+void NVulkanDevice::DestroyQueryPool(const vk::QueryPool& pool) {
+    device_.destroyQueryPool(pool);
+}
+
+bool NVulkanDevice::GetQueryPoolResults(const vk::QueryPool& pool, uint32_t first, uint32_t count, std::vector<uint64_t>& results) const {
+    results.resize(count);
+    if (count == 0) {
+        return true;
+    }
+    // Without the wait flag this returns eNotReady instead of blocking when a query has not completed.
+    auto result = device_.getQueryPoolResults(pool, first, count, results.size() * sizeof(uint64_t), results.data(), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+    return result == vk::Result::eSuccess;
+}
+
+vk::ShaderModule NVulkanDevice::CreateShaderModule(const vk::ShaderModuleCreateInfo& info) {
+    return device_.createShaderModule(info);
+}
+
+void NVulkanDevice::DestroyShaderModule(const vk::ShaderModule& module) {
+    device_.destroyShaderModule(module);
+}
+
+vk::PipelineLayout NVulkanDevice::CreatePipelineLayout(const vk::PipelineLayoutCreateInfo& info) {
+    return device_.createPipelineLayout(info);
+}
+
+void NVulkanDevice::DestroyPipelineLayout(const vk::PipelineLayout& layout) {
+    device_.destroyPipelineLayout(layout);
+}
+
+vk::Pipeline NVulkanDevice::CreateGraphicsPipeline(const vk::PipelineCache& cache, const vk::GraphicsPipelineCreateInfo& info) {
+    auto result = device_.createGraphicsPipeline(cache, info);
+    if (result.result != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed to create graphics pipeline.");
+    }
+    return result.value;
+}
+
+vk::Pipeline NVulkanDevice::CreateComputePipeline(const vk::PipelineCache& cache, const vk::ComputePipelineCreateInfo& info) {
+    auto result = device_.createComputePipeline(cache, info);
+    if (result.result != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed to create compute pipeline.");
+    }
+    return result.value;
+}
+
+void NVulkanDevice::DestroyPipeline(const vk::Pipeline& pipeline) {
+    device_.destroyPipeline(pipeline);
+}
+
+vk::PipelineCache NVulkanDevice::CreatePipelineCache(const vk::PipelineCacheCreateInfo& info) {
+    return device_.createPipelineCache(info);
+}
+
+void NVulkanDevice::MergePipelineCaches(const vk::PipelineCache& destination, const vk::PipelineCache& source) {
+    device_.mergePipelineCaches(destination, source);
+}
+
+void NVulkanDevice::DestroyPipelineCache(const vk::PipelineCache& cache) {
+    device_.destroyPipelineCache(cache);
+}
+
+std::vector<uint8_t> NVulkanDevice::GetPipelineCacheData(const vk::PipelineCache& cache) const {
+    return device_.getPipelineCacheData(cache);
+}
+
+bool NVulkanDevice::HasBindless() const {
+    return has_bindless_;
+}
+
 void NVulkanDevice::CreateDevice() {
-    auto indices = NVulkanPhysical::Singleton().QueueFamilies();
-    auto queue_priority = 1.0F;
+    const auto& indices = NVulkanPhysical::Singleton().QueueFamilies();
+    std::map<uint32_t, uint32_t> queue_counts{};
+    for (auto family : {indices.graphics_family_, indices.present_family_, indices.transfer_family_}) {
+        queue_counts[family] = (std::max)(queue_counts[family], 1U);
+    }
+    queue_counts[indices.compute_family_] = (std::max)(queue_counts[indices.compute_family_], indices.compute_queue_index_ + 1);
+    std::vector<float> queue_priorities(2, 1.0F);
     std::vector<vk::DeviceQueueCreateInfo> queue_create_infos;
-    if (indices.graphics_family_ == indices.present_family_) {
+    for (const auto& [family, count] : queue_counts) {
         vk::DeviceQueueCreateInfo queue_create_info{};
         queue_create_info
-            .setQueueCount(1)
-            .setQueueFamilyIndex(indices.graphics_family_)
-            .setQueuePriorities(queue_priority);
-        queue_create_infos.push_back(queue_create_info);
-    } else {
-        vk::DeviceQueueCreateInfo queue_create_info;
-        queue_create_info
-            .setQueueCount(1)
-            .setQueueFamilyIndex(indices.graphics_family_)
-            .setQueuePriorities(queue_priority);
-        queue_create_infos.push_back(queue_create_info);
-        queue_create_info.setQueueFamilyIndex(indices.present_family_);
+            .setQueueFamilyIndex(family)
+            .setQueueCount(count)
+            .setPQueuePriorities(queue_priorities.data());
         queue_create_infos.push_back(queue_create_info);
     }
     vk::PhysicalDeviceFeatures device_features{};
@@ -135,13 +390,36 @@ void NVulkanDevice::CreateDevice() {
         .setEnabledExtensionCount(static_cast<uint32_t>(NVulkanPhysical::Singleton().DeviceExtensions().size()))
         .setPEnabledExtensionNames(NVulkanPhysical::Singleton().DeviceExtensions())
         .setPEnabledFeatures(&device_features);
+    // Descriptor indexing is enabled whenever it is complete enough for NVulkanBindlessHeap; the heap itself is opt-in.
+    vk::PhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features{};
+    has_bindless_ = NVulkanPhysical::Singleton().HasBindlessSupport();
+    if (has_bindless_) {
+        const auto& supported = NVulkanPhysical::Singleton().GetCapabilities().descriptor_indexing_features_;
+        descriptor_indexing_features
+            .setRuntimeDescriptorArray(true)
+            .setDescriptorBindingPartiallyBound(true)
+            .setDescriptorBindingUpdateUnusedWhilePending(true)
+            .setDescriptorBindingSampledImageUpdateAfterBind(true)
+            .setDescriptorBindingStorageBufferUpdateAfterBind(true)
+            .setShaderSampledImageArrayNonUniformIndexing(true)
+            .setShaderStorageBufferArrayNonUniformIndexing(supported.shaderStorageBufferArrayNonUniformIndexing);
+        device_create_info.setPNext(&descriptor_indexing_features);
+    }
     device_ = NVulkanPhysical::Singleton().CreateDevice(device_create_info);
     graphics_queue_ = device_.getQueue(indices.graphics_family_, 0);
     present_queue_ = device_.getQueue(indices.present_family_, 0);
+    transfer_queue_ = device_.getQueue(indices.transfer_family_, 0);
+    compute_queue_ = device_.getQueue(indices.compute_family_, indices.compute_queue_index_);
+    // Queues that resolve to the same VkQueue share a lock, since Vulkan synchronizes per handle.
+    std::array<vk::Queue, QUEUE_COUNT> queues{graphics_queue_, present_queue_, transfer_queue_, compute_queue_};
+    std::array<size_t*, QUEUE_COUNT> locks{&graphics_lock_, &present_lock_, &transfer_lock_, &compute_lock_};
+    for (size_t i = 0; i < QUEUE_COUNT; ++i) {
+        *locks[i] = static_cast<size_t>(std::find(queues.begin(), queues.end(), queues[i]) - queues.begin());
+    }
 }
 
 void NVulkanDevice::CreateCommandPool() {
-    auto queue_family_indices = NVulkanPhysical::Singleton().QueueFamilies();
+    const auto& queue_family_indices = NVulkanPhysical::Singleton().QueueFamilies();
     vk::CommandPoolCreateInfo pool_info{};
     pool_info
         .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer)
@@ -149,12 +427,27 @@ void NVulkanDevice::CreateCommandPool() {
     command_pool_ = device_.createCommandPool(pool_info);
 }
 
-uint32_t NVulkanDevice::FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) {
-    auto memory_properties = NVulkanPhysical::Singleton().GetMemoryProperties();
-    for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i) {
-        if ((typeFilter & (1 << i)) && (memory_properties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
+void NVulkanDevice::CreateAllocator() {
+    allocator_ = std::make_shared<NVulkanAllocator>(device_, NVulkanPhysical::Singleton().GetMemoryProperties());
+}
+
+uint32_t NVulkanDevice::FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties, vk::MemoryPropertyFlags preferred_properties) {
+    const auto& memory_properties = NVulkanPhysical::Singleton().GetMemoryProperties();
+    auto find = [&memory_properties, typeFilter](const vk::MemoryPropertyFlags& flags) -> std::optional<uint32_t> {
+        for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i) {
+            if ((typeFilter & (1 << i)) && (memory_properties.memoryTypes[i].propertyFlags & flags) == flags) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    };
+    if (preferred_properties) {
+        if (auto index = find(properties | preferred_properties)) {
+            return *index;
         }
     }
-    return 0;
+    if (auto index = find(properties)) {
+        return *index;
+    }
+    throw std::runtime_error("Failed to find a suitable memory type.");
 }
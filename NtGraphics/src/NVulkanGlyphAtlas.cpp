@@ -0,0 +1,145 @@
+/**
+ * @file NVulkanGlyphAtlas.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanGlyphAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "NVulkanDevice.h"
+
+NVulkanGlyphAtlas::NVulkanGlyphAtlas(NGlyphAtlas& atlas, NVulkanPrimitiveRenderer& renderer, uint32_t frames_in_flight)
+    : atlas_(atlas), renderer_(renderer), frames_((std::max)(frames_in_flight, 1U)) {
+    vk::SamplerCreateInfo sampler_info{};
+    sampler_info
+        .setMagFilter(vk::Filter::eLinear)
+        .setMinFilter(vk::Filter::eLinear)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToEdge);
+    sampler_ = NVulkanDevice::Singleton().CreateSampler(sampler_info);
+    // Pages that already exist get their textures now and are uploaded in full by the next Update.
+    atlas_.SetTextureProvider([this](uint32_t page) {
+        return CreatePage(page);
+    });
+}
+
+NVulkanGlyphAtlas::~NVulkanGlyphAtlas() {
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    atlas_.SetTextureProvider({});
+    for (auto& page : pages_) {
+        renderer_.UnregisterTexture(page.texture_);
+        device.DestroyImageView(page.image_view_);
+        device.DestroyImage(page.image_, page.allocation_);
+    }
+    for (auto& frame : frames_) {
+        if (frame.buffer_) {
+            device.DestroyBuffer(frame.buffer_, frame.allocation_);
+        }
+    }
+    device.DestroySampler(sampler_);
+}
+
+void NVulkanGlyphAtlas::Update(const vk::CommandBuffer& command_buffer, size_t frame_index) {
+    uploads_.clear();
+    uploaded_bytes_ = 0;
+    NAtlasRegion region{};
+    for (uint32_t page = 0; page < atlas_.PageCount(); ++page) {
+        if (atlas_.TakeDirtyRegion(page, region)) {
+            uploads_.push_back({page, region, uploaded_bytes_});
+            uploaded_bytes_ += static_cast<vk::DeviceSize>(region.width_) * region.height_;
+        }
+    }
+    if (uploads_.empty()) {
+        return;
+    }
+    // Frames in flight may have been raised since construction; a shared slot would overwrite staging the GPU still reads.
+    if (frame_index >= frames_.size()) {
+        frames_.resize(frame_index + 1);
+    }
+    auto& frame = frames_[frame_index];
+    EnsureCapacity(frame, uploaded_bytes_);
+    auto page_size = atlas_.PageSize();
+    auto* staging = static_cast<uint8_t*>(frame.allocation_.mapped_);
+    for (const auto& upload : uploads_) {
+        const auto& pixels = atlas_.PagePixels(upload.page_);
+        for (uint32_t y = 0; y < upload.region_.height_; ++y) {
+            std::memcpy(staging + upload.offset_ + static_cast<vk::DeviceSize>(y) * upload.region_.width_, pixels.data() + static_cast<size_t>(upload.region_.y_ + y) * page_size + upload.region_.x_, upload.region_.width_);
+        }
+    }
+
+    std::vector<vk::ImageMemoryBarrier> barriers{};
+    barriers.reserve(uploads_.size());
+    for (const auto& upload : uploads_) {
+        auto& page = pages_[upload.page_];
+        vk::ImageMemoryBarrier barrier{};
+        barrier
+            .setSrcAccessMask(page.is_initialized_ ? vk::AccessFlagBits::eShaderRead : vk::AccessFlags{})
+            .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setOldLayout(page.is_initialized_ ? vk::ImageLayout::eShaderReadOnlyOptimal : vk::ImageLayout::eUndefined)
+            .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setImage(page.image_)
+            .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1});
+        barriers.push_back(barrier);
+    }
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barriers);
+    for (const auto& upload : uploads_) {
+        vk::BufferImageCopy copy{};
+        copy
+            .setBufferOffset(upload.offset_)
+            .setImageSubresource({vk::ImageAspectFlagBits::eColor, 0, 0, 1})
+            .setImageOffset({static_cast<int32_t>(upload.region_.x_), static_cast<int32_t>(upload.region_.y_), 0})
+            .setImageExtent({upload.region_.width_, upload.region_.height_, 1});
+        command_buffer.copyBufferToImage(frame.buffer_, pages_[upload.page_].image_, vk::ImageLayout::eTransferDstOptimal, copy);
+    }
+    for (auto& barrier : barriers) {
+        barrier
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eShaderRead)
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+    }
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barriers);
+    for (const auto& upload : uploads_) {
+        pages_[upload.page_].is_initialized_ = true;
+    }
+}
+
+vk::DeviceSize NVulkanGlyphAtlas::UploadedBytes() const {
+    return uploaded_bytes_;
+}
+
+NTextureID NVulkanGlyphAtlas::CreatePage(uint32_t page) {
+    if (page < pages_.size()) {
+        return pages_[page].texture_;
+    }
+    auto& device = NVulkanDevice::Singleton();
+    auto size = atlas_.PageSize();
+    auto& created = pages_.emplace_back();
+    device.CreateImage(size, size, FORMAT, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst, vk::MemoryPropertyFlagBits::eDeviceLocal, created.image_, created.allocation_);
+    created.image_view_ = device.CreateImageView(created.image_, FORMAT, vk::ImageAspectFlagBits::eColor);
+    created.texture_ = renderer_.RegisterTexture(created.image_view_, sampler_);
+    return created.texture_;
+}
+
+void NVulkanGlyphAtlas::EnsureCapacity(FrameResources& frame, vk::DeviceSize size) {
+    if (size <= frame.capacity_) {
+        return;
+    }
+    auto& device = NVulkanDevice::Singleton();
+    if (frame.buffer_) {
+        device.DestroyBuffer(frame.buffer_, frame.allocation_);
+    }
+    frame.capacity_ = (std::max)(size, frame.capacity_ * 2);
+    device.CreateBuffer(frame.capacity_, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, frame.buffer_, frame.allocation_);
+    if (!frame.allocation_.mapped_) {
+        throw std::runtime_error("Glyph staging memory is not host visible.");
+    }
+}
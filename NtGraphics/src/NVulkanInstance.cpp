@@ -15,13 +15,18 @@ NVulkanInstance::NVulkanInstance() {
     CheckValidationLayerSupport();
     CheckExtensionsSupport();
     vk::ApplicationInfo app_info{};
-    auto extensions = GetRequiredExtensions();
+    enabled_extensions_ = GetRequiredExtensions();
+    auto optional_extensions = GetOptionalExtensions();
+    enabled_extensions_.insert(enabled_extensions_.end(), optional_extensions.begin(), optional_extensions.end());
+    const auto& extensions = enabled_extensions_;
     vk::InstanceCreateInfo create_info{};
     create_info
         .setPApplicationInfo(&app_info)
-        .setFlags(vk::InstanceCreateFlagBits::eEnumeratePortabilityKHR)
         .setEnabledExtensionCount(static_cast<uint32_t>(extensions.size()))
         .setPEnabledExtensionNames(extensions);
+    if (IsExtensionEnabled(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME)) {
+        create_info.setFlags(vk::InstanceCreateFlagBits::eEnumeratePortabilityKHR);
+    }
     if (enable_validation_layers_) {
         vk::DebugUtilsMessengerCreateInfoEXT debug_create_info{};
         PopulateDebugMessengerCreateInfo(debug_create_info);
@@ -49,6 +54,30 @@ vk::SurfaceKHR NVulkanInstance::CreateSurface(const vk::Win32SurfaceCreateInfoKH
 }
 #endif
 
+vk::SurfaceKHR NVulkanInstance::CreateHeadlessSurface() {
+    if (!IsExtensionEnabled(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME)) {
+        throw std::runtime_error("Missing extension: " + std::string(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME) + ".");
+    }
+    return instance_.createHeadlessSurfaceEXT(vk::HeadlessSurfaceCreateInfoEXT{}, nullptr, vk::DispatchLoaderDynamic(instance_, reinterpret_cast<PFN_vkGetInstanceProcAddr>(instance_.getProcAddr("vkGetInstanceProcAddr"))));
+}
+
+void NVulkanInstance::DestroySurface(const vk::SurfaceKHR& surface) {
+    instance_.destroySurfaceKHR(surface);
+}
+
+bool NVulkanInstance::IsExtensionEnabled(const char* name) const {
+    for (const auto* extension : enabled_extensions_) {
+        if (std::string(extension) == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PFN_vkVoidFunction NVulkanInstance::GetProcAddr(const char* name) const {
+    return instance_.getProcAddr(name);
+}
+
 void NVulkanInstance::CheckValidationLayerSupport() const {
     if (enable_validation_layers_) {
         auto available_layers = vk::enumerateInstanceLayerProperties();
@@ -83,12 +112,27 @@ void NVulkanInstance::CheckExtensionsSupport() const {
 std::vector<const char*> NVulkanInstance::GetRequiredExtensions() const {
 #if defined(_WIN32)
     std::vector<const char*> extensions{"VK_KHR_surface", "VK_KHR_win32_surface"};
+#else
+    std::vector<const char*> extensions{"VK_KHR_surface"};
 #endif
     if (enable_validation_layers_) {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
     }
     extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
-    extensions.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+    return extensions;
+}
+
+std::vector<const char*> NVulkanInstance::GetOptionalExtensions() const {
+    auto available = vk::enumerateInstanceExtensionProperties();
+    std::vector<const char*> extensions;
+    for (const auto* optional : {VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME}) {
+        for (const auto& extension : available) {
+            if (std::string(extension.extensionName.data()) == optional) {
+                extensions.push_back(optional);
+                break;
+            }
+        }
+    }
     return extensions;
 }
 
@@ -0,0 +1,263 @@
+/**
+ * @file NVulkanMultiRender.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanMultiRender.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "NVulkanDevice.h"
+#include "NVulkanPhysical.h"
+
+NVulkanMultiRender::NVulkanMultiRender(uint32_t frames_in_flight)
+    : frames_in_flight_(std::clamp(frames_in_flight, NVulkanSwapchain::MIN_FRAMES_IN_FLIGHT, NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT)) {
+    command_allocator_ = std::make_unique<NVulkanCommandAllocator>(NVulkanPhysical::Singleton().QueueFamilies().graphics_family_, frames_in_flight_);
+    vk::FenceCreateInfo fence_info{};
+    fence_info.setFlags(vk::FenceCreateFlagBits::eSignaled);
+    in_flight_fences_.resize(frames_in_flight_);
+    for (auto& fence : in_flight_fences_) {
+        fence = NVulkanDevice::Singleton().CreateFence(fence_info);
+    }
+}
+
+NVulkanMultiRender::~NVulkanMultiRender() {
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    for (auto& [canvas_id, canvas] : canvases_) {
+        DestroyCanvas(canvas);
+    }
+    canvases_.clear();
+    for (const auto& fence : in_flight_fences_) {
+        device.DestroyFence(fence);
+    }
+    command_allocator_.reset();
+}
+
+#if defined(_WIN32)
+NVulkanMultiRender::CanvasID NVulkanMultiRender::AddCanvas(HWND hwnd, uint32_t width, uint32_t height, uint32_t refresh_rate) {
+    return InsertCanvas(std::make_unique<NVulkanSwapchain>(hwnd, width, height, frames_in_flight_), width, height, refresh_rate);
+}
+#endif
+
+NVulkanMultiRender::CanvasID NVulkanMultiRender::AddCanvas(NVulkanSwapchain::Backend backend, uint32_t width, uint32_t height, uint32_t refresh_rate) {
+    return InsertCanvas(std::make_unique<NVulkanSwapchain>(backend, width, height, frames_in_flight_), width, height, refresh_rate);
+}
+
+void NVulkanMultiRender::RemoveCanvas(CanvasID canvas_id) {
+    auto it = canvases_.find(canvas_id);
+    if (it == canvases_.end()) {
+        return;
+    }
+    NVulkanDevice::Singleton().WaitIdle();
+    DestroyCanvas(it->second);
+    canvases_.erase(it);
+}
+
+void NVulkanMultiRender::ResizeCanvas(CanvasID canvas_id, uint32_t width, uint32_t height) {
+    auto& canvas = canvases_.at(canvas_id);
+    canvas.extent_ = vk::Extent2D{width, height};
+    canvas.is_resized_ = true;
+}
+
+void NVulkanMultiRender::SetRefreshRate(CanvasID canvas_id, uint32_t refresh_rate) {
+    auto& canvas = canvases_.at(canvas_id);
+    canvas.interval_ = Interval(refresh_rate);
+    canvas.next_present_time_ = std::chrono::steady_clock::now();
+}
+
+size_t NVulkanMultiRender::CanvasCount() const {
+    return canvases_.size();
+}
+
+const NVulkanSwapchain& NVulkanMultiRender::Swapchain(CanvasID canvas_id) const {
+    return *canvases_.at(canvas_id).swapchain_;
+}
+
+uint32_t NVulkanMultiRender::FramesInFlight() const {
+    return frames_in_flight_;
+}
+
+std::chrono::steady_clock::time_point NVulkanMultiRender::NextDeadline() const {
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    for (const auto& [canvas_id, canvas] : canvases_) {
+        deadline = (std::min)(deadline, canvas.next_present_time_);
+    }
+    return deadline;
+}
+
+size_t NVulkanMultiRender::RenderFrame(const RecordCallback& record) {
+    auto& device = NVulkanDevice::Singleton();
+    auto now = std::chrono::steady_clock::now();
+    auto is_any_due = std::any_of(canvases_.begin(), canvases_.end(), [this, now](const auto& entry) {
+        return IsDue(entry.second, now);
+    });
+    if (!is_any_due) {
+        return 0;
+    }
+
+    const auto& fence = in_flight_fences_[current_frame_];
+    device.WaitForFences({fence});
+    if (submissions_ >= frames_in_flight_) {
+        auto completed = submissions_ - frames_in_flight_ + 1;
+        for (auto& [canvas_id, canvas] : canvases_) {
+            canvas.swapchain_->MarkCompleted(completed);
+        }
+    }
+
+    std::vector<std::pair<CanvasID, Canvas*>> acquired;
+    for (auto& [canvas_id, canvas] : canvases_) {
+        if (!IsDue(canvas, now)) {
+            continue;
+        }
+        if (canvas.is_resized_) {
+            canvas.is_resized_ = false;
+            canvas.swapchain_->Recreate(canvas.extent_.width, canvas.extent_.height);
+        }
+        auto result = canvas.swapchain_->AcquireNextImage(canvas.image_available_semaphores_[current_frame_], current_frame_, canvas.image_index_);
+        if (result == vk::Result::eErrorOutOfDateKHR) {
+            canvas.is_resized_ = true;
+            continue;
+        }
+        if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR) {
+            throw std::runtime_error("Failed to acquire swapchain image.");
+        }
+        if (canvas.interval_.count() > 0) {
+            canvas.next_present_time_ += canvas.interval_;
+            if (canvas.next_present_time_ <= now) {
+                canvas.next_present_time_ = now + canvas.interval_;
+            }
+        }
+        acquired.emplace_back(canvas_id, &canvas);
+    }
+    if (acquired.empty()) {
+        return 0;
+    }
+
+    command_allocator_->BeginFrame(current_frame_);
+    auto command_buffer = command_allocator_->AllocatePrimary();
+    vk::CommandBufferBeginInfo begin_info{};
+    begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    command_buffer.begin(begin_info);
+    for (auto& [canvas_id, canvas] : acquired) {
+        BeginRenderPass(command_buffer, *canvas);
+        if (record) {
+            record(canvas_id, command_buffer, canvas->swapchain_->Extent());
+        }
+        command_buffer.endRenderPass();
+    }
+    command_buffer.end();
+
+    std::vector<vk::Semaphore> wait_semaphores;
+    std::vector<vk::PipelineStageFlags> wait_stages;
+    std::vector<vk::Semaphore> signal_semaphores;
+    std::vector<vk::SwapchainKHR> swapchains;
+    std::vector<uint32_t> image_indices;
+    std::vector<Canvas*> presented;
+    for (auto& [canvas_id, canvas] : acquired) {
+        if (canvas->swapchain_->GetBackend() == NVulkanSwapchain::Backend::eOffscreen) {
+            continue;
+        }
+        wait_semaphores.push_back(canvas->image_available_semaphores_[current_frame_]);
+        wait_stages.emplace_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+        signal_semaphores.push_back(canvas->render_finished_semaphores_[current_frame_]);
+        swapchains.push_back(canvas->swapchain_->Handle());
+        image_indices.push_back(canvas->image_index_);
+        presented.push_back(canvas);
+    }
+    vk::SubmitInfo submit_info{};
+    submit_info
+        .setCommandBuffers(command_buffer)
+        .setWaitSemaphores(wait_semaphores)
+        .setWaitDstStageMask(wait_stages)
+        .setSignalSemaphores(signal_semaphores);
+    device.ResetFence(fence);
+    device.SubmitGraphics(submit_info, fence);
+    ++submissions_;
+    for (auto& [canvas_id, canvas] : acquired) {
+        canvas->swapchain_->MarkSubmitted(fence, canvas->image_index_, submissions_);
+    }
+
+    if (!swapchains.empty()) {
+        std::vector<vk::Result> results(swapchains.size(), vk::Result::eSuccess);
+        vk::PresentInfoKHR present_info{};
+        present_info
+            .setWaitSemaphores(signal_semaphores)
+            .setSwapchains(swapchains)
+            .setImageIndices(image_indices)
+            .setResults(results);
+        device.Present(present_info);
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i] == vk::Result::eErrorOutOfDateKHR || results[i] == vk::Result::eSuboptimalKHR) {
+                presented[i]->is_resized_ = true;
+            } else if (results[i] != vk::Result::eSuccess) {
+                throw std::runtime_error("Failed to present swapchain image.");
+            }
+        }
+    }
+    current_frame_ = (current_frame_ + 1) % frames_in_flight_;
+    return acquired.size();
+}
+
+NVulkanMultiRender::CanvasID NVulkanMultiRender::InsertCanvas(std::unique_ptr<NVulkanSwapchain> swapchain, uint32_t width, uint32_t height, uint32_t refresh_rate) {
+    Canvas canvas{};
+    canvas.swapchain_ = std::move(swapchain);
+    canvas.extent_ = vk::Extent2D{width, height};
+    canvas.interval_ = Interval(refresh_rate);
+    canvas.next_present_time_ = std::chrono::steady_clock::now();
+    vk::SemaphoreCreateInfo semaphore_info{};
+    canvas.image_available_semaphores_.resize(frames_in_flight_);
+    canvas.render_finished_semaphores_.resize(frames_in_flight_);
+    for (uint32_t i = 0; i < frames_in_flight_; ++i) {
+        canvas.image_available_semaphores_[i] = NVulkanDevice::Singleton().CreateSemaphore(semaphore_info);
+        canvas.render_finished_semaphores_[i] = NVulkanDevice::Singleton().CreateSemaphore(semaphore_info);
+    }
+    auto canvas_id = next_canvas_id_++;
+    canvases_.emplace(canvas_id, std::move(canvas));
+    return canvas_id;
+}
+
+bool NVulkanMultiRender::IsDue(const Canvas& canvas, std::chrono::steady_clock::time_point now) const {
+    if (canvas.extent_.width == 0 || canvas.extent_.height == 0) {
+        return false;
+    }
+    return canvas.interval_.count() == 0 || now >= canvas.next_present_time_;
+}
+
+void NVulkanMultiRender::BeginRenderPass(const vk::CommandBuffer& command_buffer, const Canvas& canvas) const {
+    const auto& extent = canvas.swapchain_->Extent();
+    std::array<vk::ClearValue, 2> clear_values{};
+    clear_values[0].setColor(vk::ClearColorValue(std::array<float, 4>{0.0F, 0.0F, 0.0F, 1.0F}));
+    clear_values[1].setDepthStencil({1.0F, 0});
+    vk::RenderPassBeginInfo render_pass_info{};
+    render_pass_info
+        .setRenderPass(canvas.swapchain_->RenderPass())
+        .setFramebuffer(canvas.swapchain_->Framebuffer(canvas.image_index_))
+        .setRenderArea({{0, 0}, extent})
+        .setClearValues(clear_values);
+    command_buffer.beginRenderPass(render_pass_info, vk::SubpassContents::eInline);
+    vk::Viewport viewport{0.0F, 0.0F, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0F, 1.0F};
+    vk::Rect2D scissor{{0, 0}, extent};
+    command_buffer.setViewport(0, viewport);
+    command_buffer.setScissor(0, scissor);
+}
+
+std::chrono::steady_clock::duration NVulkanMultiRender::Interval(uint32_t refresh_rate) {
+    if (refresh_rate == 0) {
+        return std::chrono::steady_clock::duration::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / refresh_rate));
+}
+
+void NVulkanMultiRender::DestroyCanvas(Canvas& canvas) {
+    for (size_t i = 0; i < canvas.image_available_semaphores_.size(); ++i) {
+        NVulkanDevice::Singleton().DestroySemaphore(canvas.image_available_semaphores_[i]);
+        NVulkanDevice::Singleton().DestroySemaphore(canvas.render_finished_semaphores_[i]);
+    }
+    canvas.image_available_semaphores_.clear();
+    canvas.render_finished_semaphores_.clear();
+    canvas.swapchain_.reset();
+}
@@ -16,20 +16,61 @@ NVulkanPhysical::NVulkanPhysical() {
     for (const auto& device : devices) {
         if (IsPhysicalDeviceSuitable(device)) {
             physical_ = device;
+            CreateCapabilities();
+            for (const auto* extension : optional_device_extensions_) {
+                if (HasExtension(extension)) {
+                    device_extensions_.push_back(extension);
+                }
+            }
+            if (HasExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+                get_memory_properties2_ = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(NVulkanInstance::Singleton().GetProcAddr("vkGetPhysicalDeviceMemoryProperties2KHR"));
+            }
+            if (HasExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+                QueryDescriptorIndexing();
+            }
             return;
         }
     }
     throw std::runtime_error("Failed to find a suitable GPU.");
 }
 
-NVulkanPhysical::QueueFamilyIndices NVulkanPhysical::QueueFamilies() const {
-    return FindQueueFamilies(physical_);
+const NVulkanPhysical::Capabilities& NVulkanPhysical::GetCapabilities() const {
+    return capabilities_;
+}
+
+const NVulkanPhysical::QueueFamilyIndices& NVulkanPhysical::QueueFamilies() const {
+    return capabilities_.queue_families_;
 }
 
 const std::vector<const char*>& NVulkanPhysical::DeviceExtensions() const {
     return device_extensions_;
 }
 
+bool NVulkanPhysical::HasExtension(const char* name) const {
+    for (const auto& extension : capabilities_.extensions_) {
+        if (std::string(extension.extensionName.data()) == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NVulkanPhysical::QueryMemoryBudget(vk::PhysicalDeviceMemoryBudgetPropertiesEXT& budget) const {
+    if (!get_memory_properties2_) {
+        return false;
+    }
+    vk::PhysicalDeviceMemoryProperties2 properties{};
+    properties.setPNext(&budget);
+    get_memory_properties2_(static_cast<VkPhysicalDevice>(physical_), reinterpret_cast<VkPhysicalDeviceMemoryProperties2*>(&properties));
+    return true;
+}
+
+bool NVulkanPhysical::HasBindlessSupport() const {
+    const auto& features = capabilities_.descriptor_indexing_features_;
+    return features.runtimeDescriptorArray && features.descriptorBindingPartiallyBound && features.descriptorBindingUpdateUnusedWhilePending &&
+           features.descriptorBindingSampledImageUpdateAfterBind && features.descriptorBindingStorageBufferUpdateAfterBind && features.shaderSampledImageArrayNonUniformIndexing;
+}
+
 vk::Device NVulkanPhysical::CreateDevice(const vk::DeviceCreateInfo& info) {
     return physical_.createDevice(info);
 }
@@ -42,16 +83,31 @@ NVulkanPhysical::SwapchainSupportDetails NVulkanPhysical::QuerySwapchainSupport(
     return details;
 }
 
-vk::FormatProperties NVulkanPhysical::GetFormatProperties(const vk::Format& format) {
+vk::FormatProperties NVulkanPhysical::GetFormatProperties(const vk::Format& format) const {
+    auto index = static_cast<uint32_t>(format);
+    if (index < capabilities_.format_properties_.size()) {
+        return capabilities_.format_properties_[index];
+    }
     return physical_.getFormatProperties(format);
 }
 
-vk::PhysicalDeviceMemoryProperties NVulkanPhysical::GetMemoryProperties() {
-    return physical_.getMemoryProperties();
+bool NVulkanPhysical::IsFormatSupported(const vk::Format& format, vk::ImageTiling tiling, const vk::FormatFeatureFlags& features) const {
+    auto properties = GetFormatProperties(format);
+    if (tiling == vk::ImageTiling::eLinear) {
+        return (properties.linearTilingFeatures & features) == features;
+    }
+    if (tiling == vk::ImageTiling::eOptimal) {
+        return (properties.optimalTilingFeatures & features) == features;
+    }
+    return false;
+}
+
+const vk::PhysicalDeviceMemoryProperties& NVulkanPhysical::GetMemoryProperties() const {
+    return capabilities_.memory_properties_;
 }
 
 bool NVulkanPhysical::IsPhysicalDeviceSuitable(const vk::PhysicalDevice& device) const {
-    auto indices = FindQueueFamilies(device);
+    auto indices = FindQueueFamilies(device, device.getQueueFamilyProperties());
     auto available_extensions = device.enumerateDeviceExtensionProperties();
     std::unordered_set<std::string> required_extensions{device_extensions_.begin(), device_extensions_.end()};
     for (const auto& extension : available_extensions) {
@@ -62,9 +118,8 @@ bool NVulkanPhysical::IsPhysicalDeviceSuitable(const vk::PhysicalDevice& device)
     return indices && extensions_supported && supported_features.samplerAnisotropy;
 }
 
-NVulkanPhysical::QueueFamilyIndices NVulkanPhysical::FindQueueFamilies(const vk::PhysicalDevice& device) const {
+NVulkanPhysical::QueueFamilyIndices NVulkanPhysical::FindQueueFamilies(const vk::PhysicalDevice& device, const std::vector<vk::QueueFamilyProperties>& properties) const {
     QueueFamilyIndices indices;
-    auto properties = device.getQueueFamilyProperties();
     for (size_t i = 0; i < properties.size(); ++i) {
         const auto& property = properties[i];
         if (property.queueFlags & vk::QueueFlagBits::eGraphics) {
@@ -76,10 +131,75 @@ NVulkanPhysical::QueueFamilyIndices NVulkanPhysical::FindQueueFamilies(const vk:
             indices.present_family_ = static_cast<uint32_t>(i);
             indices.has_present_family_ = true;
         }
+#else
+        if (indices.has_graphics_family_) {
+            indices.present_family_ = indices.graphics_family_;
+            indices.has_present_family_ = true;
+        }
 #endif
         if (indices) {
             break;
         }
     }
+    indices.transfer_family_ = indices.graphics_family_;
+    auto best_score = 0;
+    for (size_t i = 0; i < properties.size(); ++i) {
+        const auto& flags = properties[i].queueFlags;
+        if (!(flags & vk::QueueFlagBits::eTransfer) || (flags & vk::QueueFlagBits::eGraphics)) {
+            continue;
+        }
+        // A transfer-only family maps to the copy engines; a compute family is the next best thing.
+        auto score = (flags & vk::QueueFlagBits::eCompute) ? 1 : 2;
+        if (score > best_score) {
+            best_score = score;
+            indices.transfer_family_ = static_cast<uint32_t>(i);
+        }
+    }
+    indices.compute_family_ = indices.graphics_family_;
+    best_score = 0;
+    for (size_t i = 0; i < properties.size(); ++i) {
+        const auto& flags = properties[i].queueFlags;
+        if (!(flags & vk::QueueFlagBits::eCompute) || (flags & vk::QueueFlagBits::eGraphics)) {
+            continue;
+        }
+        // Prefer a family the uploader does not use, or one with a second queue for compute to own.
+        auto score = static_cast<uint32_t>(i) != indices.transfer_family_ ? 3 : (properties[i].queueCount > 1 ? 2 : 1);
+        if (score > best_score) {
+            best_score = score;
+            indices.compute_family_ = static_cast<uint32_t>(i);
+        }
+    }
+    if (indices.HasAsyncCompute() && indices.compute_family_ == indices.transfer_family_ && properties[indices.compute_family_].queueCount > 1) {
+        indices.compute_queue_index_ = 1;
+    }
     return indices;
 }
+
+void NVulkanPhysical::CreateCapabilities() {
+    capabilities_.properties_ = physical_.getProperties();
+    capabilities_.features_ = physical_.getFeatures();
+    capabilities_.memory_properties_ = physical_.getMemoryProperties();
+    capabilities_.queue_family_properties_ = physical_.getQueueFamilyProperties();
+    capabilities_.queue_families_ = FindQueueFamilies(physical_, capabilities_.queue_family_properties_);
+    capabilities_.extensions_ = physical_.enumerateDeviceExtensionProperties();
+    capabilities_.format_properties_.resize(CORE_FORMAT_COUNT);
+    for (uint32_t i = 0; i < CORE_FORMAT_COUNT; ++i) {
+        capabilities_.format_properties_[i] = physical_.getFormatProperties(static_cast<vk::Format>(i));
+    }
+}
+
+void NVulkanPhysical::QueryDescriptorIndexing() {
+    auto get_features2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(NVulkanInstance::Singleton().GetProcAddr("vkGetPhysicalDeviceFeatures2KHR"));
+    auto get_properties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(NVulkanInstance::Singleton().GetProcAddr("vkGetPhysicalDeviceProperties2KHR"));
+    if (!get_features2 || !get_properties2) {
+        return;
+    }
+    vk::PhysicalDeviceFeatures2 features{};
+    features.setPNext(&capabilities_.descriptor_indexing_features_);
+    get_features2(static_cast<VkPhysicalDevice>(physical_), reinterpret_cast<VkPhysicalDeviceFeatures2*>(&features));
+    vk::PhysicalDeviceProperties2 properties{};
+    properties.setPNext(&capabilities_.descriptor_indexing_properties_);
+    get_properties2(static_cast<VkPhysicalDevice>(physical_), reinterpret_cast<VkPhysicalDeviceProperties2*>(&properties));
+    capabilities_.descriptor_indexing_features_.setPNext(nullptr);
+    capabilities_.descriptor_indexing_properties_.setPNext(nullptr);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file NVulkanPipeline.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanPipeline.h"
+
+#include <functional>
+#include <string_view>
+
+#include "NVulkanDevice.h"
+
+template <typename T>
+static void HashCombine(size_t& seed, const T& value) {
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+static void HashBytes(size_t& seed, const T* data, size_t count) {
+    HashCombine(seed, std::string_view(reinterpret_cast<const char*>(data), count * sizeof(T)));
+}
+
+size_t NVulkanPipelineState::Hash() const {
+    size_t seed{0};
+    for (const auto& stage : stages_) {
+        HashCombine(seed, static_cast<uint32_t>(stage.stage_));
+        HashBytes(seed, stage.code_.data(), stage.code_.size());
+        HashCombine(seed, stage.entry_);
+    }
+    HashBytes(seed, vertex_bindings_.data(), vertex_bindings_.size());
+    HashBytes(seed, vertex_attributes_.data(), vertex_attributes_.size());
+    HashCombine(seed, static_cast<uint32_t>(topology_));
+    HashCombine(seed, static_cast<uint32_t>(polygon_mode_));
+    HashCombine(seed, static_cast<uint32_t>(cull_mode_));
+    HashCombine(seed, static_cast<uint32_t>(front_face_));
+    HashCombine(seed, depth_test_);
+    HashCombine(seed, depth_write_);
+    HashCombine(seed, static_cast<uint32_t>(depth_compare_op_));
+    HashCombine(seed, stencil_test_);
+    HashBytes(seed, &stencil_front_, 1);
+    HashBytes(seed, &stencil_back_, 1);
+    HashCombine(seed, blend_);
+    HashCombine(seed, static_cast<uint32_t>(color_write_mask_));
+    for (const auto& layout : descriptor_set_layouts_) {
+        HashCombine(seed, static_cast<VkDescriptorSetLayout>(layout));
+    }
+    HashBytes(seed, push_constant_ranges_.data(), push_constant_ranges_.size());
+    HashCombine(seed, static_cast<VkRenderPass>(render_pass_));
+    HashCombine(seed, subpass_);
+    return seed;
+}
+
+size_t NVulkanComputePipelineState::Hash() const {
+    size_t seed{0};
+    HashCombine(seed, static_cast<uint32_t>(stage_.stage_));
+    HashBytes(seed, stage_.code_.data(), stage_.code_.size());
+    HashCombine(seed, stage_.entry_);
+    for (const auto& layout : descriptor_set_layouts_) {
+        HashCombine(seed, static_cast<VkDescriptorSetLayout>(layout));
+    }
+    HashBytes(seed, push_constant_ranges_.data(), push_constant_ranges_.size());
+    return seed;
+}
+
+NVulkanPipeline::NVulkanPipeline(const vk::Pipeline& pipeline, const vk::PipelineLayout& layout, vk::PipelineBindPoint bind_point)
+    : pipeline_(pipeline), layout_(layout), bind_point_(bind_point) {
+}
+
+NVulkanPipeline::~NVulkanPipeline() {
+    // The layout is shared through NVulkanPipelineManager, which destroys it.
+    NVulkanDevice::Singleton().DestroyPipeline(pipeline_);
+}
+
+const vk::Pipeline& NVulkanPipeline::Pipeline() const {
+    return pipeline_;
+}
+
+const vk::PipelineLayout& NVulkanPipeline::Layout() const {
+    return layout_;
+}
+
+void NVulkanPipeline::Bind(const vk::CommandBuffer& command_buffer) const {
+    command_buffer.bindPipeline(bind_point_, pipeline_);
+}
@@ -0,0 +1,319 @@
+/**
+ * @file NVulkanPipelineManager.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanPipelineManager.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "NVulkanDevice.h"
+#include "NVulkanPhysical.h"
+
+static void DestroyShaderModules(const std::vector<vk::ShaderModule>& modules) {
+    for (const auto& module : modules) {
+        NVulkanDevice::Singleton().DestroyShaderModule(module);
+    }
+}
+
+NVulkanPipelineManager::NVulkanPipelineManager() {
+    std::error_code error{};
+    cache_directory_ = std::filesystem::temp_directory_path(error) / "Nt";
+    LoadCache();
+}
+
+NVulkanPipelineManager::~NVulkanPipelineManager() {
+    SaveCache();
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    pipelines_.clear();
+    compute_pipelines_.clear();
+    for (const auto& [key, layout] : layouts_) {
+        device.DestroyPipelineLayout(layout);
+    }
+    device.DestroyPipelineCache(pipeline_cache_);
+}
+
+std::shared_ptr<NVulkanPipeline> NVulkanPipelineManager::CreateGraphicsPipeline(const NVulkanPipelineState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto hash = state.Hash();
+    auto cached = pipelines_.find(hash);
+    if (cached != pipelines_.end()) {
+        for (const auto& [cached_state, pipeline] : cached->second) {
+            if (cached_state == state) {
+                return pipeline;
+            }
+        }
+    }
+
+    vk::PipelineVertexInputStateCreateInfo vertex_input_info{};
+    vertex_input_info
+        .setVertexBindingDescriptions(state.vertex_bindings_)
+        .setVertexAttributeDescriptions(state.vertex_attributes_);
+
+    vk::PipelineInputAssemblyStateCreateInfo input_assembly_info{};
+    input_assembly_info
+        .setTopology(state.topology_)
+        .setPrimitiveRestartEnable(false);
+
+    vk::PipelineViewportStateCreateInfo viewport_info{};
+    viewport_info
+        .setViewportCount(1)
+        .setScissorCount(1);
+
+    vk::PipelineRasterizationStateCreateInfo rasterization_info{};
+    rasterization_info
+        .setPolygonMode(state.polygon_mode_)
+        .setCullMode(state.cull_mode_)
+        .setFrontFace(state.front_face_)
+        .setLineWidth(1.0F);
+
+    vk::PipelineMultisampleStateCreateInfo multisample_info{};
+    multisample_info.setRasterizationSamples(vk::SampleCountFlagBits::e1);
+
+    vk::PipelineDepthStencilStateCreateInfo depth_stencil_info{};
+    depth_stencil_info
+        .setDepthTestEnable(state.depth_test_)
+        .setDepthWriteEnable(state.depth_write_)
+        .setDepthCompareOp(state.depth_compare_op_)
+        .setStencilTestEnable(state.stencil_test_)
+        .setFront(state.stencil_front_)
+        .setBack(state.stencil_back_);
+
+    vk::PipelineColorBlendAttachmentState color_blend_attachment{};
+    color_blend_attachment
+        .setBlendEnable(state.blend_)
+        .setSrcColorBlendFactor(vk::BlendFactor::eSrcAlpha)
+        .setDstColorBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
+        .setColorBlendOp(vk::BlendOp::eAdd)
+        .setSrcAlphaBlendFactor(vk::BlendFactor::eOne)
+        .setDstAlphaBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
+        .setAlphaBlendOp(vk::BlendOp::eAdd)
+        .setColorWriteMask(state.color_write_mask_);
+    vk::PipelineColorBlendStateCreateInfo color_blend_info{};
+    color_blend_info.setAttachments(color_blend_attachment);
+
+    std::array<vk::DynamicState, 2> dynamic_states{vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+    vk::PipelineDynamicStateCreateInfo dynamic_state_info{};
+    dynamic_state_info.setDynamicStates(dynamic_states);
+
+    auto layout = GetPipelineLayout(state.descriptor_set_layouts_, state.push_constant_ranges_);
+    vk::GraphicsPipelineCreateInfo pipeline_info{};
+    pipeline_info
+        .setPVertexInputState(&vertex_input_info)
+        .setPInputAssemblyState(&input_assembly_info)
+        .setPViewportState(&viewport_info)
+        .setPRasterizationState(&rasterization_info)
+        .setPMultisampleState(&multisample_info)
+        .setPDepthStencilState(&depth_stencil_info)
+        .setPColorBlendState(&color_blend_info)
+        .setPDynamicState(&dynamic_state_info)
+        .setLayout(layout)
+        .setRenderPass(state.render_pass_)
+        .setSubpass(state.subpass_);
+
+    std::vector<vk::ShaderModule> modules;
+    std::vector<vk::PipelineShaderStageCreateInfo> stages;
+    vk::Pipeline pipeline{};
+    try {
+        for (const auto& stage : state.stages_) {
+            vk::ShaderModuleCreateInfo module_info{};
+            module_info.setCode(stage.code_);
+            modules.push_back(NVulkanDevice::Singleton().CreateShaderModule(module_info));
+            vk::PipelineShaderStageCreateInfo stage_info{};
+            stage_info
+                .setStage(stage.stage_)
+                .setModule(modules.back())
+                .setPName(stage.entry_.c_str());
+            stages.push_back(stage_info);
+        }
+        pipeline_info.setStages(stages);
+        pipeline = NVulkanDevice::Singleton().CreateGraphicsPipeline(pipeline_cache_, pipeline_info);
+    } catch (...) {
+        DestroyShaderModules(modules);
+        throw;
+    }
+    DestroyShaderModules(modules);
+    is_cache_dirty_ = true;
+    auto result = std::make_shared<NVulkanPipeline>(pipeline, layout, vk::PipelineBindPoint::eGraphics);
+    pipelines_[hash].emplace_back(state, result);
+    return result;
+}
+
+std::shared_ptr<NVulkanPipeline> NVulkanPipelineManager::CreateComputePipeline(const NVulkanComputePipelineState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto hash = state.Hash();
+    auto cached = compute_pipelines_.find(hash);
+    if (cached != compute_pipelines_.end()) {
+        for (const auto& [cached_state, pipeline] : cached->second) {
+            if (cached_state == state) {
+                return pipeline;
+            }
+        }
+    }
+
+    if (state.stage_.stage_ != vk::ShaderStageFlagBits::eCompute) {
+        throw std::runtime_error("A compute pipeline needs a compute shader stage.");
+    }
+    auto layout = GetPipelineLayout(state.descriptor_set_layouts_, state.push_constant_ranges_);
+    vk::ShaderModuleCreateInfo module_info{};
+    module_info.setCode(state.stage_.code_);
+    auto module = NVulkanDevice::Singleton().CreateShaderModule(module_info);
+    vk::Pipeline pipeline{};
+    try {
+        vk::PipelineShaderStageCreateInfo stage_info{};
+        stage_info
+            .setStage(vk::ShaderStageFlagBits::eCompute)
+            .setModule(module)
+            .setPName(state.stage_.entry_.c_str());
+        vk::ComputePipelineCreateInfo pipeline_info{};
+        pipeline_info
+            .setStage(stage_info)
+            .setLayout(layout);
+        pipeline = NVulkanDevice::Singleton().CreateComputePipeline(pipeline_cache_, pipeline_info);
+    } catch (...) {
+        NVulkanDevice::Singleton().DestroyShaderModule(module);
+        throw;
+    }
+    NVulkanDevice::Singleton().DestroyShaderModule(module);
+    is_cache_dirty_ = true;
+    auto result = std::make_shared<NVulkanPipeline>(pipeline, layout, vk::PipelineBindPoint::eCompute);
+    compute_pipelines_[hash].emplace_back(state, result);
+    return result;
+}
+
+void NVulkanPipelineManager::SetCacheDirectory(const std::filesystem::path& directory) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_directory_ = directory;
+    }
+    LoadCache();
+}
+
+void NVulkanPipelineManager::SaveCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_cache_dirty_ || cache_directory_.empty()) {
+        return;
+    }
+    auto data = NVulkanDevice::Singleton().GetPipelineCacheData(pipeline_cache_);
+    auto header = MakeCacheHeader(data.size());
+    std::error_code error{};
+    std::filesystem::create_directories(cache_directory_, error);
+    auto path = CachePath();
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            return;
+        }
+    }
+    std::filesystem::rename(temp_path, path, error);
+    if (!error) {
+        is_cache_dirty_ = false;
+    }
+}
+
+std::vector<uint32_t> NVulkanPipelineManager::LoadShader(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open shader: " + path.string() + ".");
+    }
+    auto size = static_cast<size_t>(file.tellg());
+    if (size == 0 || size % sizeof(uint32_t) != 0) {
+        throw std::runtime_error("Invalid SPIR-V shader: " + path.string() + ".");
+    }
+    std::vector<uint32_t> code(size / sizeof(uint32_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(size));
+    return code;
+}
+
+std::filesystem::path NVulkanPipelineManager::CachePath() const {
+    const auto& properties = NVulkanPhysical::Singleton().GetCapabilities().properties_;
+    static constexpr char HEX[]{"0123456789abcdef"};
+    std::string name{"pipeline_"};
+    for (auto byte : properties.pipelineCacheUUID) {
+        name.push_back(HEX[byte >> 4]);
+        name.push_back(HEX[byte & 0xF]);
+    }
+    name += "_" + std::to_string(properties.driverVersion) + ".bin";
+    return cache_directory_ / name;
+}
+
+bool NVulkanPipelineManager::LoadCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<char> data;
+    std::ifstream file(CachePath(), std::ios::binary | std::ios::ate);
+    if (file) {
+        auto size = static_cast<size_t>(file.tellg());
+        CacheHeader header{};
+        if (size >= sizeof(header)) {
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            auto expected = MakeCacheHeader(size - sizeof(header));
+            if (file && std::memcmp(&header, &expected, sizeof(header)) == 0) {
+                data.resize(size - sizeof(header));
+                file.read(data.data(), static_cast<std::streamsize>(data.size()));
+                if (!file) {
+                    data.clear();
+                }
+            }
+        }
+    }
+    vk::PipelineCacheCreateInfo cache_info{};
+    cache_info
+        .setInitialDataSize(data.size())
+        .setPInitialData(data.data());
+    if (!pipeline_cache_) {
+        pipeline_cache_ = NVulkanDevice::Singleton().CreatePipelineCache(cache_info);
+        return !data.empty();
+    }
+    if (data.empty()) {
+        is_cache_dirty_ = true;
+        return false;
+    }
+    auto loaded_cache = NVulkanDevice::Singleton().CreatePipelineCache(cache_info);
+    NVulkanDevice::Singleton().MergePipelineCaches(pipeline_cache_, loaded_cache);
+    NVulkanDevice::Singleton().DestroyPipelineCache(loaded_cache);
+    is_cache_dirty_ = true;
+    return true;
+}
+
+vk::PipelineLayout NVulkanPipelineManager::GetPipelineLayout(const std::vector<vk::DescriptorSetLayout>& set_layouts, const std::vector<vk::PushConstantRange>& push_constant_ranges) {
+    for (const auto& [key, layout] : layouts_) {
+        if (key.first == set_layouts && key.second == push_constant_ranges) {
+            return layout;
+        }
+    }
+    vk::PipelineLayoutCreateInfo layout_info{};
+    layout_info
+        .setSetLayouts(set_layouts)
+        .setPushConstantRanges(push_constant_ranges);
+    auto layout = NVulkanDevice::Singleton().CreatePipelineLayout(layout_info);
+    layouts_.emplace_back(std::make_pair(set_layouts, push_constant_ranges), layout);
+    return layout;
+}
+
+NVulkanPipelineManager::CacheHeader NVulkanPipelineManager::MakeCacheHeader(uint64_t data_size) const {
+    const auto& properties = NVulkanPhysical::Singleton().GetCapabilities().properties_;
+    CacheHeader header{};
+    header.magic_ = CACHE_MAGIC;
+    header.version_ = CACHE_VERSION;
+    header.vendor_id_ = properties.vendorID;
+    header.device_id_ = properties.deviceID;
+    header.driver_version_ = properties.driverVersion;
+    std::memcpy(header.uuid_, properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+    header.data_size_ = data_size;
+    return header;
+}
@@ -0,0 +1,279 @@
+/**
+ * @file NVulkanPrimitiveRenderer.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanPrimitiveRenderer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "NProfiler.h"
+#include "NVulkanDevice.h"
+#include "NVulkanPipelineManager.h"
+#include "NVulkanShaderLibrary.h"
+
+NVulkanPrimitiveRenderer::NVulkanPrimitiveRenderer(const vk::RenderPass& render_pass, uint32_t frames_in_flight)
+    : frames_((std::max)(frames_in_flight, 1U)) {
+    CreateDescriptors();
+    CreatePipelines(render_pass);
+}
+
+NVulkanPrimitiveRenderer::~NVulkanPrimitiveRenderer() {
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    for (auto& frame : frames_) {
+        if (frame.buffer_) {
+            device.DestroyBuffer(frame.buffer_, frame.allocation_);
+        }
+        if (frame.mesh_buffer_) {
+            device.DestroyBuffer(frame.mesh_buffer_, frame.mesh_allocation_);
+        }
+    }
+    device.DestroyDescriptorPool(descriptor_pool_);
+    device.DestroyDescriptorSetLayout(descriptor_set_layout_);
+}
+
+NTextureID NVulkanPrimitiveRenderer::RegisterTexture(const vk::ImageView& image_view, const vk::Sampler& sampler) {
+    vk::DescriptorSetAllocateInfo alloc_info{};
+    alloc_info
+        .setDescriptorPool(descriptor_pool_)
+        .setSetLayouts(descriptor_set_layout_);
+    auto descriptor_set = NVulkanDevice::Singleton().AllocateDescriptorSets(alloc_info).front();
+    vk::DescriptorImageInfo image_info{sampler, image_view, vk::ImageLayout::eShaderReadOnlyOptimal};
+    vk::WriteDescriptorSet write{};
+    write
+        .setDstSet(descriptor_set)
+        .setDstBinding(0)
+        .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+        .setImageInfo(image_info);
+    NVulkanDevice::Singleton().UpdateDescriptorSets({write});
+    auto texture = next_texture_id_++;
+    textures_.emplace(texture, descriptor_set);
+    return texture;
+}
+
+void NVulkanPrimitiveRenderer::UnregisterTexture(NTextureID texture) {
+    auto it = textures_.find(texture);
+    if (it == textures_.end()) {
+        return;
+    }
+    // Frames in flight may still sample through the set.
+    retired_.push_back({it->second, frame_});
+    textures_.erase(it);
+}
+
+void NVulkanPrimitiveRenderer::Prepare(NDrawList& draw_list, size_t frame_index) {
+    N_PROFILE_ZONE("NVulkanPrimitiveRenderer::Prepare");
+    draw_list.Finish();
+    ++frame_;
+    auto retired_end = std::partition(retired_.begin(), retired_.end(), [this](const Retired& retired) {
+        return retired.frame_ + RETIRE_FRAMES > frame_;
+    });
+    if (retired_end != retired_.end()) {
+        std::vector<vk::DescriptorSet> descriptor_sets{};
+        for (auto it = retired_end; it != retired_.end(); ++it) {
+            descriptor_sets.push_back(it->descriptor_set_);
+        }
+        NVulkanDevice::Singleton().FreeDescriptorSets(descriptor_pool_, descriptor_sets);
+        retired_.erase(retired_end, retired_.end());
+    }
+    // Frames in flight may have been raised since construction; a shared slot would overwrite buffers the GPU still reads.
+    if (frame_index >= frames_.size()) {
+        frames_.resize(frame_index + 1);
+    }
+    current_frame_ = frame_index;
+    auto& frame = frames_[current_frame_];
+    const auto& instances = draw_list.Instances();
+    batches_ = draw_list.Batches();
+    draw_call_count_ = 0;
+    if (instances.empty()) {
+        return;
+    }
+    EnsureCapacity(frame.buffer_, frame.allocation_, frame.capacity_, instances.size(), sizeof(NDrawInstance));
+    std::memcpy(frame.allocation_.mapped_, instances.data(), instances.size() * sizeof(NDrawInstance));
+
+    // Cached meshes are copied, never tessellated again.
+    const auto& meshes = draw_list.Meshes();
+    meshes_.resize(meshes.size());
+    uint32_t vertex_count = 0;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        meshes_[i] = {vertex_count, meshes[i]->fill_vertex_count_, meshes[i]->fill_rule_};
+        vertex_count += static_cast<uint32_t>(meshes[i]->vertices_.size());
+    }
+    if (vertex_count == 0) {
+        return;
+    }
+    EnsureCapacity(frame.mesh_buffer_, frame.mesh_allocation_, frame.mesh_capacity_, vertex_count, sizeof(NPoint));
+    auto* vertices = static_cast<NPoint*>(frame.mesh_allocation_.mapped_);
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        std::memcpy(vertices + meshes_[i].first_vertex_, meshes[i]->vertices_.data(), meshes[i]->vertices_.size() * sizeof(NPoint));
+    }
+}
+
+void NVulkanPrimitiveRenderer::Draw(const vk::CommandBuffer& command_buffer, const vk::Extent2D& extent) const {
+    Draw(command_buffer, extent, vk::Rect2D{{0, 0}, extent});
+}
+
+void NVulkanPrimitiveRenderer::Draw(const vk::CommandBuffer& command_buffer, const vk::Extent2D& extent, const vk::Rect2D& scissor) const {
+    if (batches_.empty() || extent.width == 0 || extent.height == 0) {
+        return;
+    }
+    NRect clip{static_cast<float>(scissor.offset.x), static_cast<float>(scissor.offset.y), static_cast<float>(scissor.extent.width), static_cast<float>(scissor.extent.height)};
+    const auto& frame = frames_[current_frame_];
+    if (meshes_.empty()) {
+        command_buffer.bindVertexBuffers(0, frame.buffer_, vk::DeviceSize{0});
+    } else {
+        command_buffer.bindVertexBuffers(0, {frame.buffer_, frame.mesh_buffer_}, {vk::DeviceSize{0}, vk::DeviceSize{0}});
+    }
+    PushConstants push_constants{{2.0F / static_cast<float>(extent.width), 2.0F / static_cast<float>(extent.height)}, {-1.0F, -1.0F}};
+    // All pipelines share one layout, so the push constants survive pipeline switches.
+    command_buffer.pushConstants(shape_pipeline_->Layout(), vk::ShaderStageFlagBits::eVertex, 0, sizeof(push_constants), &push_constants);
+    const NVulkanPipeline* bound_pipeline = nullptr;
+    auto bind = [&command_buffer, &bound_pipeline](const NVulkanPipeline* pipeline) {
+        if (pipeline != bound_pipeline) {
+            pipeline->Bind(command_buffer);
+            bound_pipeline = pipeline;
+        }
+    };
+    NTextureID bound_texture = 0;
+    for (const auto& batch : batches_) {
+        if (!batch.bounds_.Intersects(clip)) {
+            continue;
+        }
+        if (batch.pipeline_ == NDrawPipeline::ePath) {
+            const auto& mesh = meshes_[batch.texture_];
+            bind(path_pipeline_.get());
+            command_buffer.draw(mesh.fill_vertex_count_, batch.instance_count_, mesh.first_vertex_, batch.first_instance_);
+            ++draw_call_count_;
+            continue;
+        }
+        if (batch.pipeline_ == NDrawPipeline::eStencilPath) {
+            // Each instance marks its coverage, then the cover quad fills it and clears the stencil again.
+            const auto& mesh = meshes_[batch.texture_];
+            const auto* stencil_pipeline = mesh.fill_rule_ == NFillRule::eEvenOdd ? stencil_even_odd_pipeline_.get() : stencil_non_zero_pipeline_.get();
+            for (uint32_t i = 0; i < batch.instance_count_; ++i) {
+                bind(stencil_pipeline);
+                command_buffer.draw(mesh.fill_vertex_count_, 1, mesh.first_vertex_, batch.first_instance_ + i);
+                bind(cover_pipeline_.get());
+                command_buffer.draw(6, 1, mesh.first_vertex_ + mesh.fill_vertex_count_, batch.first_instance_ + i);
+            }
+            draw_call_count_ += 2 * batch.instance_count_;
+            continue;
+        }
+        const auto* pipeline = shape_pipeline_.get();
+        if (batch.pipeline_ == NDrawPipeline::eImage) {
+            pipeline = image_pipeline_.get();
+        } else if (batch.pipeline_ == NDrawPipeline::eText) {
+            pipeline = text_pipeline_.get();
+        }
+        if (batch.pipeline_ != NDrawPipeline::eShape) {
+            auto it = textures_.find(batch.texture_);
+            if (it == textures_.end()) {
+                continue;
+            }
+            if (batch.texture_ != bound_texture) {
+                command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->Layout(), 0, it->second, {});
+                bound_texture = batch.texture_;
+            }
+        }
+        bind(pipeline);
+        command_buffer.draw(4, batch.instance_count_, 0, batch.first_instance_);
+        ++draw_call_count_;
+    }
+}
+
+size_t NVulkanPrimitiveRenderer::DrawCallCount() const {
+    return draw_call_count_;
+}
+
+void NVulkanPrimitiveRenderer::CreateDescriptors() {
+    auto bindings = NVulkanShaderLibrary::SetLayoutBindings({"PrimitiveImage.frag", "PrimitiveText.frag"}, 0);
+    if (bindings.size() != 1 || bindings.front().descriptorType != vk::DescriptorType::eCombinedImageSampler) {
+        throw std::runtime_error("Primitive shaders must sample one combined image at set 0, binding 0.");
+    }
+    vk::DescriptorSetLayoutCreateInfo layout_info{};
+    layout_info.setBindings(bindings);
+    descriptor_set_layout_ = NVulkanDevice::Singleton().CreateDescriptorSetLayout(layout_info);
+
+    vk::DescriptorPoolSize pool_size{vk::DescriptorType::eCombinedImageSampler, MAX_TEXTURES};
+    vk::DescriptorPoolCreateInfo pool_info{};
+    pool_info
+        .setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet)
+        .setMaxSets(MAX_TEXTURES)
+        .setPoolSizes(pool_size);
+    descriptor_pool_ = NVulkanDevice::Singleton().CreateDescriptorPool(pool_info);
+}
+
+void NVulkanPrimitiveRenderer::CreatePipelines(const vk::RenderPass& render_pass) {
+    auto& manager = NVulkanPipelineManager::Singleton();
+    NVulkanPipelineState state{};
+    state.stages_ = {NVulkanShaderLibrary::Stage("Primitive.vert"), NVulkanShaderLibrary::Stage("Primitive.frag")};
+    state.vertex_bindings_ = {{0, sizeof(NDrawInstance), vk::VertexInputRate::eInstance}};
+    state.vertex_attributes_ = {
+        {0, 0, vk::Format::eR32G32B32A32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, rect_))},
+        {1, 0, vk::Format::eR32G32B32A32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, uv_))},
+        {2, 0, vk::Format::eR32G32B32A32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, color_))},
+        {3, 0, vk::Format::eR32G32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, radius_))},
+        {4, 0, vk::Format::eR32Uint, static_cast<uint32_t>(offsetof(NDrawInstance, primitive_))},
+    };
+    state.topology_ = vk::PrimitiveTopology::eTriangleStrip;
+    state.depth_test_ = false;
+    state.depth_write_ = false;
+    state.blend_ = true;
+    state.descriptor_set_layouts_ = {descriptor_set_layout_};
+    state.push_constant_ranges_ = NVulkanShaderLibrary::PushConstantRanges({"Primitive.vert", "Path.vert"});
+    if (state.push_constant_ranges_.size() != 1 || state.push_constant_ranges_.front().size != sizeof(PushConstants)) {
+        throw std::runtime_error("Primitive shaders disagree with the renderer's push constants.");
+    }
+    state.render_pass_ = render_pass;
+    shape_pipeline_ = manager.CreateGraphicsPipeline(state);
+    state.stages_[1] = NVulkanShaderLibrary::Stage("PrimitiveImage.frag");
+    image_pipeline_ = manager.CreateGraphicsPipeline(state);
+    state.stages_[1] = NVulkanShaderLibrary::Stage("PrimitiveText.frag");
+    text_pipeline_ = manager.CreateGraphicsPipeline(state);
+
+    // Paths read their vertices from a second, per-vertex binding.
+    state.stages_ = {NVulkanShaderLibrary::Stage("Path.vert"), NVulkanShaderLibrary::Stage("Path.frag")};
+    state.vertex_bindings_ = {{0, sizeof(NDrawInstance), vk::VertexInputRate::eInstance}, {1, sizeof(NPoint), vk::VertexInputRate::eVertex}};
+    state.vertex_attributes_ = {
+        {0, 0, vk::Format::eR32G32B32A32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, rect_))},
+        {1, 0, vk::Format::eR32G32B32A32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, uv_))},
+        {2, 0, vk::Format::eR32G32B32A32Sfloat, static_cast<uint32_t>(offsetof(NDrawInstance, color_))},
+        {3, 1, vk::Format::eR32G32Sfloat, 0},
+    };
+    state.topology_ = vk::PrimitiveTopology::eTriangleList;
+    path_pipeline_ = manager.CreateGraphicsPipeline(state);
+
+    state.stencil_test_ = true;
+    state.color_write_mask_ = {};
+    state.stencil_front_ = vk::StencilOpState{vk::StencilOp::eKeep, vk::StencilOp::eIncrementAndWrap, vk::StencilOp::eKeep, vk::CompareOp::eAlways, 0xFF, 0xFF, 0};
+    state.stencil_back_ = vk::StencilOpState{vk::StencilOp::eKeep, vk::StencilOp::eDecrementAndWrap, vk::StencilOp::eKeep, vk::CompareOp::eAlways, 0xFF, 0xFF, 0};
+    stencil_non_zero_pipeline_ = manager.CreateGraphicsPipeline(state);
+    state.stencil_front_ = vk::StencilOpState{vk::StencilOp::eKeep, vk::StencilOp::eInvert, vk::StencilOp::eKeep, vk::CompareOp::eAlways, 0xFF, 0x01, 0};
+    state.stencil_back_ = state.stencil_front_;
+    stencil_even_odd_pipeline_ = manager.CreateGraphicsPipeline(state);
+    state.color_write_mask_ = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
+    state.stencil_front_ = vk::StencilOpState{vk::StencilOp::eZero, vk::StencilOp::eZero, vk::StencilOp::eZero, vk::CompareOp::eNotEqual, 0xFF, 0xFF, 0};
+    state.stencil_back_ = state.stencil_front_;
+    cover_pipeline_ = manager.CreateGraphicsPipeline(state);
+}
+
+void NVulkanPrimitiveRenderer::EnsureCapacity(vk::Buffer& buffer, NVulkanAllocation& allocation, vk::DeviceSize& capacity, vk::DeviceSize count, vk::DeviceSize stride) {
+    if (count <= capacity) {
+        return;
+    }
+    auto& device = NVulkanDevice::Singleton();
+    if (buffer) {
+        device.DestroyBuffer(buffer, allocation);
+    }
+    capacity = (std::max)({count, capacity * 2, MIN_INSTANCE_CAPACITY});
+    // Prefer memory the GPU reads at full speed when the host can also write it directly.
+    device.CreateBuffer(capacity * stride, vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, buffer, allocation, NVulkanAllocationStrategy::eFreeList, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    if (!allocation.mapped_) {
+        throw std::runtime_error("Instance memory is not host visible.");
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @file NVulkanProfiler.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanProfiler.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "NVulkanDevice.h"
+#include "NVulkanPhysical.h"
+
+NVulkanProfiler::NVulkanProfiler(uint32_t max_zones) : max_zones_(max_zones) {
+    if (max_zones_ == 0) {
+        throw std::runtime_error("A GPU profiler needs room for at least one zone.");
+    }
+    const auto& physical = NVulkanPhysical::Singleton();
+    const auto& capabilities = physical.GetCapabilities();
+    auto valid_bits = capabilities.queue_family_properties_[physical.QueueFamilies().graphics_family_].timestampValidBits;
+    is_supported_ = valid_bits != 0 && capabilities.properties_.limits.timestampPeriod > 0.0F;
+    if (!is_supported_) {
+        return;
+    }
+    timestamp_period_ = capabilities.properties_.limits.timestampPeriod;
+    timestamp_mask_ = valid_bits >= 64 ? UINT64_MAX : (uint64_t{1} << valid_bits) - 1;
+    vk::QueryPoolCreateInfo pool_info{};
+    pool_info
+        .setQueryType(vk::QueryType::eTimestamp)
+        .setQueryCount(max_zones_ * 2);
+    auto& device = NVulkanDevice::Singleton();
+    for (auto& frame : frames_) {
+        frame.pool_ = device.CreateQueryPool(pool_info);
+        frame.zones_.reserve(max_zones_);
+    }
+    results_.reserve(max_zones_ * 2);
+    Calibrate();
+}
+
+NVulkanProfiler::~NVulkanProfiler() {
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    for (auto& frame : frames_) {
+        if (frame.pool_) {
+            device.DestroyQueryPool(frame.pool_);
+        }
+    }
+}
+
+void NVulkanProfiler::BeginFrame(const vk::CommandBuffer& command_buffer, size_t frame_index) {
+    if (!is_supported_) {
+        return;
+    }
+    if (current_ && !open_zones_.empty()) {
+        // An end timestamp was never written, so the previous frame's queries would never become available.
+        current_->zones_.clear();
+        open_zones_.clear();
+    }
+    current_ = &frames_[frame_index % frames_.size()];
+    Resolve(*current_);
+    command_buffer.resetQueryPool(current_->pool_, 0, max_zones_ * 2);
+}
+
+void NVulkanProfiler::BeginZone(const vk::CommandBuffer& command_buffer, const char* name, vk::PipelineStageFlagBits stage) {
+    if (!current_) {
+        return;
+    }
+    if (current_->zones_.size() == max_zones_) {
+        open_zones_.push_back(NO_ZONE);
+        return;
+    }
+    auto zone = static_cast<uint32_t>(current_->zones_.size());
+    current_->zones_.push_back(name);
+    open_zones_.push_back(zone);
+    command_buffer.writeTimestamp(stage, current_->pool_, zone * 2);
+}
+
+void NVulkanProfiler::EndZone(const vk::CommandBuffer& command_buffer, vk::PipelineStageFlagBits stage) {
+    if (!current_) {
+        return;
+    }
+    if (open_zones_.empty()) {
+        throw std::runtime_error("Can't end a GPU zone that was not begun.");
+    }
+    auto zone = open_zones_.back();
+    open_zones_.pop_back();
+    if (zone != NO_ZONE) {
+        command_buffer.writeTimestamp(stage, current_->pool_, zone * 2 + 1);
+    }
+}
+
+void NVulkanProfiler::Calibrate() {
+    if (!is_supported_) {
+        return;
+    }
+    // Without VK_EXT_calibrated_timestamps, a timestamp written by an otherwise empty submission is bracketed
+    // by CPU times, and the tightest of a few brackets is taken as the shared instant.
+    auto& device = NVulkanDevice::Singleton();
+    vk::QueryPoolCreateInfo pool_info{};
+    pool_info
+        .setQueryType(vk::QueryType::eTimestamp)
+        .setQueryCount(1);
+    auto pool = device.CreateQueryPool(pool_info);
+    vk::CommandBufferAllocateInfo alloc_info{};
+    alloc_info
+        .setCommandPool(device.CommandPool())
+        .setLevel(vk::CommandBufferLevel::ePrimary)
+        .setCommandBufferCount(CALIBRATION_SAMPLES);
+    auto command_buffers = device.AllocateCommandBuffers(alloc_info);
+    auto fence = device.CreateFence(vk::FenceCreateInfo{});
+    std::vector<uint64_t> ticks{};
+    auto best = (std::numeric_limits<int64_t>::max)();
+    for (const auto& command_buffer : command_buffers) {
+        vk::CommandBufferBeginInfo begin_info{};
+        begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        command_buffer.begin(begin_info);
+        command_buffer.resetQueryPool(pool, 0, 1);
+        command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, pool, 0);
+        command_buffer.end();
+        vk::SubmitInfo submit_info{};
+        submit_info.setCommandBuffers(command_buffer);
+        auto before = NProfiler::Now();
+        device.SubmitGraphics(submit_info, fence);
+        device.WaitForFences({fence});
+        auto after = NProfiler::Now();
+        device.ResetFence(fence);
+        if (after - before < best && device.GetQueryPoolResults(pool, 0, 1, ticks)) {
+            best = after - before;
+            gpu_base_ = ticks[0] & timestamp_mask_;
+            cpu_base_ = before + best / 2;
+            calibration_error_ = best / 2;
+        }
+    }
+    device.DestroyFence(fence);
+    device.FreeCommandBuffers(command_buffers);
+    device.DestroyQueryPool(pool);
+}
+
+bool NVulkanProfiler::IsSupported() const {
+    return is_supported_;
+}
+
+uint32_t NVulkanProfiler::MaxZones() const {
+    return max_zones_;
+}
+
+int64_t NVulkanProfiler::CalibrationError() const {
+    return calibration_error_;
+}
+
+void NVulkanProfiler::Resolve(Frame& frame) {
+    if (frame.zones_.empty()) {
+        return;
+    }
+    auto query_count = static_cast<uint32_t>(frame.zones_.size() * 2);
+    if (NVulkanDevice::Singleton().GetQueryPoolResults(frame.pool_, 0, query_count, results_)) {
+        auto& profiler = NProfiler::Singleton();
+        for (size_t i = 0; i < frame.zones_.size(); ++i) {
+            auto begin = results_[i * 2] & timestamp_mask_;
+            auto end = results_[i * 2 + 1] & timestamp_mask_;
+            // A counter that wrapped inside the zone has no meaningful duration.
+            if (end >= begin) {
+                profiler.Record(frame.zones_[i], ToCpuTime(begin), ToCpuTime(end), true);
+            }
+        }
+    }
+    frame.zones_.clear();
+}
+
+int64_t NVulkanProfiler::ToCpuTime(uint64_t ticks) const {
+    auto delta = static_cast<double>(static_cast<int64_t>(ticks - gpu_base_));
+    return cpu_base_ + static_cast<int64_t>(std::llround(delta * timestamp_period_));
+}
@@ -6,26 +6,478 @@
 
 #include "NVulkanRender.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
 #include "NVulkanDevice.h"
-#include "NVulkanSwapchain.h"
+#include "NVulkanPhysical.h"
+
+static std::vector<vk::Rect2D> ToScissors(const NDamageRegion& region, const vk::Extent2D& extent) {
+    std::vector<vk::Rect2D> scissors{};
+    for (const auto& rect : region.Rects()) {
+        auto left = std::clamp(static_cast<int64_t>(std::floor(rect.x_)), int64_t{0}, static_cast<int64_t>(extent.width));
+        auto top = std::clamp(static_cast<int64_t>(std::floor(rect.y_)), int64_t{0}, static_cast<int64_t>(extent.height));
+        auto right = std::clamp(static_cast<int64_t>(std::ceil(rect.Right())), left, static_cast<int64_t>(extent.width));
+        auto bottom = std::clamp(static_cast<int64_t>(std::ceil(rect.Bottom())), top, static_cast<int64_t>(extent.height));
+        if (right > left && bottom > top) {
+            scissors.push_back(vk::Rect2D{{static_cast<int32_t>(left), static_cast<int32_t>(top)}, {static_cast<uint32_t>(right - left), static_cast<uint32_t>(bottom - top)}});
+        }
+    }
+    return scissors;
+}
+
+#if defined(_WIN32)
+NVulkanRender::NVulkanRender(HWND hwnd, uint32_t width, uint32_t height, uint32_t frames_in_flight)
+    : backend_(NVulkanSwapchain::Backend::eWindow), hwnd_(hwnd), extent_(width, height), frames_in_flight_(std::clamp(frames_in_flight, NVulkanSwapchain::MIN_FRAMES_IN_FLIGHT, NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT)) {
+    CreateSwapchain(width, height);
+    CreateCommandAllocator();
+}
+#endif
 
-NVulkanRender::NVulkanRender(HWND hwnd, uint32_t width, uint32_t height) {
-    CreateSwapchain(hwnd, width, height);
-    CreateCommandBuffers();
+NVulkanRender::NVulkanRender(NVulkanSwapchain::Backend backend, uint32_t width, uint32_t height, uint32_t frames_in_flight)
+    : backend_(backend), extent_(width, height), frames_in_flight_(std::clamp(frames_in_flight, NVulkanSwapchain::MIN_FRAMES_IN_FLIGHT, NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT)) {
+    CreateSwapchain(width, height);
+    CreateCommandAllocator();
 }
 
-void NVulkanRender::CreateSwapchain(HWND hwnd, uint32_t width, uint32_t height) {
+NVulkanRender::~NVulkanRender() {
+    if (render_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            is_render_thread_stopping_ = true;
+        }
+        state_condition_.notify_one();
+        render_thread_.join();
+    }
     NVulkanDevice::Singleton().WaitIdle();
-    swapchain_.reset(nullptr);
-    swapchain_ = std::make_unique<NVulkanSwapchain>(hwnd, width, height);
-}
-
-void NVulkanRender::CreateCommandBuffers() {
-    command_buffers_.resize(swapchain_->GetImageCount());
-    vk::CommandBufferAllocateInfo alloc_info{};
-    alloc_info
-        .setLevel(vk::CommandBufferLevel::ePrimary)
-        .setCommandPool(NVulkanDevice::Singleton().CommandPool())
-        .setCommandBufferCount(static_cast<uint32_t>(command_buffers_.size()));
-    command_buffers_ = NVulkanDevice::Singleton().AllocateCommandBuffers(alloc_info);
-}
\ No newline at end of file
+    command_allocator_.reset();
+}
+
+vk::CommandBuffer NVulkanRender::BeginFrame() {
+    N_PROFILE_ZONE("NVulkanRender::BeginFrame");
+    CheckRenderThreadAccess();
+    if (is_frame_started_) {
+        throw std::runtime_error("Can't begin a frame while another one is in progress.");
+    }
+    if (extent_.width == 0 || extent_.height == 0) {
+        return nullptr;
+    }
+    if (is_resized_) {
+        is_resized_ = false;
+        CreateSwapchain(extent_.width, extent_.height);
+    }
+    auto result = swapchain_->AcquireNextImage(current_image_index_);
+    if (result == vk::Result::eErrorOutOfDateKHR) {
+        CreateSwapchain(extent_.width, extent_.height);
+        return nullptr;
+    }
+    if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR) {
+        throw std::runtime_error("Failed to acquire swapchain image.");
+    }
+    is_frame_started_ = true;
+    damage_.Clear();
+    damage_.AddAll();
+    repaint_rects_.assign(1, vk::Rect2D{{0, 0}, swapchain_->Extent()});
+    is_partial_repaint_ = false;
+    // AcquireNextImage waited on this slot's fence, so its pools can be recycled in one call.
+    command_allocator_->BeginFrame(swapchain_->CurrentFrame());
+    command_buffer_ = command_allocator_->AllocatePrimary();
+    vk::CommandBufferBeginInfo begin_info{};
+    begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    command_buffer_.begin(begin_info);
+#if defined(NT_PROFILER)
+    if (profiler_) {
+        profiler_->BeginFrame(command_buffer_, swapchain_->CurrentFrame());
+        profiler_->BeginZone(command_buffer_, "Frame");
+    }
+#endif
+    return command_buffer_;
+}
+
+void NVulkanRender::EndFrame() {
+    N_PROFILE_ZONE("NVulkanRender::EndFrame");
+    if (!is_frame_started_) {
+        throw std::runtime_error("Can't end a frame that was not begun.");
+    }
+    const auto& command_buffer = CurrentCommandBuffer();
+#if defined(NT_PROFILER)
+    if (profiler_) {
+        profiler_->EndZone(command_buffer);
+    }
+#endif
+    command_buffer.end();
+    // Present regions describe what changed since the previous present, not what this image repainted.
+    std::vector<vk::Rect2D> present_rects{};
+    if (!damage_.IsFull()) {
+        present_rects = ToScissors(damage_, swapchain_->Extent());
+    }
+    swapchain_->SetPresentRegions(present_rects);
+    damage_history_.push_front(damage_);
+    if (damage_history_.size() > MAX_DAMAGE_HISTORY) {
+        damage_history_.pop_back();
+    }
+    auto result = swapchain_->SubmitCommandBuffers(command_buffer, current_image_index_, wait_semaphores_, wait_stages_, signal_semaphores_);
+    wait_semaphores_.clear();
+    wait_stages_.clear();
+    signal_semaphores_.clear();
+    is_frame_started_ = false;
+    if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR || is_resized_) {
+        is_resized_ = false;
+        CreateSwapchain(extent_.width, extent_.height);
+    } else if (result != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed to present swapchain image.");
+    }
+}
+
+void NVulkanRender::BeginSwapchainRenderPass(const vk::CommandBuffer& command_buffer, vk::SubpassContents contents) {
+    const auto& extent = swapchain_->Extent();
+    if (contents != vk::SubpassContents::eInline && is_partial_repaint_) {
+        // Clearing the repaint rects needs inline commands, so secondary command buffers redraw everything.
+        is_partial_repaint_ = false;
+        repaint_rects_.assign(1, vk::Rect2D{{0, 0}, extent});
+    }
+    std::array<vk::ClearValue, 2> clear_values{};
+    clear_values[0].setColor(vk::ClearColorValue(std::array<float, 4>{0.0F, 0.0F, 0.0F, 1.0F}));
+    clear_values[1].setDepthStencil({1.0F, 0});
+    vk::Rect2D render_area{{0, 0}, extent};
+    if (is_partial_repaint_ && !repaint_rects_.empty()) {
+        auto left = repaint_rects_.front().offset.x;
+        auto top = repaint_rects_.front().offset.y;
+        auto right = left + static_cast<int32_t>(repaint_rects_.front().extent.width);
+        auto bottom = top + static_cast<int32_t>(repaint_rects_.front().extent.height);
+        for (const auto& rect : repaint_rects_) {
+            left = (std::min)(left, rect.offset.x);
+            top = (std::min)(top, rect.offset.y);
+            right = (std::max)(right, rect.offset.x + static_cast<int32_t>(rect.extent.width));
+            bottom = (std::max)(bottom, rect.offset.y + static_cast<int32_t>(rect.extent.height));
+        }
+        render_area = vk::Rect2D{{left, top}, {static_cast<uint32_t>(right - left), static_cast<uint32_t>(bottom - top)}};
+    }
+    vk::RenderPassBeginInfo render_pass_info{};
+    render_pass_info
+        .setRenderPass(is_partial_repaint_ ? swapchain_->LoadRenderPass() : swapchain_->RenderPass())
+        .setFramebuffer(swapchain_->Framebuffer(current_image_index_))
+        .setRenderArea(render_area)
+        .setClearValues(clear_values);
+    command_buffer.beginRenderPass(render_pass_info, contents);
+    if (contents == vk::SubpassContents::eInline) {
+        vk::Viewport viewport{0.0F, 0.0F, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0F, 1.0F};
+        command_buffer.setViewport(0, viewport);
+        command_buffer.setScissor(0, render_area);
+    }
+    if (is_partial_repaint_ && !repaint_rects_.empty()) {
+        // Depth and stencil are cleared by the load op over the render area; color only inside the repaint rects.
+        vk::ClearAttachment clear_attachment{};
+        clear_attachment
+            .setAspectMask(vk::ImageAspectFlagBits::eColor)
+            .setColorAttachment(0)
+            .setClearValue(clear_values[0]);
+        std::vector<vk::ClearRect> clear_rects{};
+        clear_rects.reserve(repaint_rects_.size());
+        for (const auto& rect : repaint_rects_) {
+            clear_rects.emplace_back(rect, 0, 1);
+        }
+        command_buffer.clearAttachments(clear_attachment, clear_rects);
+    }
+}
+
+void NVulkanRender::EndSwapchainRenderPass(const vk::CommandBuffer& command_buffer) {
+    command_buffer.endRenderPass();
+}
+
+void NVulkanRender::SetDamage(const NDamageRegion& damage) {
+    if (!is_frame_started_) {
+        throw std::runtime_error("Can't set damage outside a frame.");
+    }
+    const auto& extent = swapchain_->Extent();
+    damage_ = damage;
+    repaint_rects_.assign(1, vk::Rect2D{{0, 0}, extent});
+    is_partial_repaint_ = false;
+    // The image still shows the frame presented age frames ago, so everything damaged since must be repainted.
+    auto age = swapchain_->ImageAge(current_image_index_);
+    if (damage_.IsFull() || age == 0 || age - 1 > damage_history_.size()) {
+        return;
+    }
+    auto repaint = damage_;
+    for (size_t i = 0; i + 1 < age; ++i) {
+        repaint.Add(damage_history_[i]);
+    }
+    if (repaint.IsFull()) {
+        return;
+    }
+    if (repaint.Rects().size() > MAX_REPAINT_RECTS) {
+        // Every rect replays the recording, so past a few the one bounding rect costs less.
+        auto bounds = repaint.Bounds();
+        repaint.Clear();
+        repaint.Add(bounds);
+    }
+    repaint_rects_ = ToScissors(repaint, extent);
+    is_partial_repaint_ = true;
+}
+
+bool NVulkanRender::IsPartialRepaint() const {
+    return is_partial_repaint_;
+}
+
+const std::vector<vk::Rect2D>& NVulkanRender::RepaintRects() const {
+    return repaint_rects_;
+}
+
+void NVulkanRender::RecordRepaint(const vk::CommandBuffer& command_buffer, const RepaintCallback& record) {
+    for (const auto& rect : repaint_rects_) {
+        command_buffer.setScissor(0, rect);
+        record(rect);
+    }
+}
+
+vk::CommandBuffer NVulkanRender::BeginSecondaryCommandBuffer() {
+    if (!is_frame_started_) {
+        throw std::runtime_error("Can't record secondary command buffers outside a frame.");
+    }
+    vk::CommandBufferInheritanceInfo inheritance_info{};
+    inheritance_info
+        .setRenderPass(swapchain_->RenderPass())
+        .setSubpass(0)
+        .setFramebuffer(swapchain_->Framebuffer(current_image_index_));
+    auto command_buffer = command_allocator_->BeginSecondary(inheritance_info);
+    const auto& extent = swapchain_->Extent();
+    vk::Viewport viewport{0.0F, 0.0F, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0F, 1.0F};
+    vk::Rect2D scissor{{0, 0}, extent};
+    command_buffer.setViewport(0, viewport);
+    command_buffer.setScissor(0, scissor);
+    return command_buffer;
+}
+
+void NVulkanRender::AddWaitSemaphore(const vk::Semaphore& semaphore, const vk::PipelineStageFlags& wait_stages) {
+    if (!is_frame_started_) {
+        throw std::runtime_error("Can't add a wait semaphore outside a frame.");
+    }
+    wait_semaphores_.push_back(semaphore);
+    wait_stages_.push_back(wait_stages);
+}
+
+void NVulkanRender::AddSignalSemaphore(const vk::Semaphore& semaphore) {
+    if (!is_frame_started_) {
+        throw std::runtime_error("Can't add a signal semaphore outside a frame.");
+    }
+    signal_semaphores_.push_back(semaphore);
+}
+
+NVulkanCommandAllocator& NVulkanRender::CommandAllocator() {
+    return *command_allocator_;
+}
+
+void NVulkanRender::Resize(uint32_t width, uint32_t height) {
+    if (is_render_thread_running_) {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            pending_extent_ = vk::Extent2D{width, height};
+            has_pending_extent_ = true;
+        }
+        state_condition_.notify_one();
+        return;
+    }
+    extent_ = vk::Extent2D{width, height};
+    is_resized_ = true;
+}
+
+uint32_t NVulkanRender::FramesInFlight() const {
+    return frames_in_flight_;
+}
+
+void NVulkanRender::SetFramesInFlight(uint32_t frames_in_flight) {
+    if (is_render_thread_running_) {
+        throw std::runtime_error("Can't change frames in flight while the render thread is running.");
+    }
+    if (is_frame_started_) {
+        throw std::runtime_error("Can't change frames in flight while a frame is in progress.");
+    }
+    frames_in_flight = std::clamp(frames_in_flight, NVulkanSwapchain::MIN_FRAMES_IN_FLIGHT, NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT);
+    if (frames_in_flight == frames_in_flight_) {
+        return;
+    }
+    frames_in_flight_ = frames_in_flight;
+    swapchain_->SetFramesInFlight(frames_in_flight_);
+    CreateCommandAllocator();
+}
+
+size_t NVulkanRender::CurrentFrameIndex() const {
+    return swapchain_->CurrentFrame();
+}
+
+bool NVulkanRender::IsFrameInProgress() const {
+    return is_frame_started_;
+}
+
+const vk::CommandBuffer& NVulkanRender::CurrentCommandBuffer() const {
+    return command_buffer_;
+}
+
+const vk::RenderPass& NVulkanRender::RenderPass() const {
+    return swapchain_->RenderPass();
+}
+
+const NVulkanSwapchain& NVulkanRender::Swapchain() const {
+    return *swapchain_;
+}
+
+uint32_t NVulkanRender::CurrentImageIndex() const {
+    return current_image_index_;
+}
+
+void NVulkanRender::StartRenderThread(RecordCallback callback) {
+    if (render_thread_.joinable()) {
+        throw std::runtime_error("The render thread is already running.");
+    }
+    if (is_frame_started_) {
+        throw std::runtime_error("Can't start the render thread while a frame is in progress.");
+    }
+    record_callback_ = std::move(callback);
+    is_render_thread_stopping_ = false;
+    is_state_dirty_ = false;
+    has_pending_extent_ = false;
+    render_thread_exception_ = nullptr;
+    is_render_thread_running_ = true;
+    render_thread_ = std::thread(&NVulkanRender::RenderThreadMain, this);
+}
+
+void NVulkanRender::StopRenderThread() {
+    if (!render_thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        is_render_thread_stopping_ = true;
+    }
+    state_condition_.notify_one();
+    render_thread_.join();
+    is_render_thread_running_ = false;
+    render_thread_id_ = std::thread::id{};
+    if (has_pending_extent_) {
+        has_pending_extent_ = false;
+        Resize(pending_extent_.width, pending_extent_.height);
+    }
+    if (render_thread_exception_) {
+        std::rethrow_exception(std::exchange(render_thread_exception_, nullptr));
+    }
+}
+
+bool NVulkanRender::IsRenderThreadRunning() const {
+    return is_render_thread_running_;
+}
+
+void NVulkanRender::PublishState(NVulkanRenderState state) {
+    if (render_thread_.joinable() && !is_render_thread_running_) {
+        // The render thread stopped on an exception; joining it rethrows that exception here.
+        StopRenderThread();
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        // The back slot is never read by the render thread, so it can be overwritten until the next swap.
+        auto& back = states_[1 - front_state_];
+        if (is_state_dirty_) {
+            // The replaced state was never drawn, so what it changed still has to be repainted.
+            if (back.damage_.Empty() || state.damage_.Empty()) {
+                state.damage_.Clear();
+            } else {
+                state.damage_.Add(back.damage_);
+            }
+        }
+        back = std::move(state);
+        is_state_dirty_ = true;
+    }
+    state_condition_.notify_one();
+}
+
+void NVulkanRender::SetProfiler(NVulkanProfiler* profiler) {
+    if (is_frame_started_) {
+        throw std::runtime_error("Can't change the profiler while a frame is in progress.");
+    }
+    profiler_ = profiler;
+}
+
+void NVulkanRender::RenderThreadMain() {
+    N_PROFILE_THREAD("Render");
+    render_thread_id_ = std::this_thread::get_id();
+    // Set when a frame could not begin because the swapchain was recreated, so the state is drawn again without waiting for a new one.
+    bool needs_frame = false;
+    try {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(state_mutex_);
+                state_condition_.wait(lock, [this, needs_frame] {
+                    return needs_frame || is_state_dirty_ || has_pending_extent_ || is_render_thread_stopping_;
+                });
+                if (is_render_thread_stopping_) {
+                    break;
+                }
+                if (is_state_dirty_) {
+                    front_state_ = 1 - front_state_;
+                    is_state_dirty_ = false;
+                }
+                if (has_pending_extent_) {
+                    has_pending_extent_ = false;
+                    extent_ = pending_extent_;
+                    is_resized_ = true;
+                }
+            }
+            const auto& state = states_[front_state_];
+            if (state.extent_.width != 0 && state.extent_.height != 0 && state.extent_ != extent_) {
+                extent_ = state.extent_;
+                is_resized_ = true;
+            }
+            auto command_buffer = BeginFrame();
+            // A minimized window has nothing to retry until it is resized.
+            needs_frame = !command_buffer && extent_.width != 0 && extent_.height != 0;
+            if (!command_buffer) {
+                continue;
+            }
+            if (!state.damage_.Empty()) {
+                SetDamage(state.damage_);
+            }
+            BeginSwapchainRenderPass(command_buffer);
+            if (record_callback_) {
+                N_PROFILE_ZONE("NVulkanRender::Record");
+                record_callback_(command_buffer, state);
+            }
+            EndSwapchainRenderPass(command_buffer);
+            EndFrame();
+        }
+        // The next render thread gets a new id, so this one's command pools would never be reused.
+        command_allocator_->ReleaseThread();
+    } catch (...) {
+        is_frame_started_ = false;
+        command_allocator_->ReleaseThread();
+        render_thread_exception_ = std::current_exception();
+        // The exception is stored first, so whoever sees the thread stopped can also see why.
+        render_thread_id_ = std::thread::id{};
+        is_render_thread_running_ = false;
+    }
+}
+
+void NVulkanRender::CheckRenderThreadAccess() const {
+    if (is_render_thread_running_ && std::this_thread::get_id() != render_thread_id_.load()) {
+        throw std::runtime_error("Frames are recorded by the render thread while it is running.");
+    }
+}
+
+void NVulkanRender::CreateSwapchain(uint32_t width, uint32_t height) {
+    if (swapchain_) {
+        swapchain_->Recreate(width, height);
+        return;
+    }
+#if defined(_WIN32)
+    if (backend_ == NVulkanSwapchain::Backend::eWindow) {
+        swapchain_ = std::make_unique<NVulkanSwapchain>(hwnd_, width, height, frames_in_flight_);
+        return;
+    }
+#endif
+    swapchain_ = std::make_unique<NVulkanSwapchain>(backend_, width, height, frames_in_flight_);
+}
+
+void NVulkanRender::CreateCommandAllocator() {
+    command_allocator_ = std::make_unique<NVulkanCommandAllocator>(NVulkanPhysical::Singleton().QueueFamilies().graphics_family_, frames_in_flight_);
+}
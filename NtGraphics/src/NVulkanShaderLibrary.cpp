@@ -0,0 +1,75 @@
+/**
+ * @file NVulkanShaderLibrary.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanShaderLibrary.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+const NVulkanEmbeddedShader& NVulkanShaderLibrary::Shader(std::string_view name) {
+    // The generated table is sorted by name.
+    auto shaders = Shaders();
+    auto it = std::lower_bound(shaders.begin(), shaders.end(), name, [](const NVulkanEmbeddedShader& shader, std::string_view key) {
+        return shader.name_ < key;
+    });
+    if (it == shaders.end() || it->name_ != name) {
+        throw std::runtime_error("Shader is not embedded: " + std::string(name) + ".");
+    }
+    return *it;
+}
+
+NVulkanShaderStage NVulkanShaderLibrary::Stage(std::string_view name) {
+    const auto& shader = Shader(name);
+    return {shader.stage_, std::vector<uint32_t>(shader.code_.begin(), shader.code_.end())};
+}
+
+std::vector<vk::DescriptorSetLayoutBinding> NVulkanShaderLibrary::SetLayoutBindings(std::initializer_list<std::string_view> names, uint32_t set) {
+    std::vector<vk::DescriptorSetLayoutBinding> bindings{};
+    for (auto name : names) {
+        const auto& shader = Shader(name);
+        for (const auto& binding : shader.bindings_) {
+            if (binding.set_ != set) {
+                continue;
+            }
+            auto it = std::find_if(bindings.begin(), bindings.end(), [&binding](const vk::DescriptorSetLayoutBinding& merged) {
+                return merged.binding == binding.binding_;
+            });
+            if (it == bindings.end()) {
+                bindings.emplace_back(binding.binding_, binding.type_, binding.count_, shader.stage_);
+                continue;
+            }
+            if (it->descriptorType != binding.type_ || it->descriptorCount != binding.count_) {
+                throw std::runtime_error("Shader " + std::string(name) + " disagrees on set " + std::to_string(set) + " binding " + std::to_string(binding.binding_) + ".");
+            }
+            it->stageFlags |= shader.stage_;
+        }
+    }
+    std::sort(bindings.begin(), bindings.end(), [](const vk::DescriptorSetLayoutBinding& left, const vk::DescriptorSetLayoutBinding& right) {
+        return left.binding < right.binding;
+    });
+    return bindings;
+}
+
+std::vector<vk::PushConstantRange> NVulkanShaderLibrary::PushConstantRanges(std::initializer_list<std::string_view> names) {
+    std::vector<vk::PushConstantRange> ranges{};
+    for (auto name : names) {
+        const auto& shader = Shader(name);
+        if (shader.push_constant_size_ == 0) {
+            continue;
+        }
+        // Stages that see the same block share one range.
+        auto it = std::find_if(ranges.begin(), ranges.end(), [&shader](const vk::PushConstantRange& range) {
+            return range.offset == shader.push_constant_offset_ && range.size == shader.push_constant_size_;
+        });
+        if (it == ranges.end()) {
+            ranges.emplace_back(shader.stage_, shader.push_constant_offset_, shader.push_constant_size_);
+        } else {
+            it->stageFlags |= shader.stage_;
+        }
+    }
+    return ranges;
+}
@@ -6,27 +6,295 @@
 
 #include "NVulkanSwapchain.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 #include "NVulkanDevice.h"
 #include "NVulkanInstance.h"
 #include "NVulkanPhysical.h"
 
-NVulkanSwapchain::NVulkanSwapchain(HWND hwnd, uint32_t width, uint32_t height) {
+#if defined(_WIN32)
+NVulkanSwapchain::NVulkanSwapchain(HWND hwnd, uint32_t width, uint32_t height, uint32_t frames_in_flight)
+    : backend_(Backend::eWindow), frames_in_flight_(std::clamp(frames_in_flight, MIN_FRAMES_IN_FLIGHT, MAX_FRAMES_IN_FLIGHT)) {
     window_extent_.setWidth(width);
     window_extent_.setHeight(height);
     vk::Win32SurfaceCreateInfoKHR info{{}, GetModuleHandle(nullptr), hwnd};
     surface_ = NVulkanInstance::Singleton().CreateSurface(info);
-    CreateSwapchain();
+    Create();
+}
+#endif
+
+NVulkanSwapchain::NVulkanSwapchain(Backend backend, uint32_t width, uint32_t height, uint32_t frames_in_flight)
+    : backend_(backend), frames_in_flight_(std::clamp(frames_in_flight, MIN_FRAMES_IN_FLIGHT, MAX_FRAMES_IN_FLIGHT)) {
+    window_extent_.setWidth(width);
+    window_extent_.setHeight(height);
+    if (backend_ == Backend::eWindow) {
+        throw std::runtime_error("A window swapchain needs a native window.");
+    }
+    if (backend_ == Backend::eHeadlessSurface) {
+        surface_ = NVulkanInstance::Singleton().CreateHeadlessSurface();
+    }
+    Create();
+}
+
+NVulkanSwapchain::~NVulkanSwapchain() {
+    NVulkanDevice::Singleton().WaitIdle();
+    completed_frames_ = submitted_frames_;
+    CollectRetiredResources();
+    RetiredResources current{};
+    current.swapchain_ = swapchain_;
+    if (backend_ == Backend::eOffscreen) {
+        current.offscreen_images_ = std::move(swapchain_images_);
+        current.offscreen_image_allocations_ = std::move(offscreen_image_allocations_);
+    }
+    current.image_views_ = std::move(swapchain_image_views_);
+    current.framebuffers_ = std::move(swapchain_framebuffers_);
+    current.render_pass_ = render_pass_;
+    current.load_render_pass_ = load_render_pass_;
+    RetireDepthResources(current);
+    DestroyResources(current);
+    DestroySyncObjects();
+    if (surface_) {
+        NVulkanInstance::Singleton().DestroySurface(surface_);
+    }
+}
+
+NVulkanSwapchain::Backend NVulkanSwapchain::GetBackend() const {
+    return backend_;
+}
+
+size_t NVulkanSwapchain::GetImageCount() const {
+    return swapchain_images_.size();
+}
+
+uint32_t NVulkanSwapchain::FramesInFlight() const {
+    return frames_in_flight_;
+}
+
+void NVulkanSwapchain::SetFramesInFlight(uint32_t frames_in_flight) {
+    frames_in_flight = std::clamp(frames_in_flight, MIN_FRAMES_IN_FLIGHT, MAX_FRAMES_IN_FLIGHT);
+    if (frames_in_flight == frames_in_flight_) {
+        return;
+    }
+    NVulkanDevice::Singleton().WaitIdle();
+    completed_frames_ = submitted_frames_;
+    CollectRetiredResources();
+    RetiredResources retired{};
+    retired.framebuffers_ = std::move(swapchain_framebuffers_);
+    swapchain_framebuffers_.clear();
+    RetireDepthResources(retired);
+    DestroyResources(retired);
+    DestroySyncObjects();
+    frames_in_flight_ = frames_in_flight;
+    current_frame_ = 0;
+    depth_slot_ = 0;
+    CreateDepthResources();
+    CreateFramebuffers();
+    CreateSyncObjects();
+}
+
+size_t NVulkanSwapchain::CurrentFrame() const {
+    return current_frame_;
+}
+
+const vk::RenderPass& NVulkanSwapchain::RenderPass() const {
+    return render_pass_;
+}
+
+const vk::RenderPass& NVulkanSwapchain::LoadRenderPass() const {
+    return load_render_pass_;
+}
+
+const vk::Image& NVulkanSwapchain::Image(uint32_t image_index) const {
+    return swapchain_images_[image_index];
+}
+
+vk::Format NVulkanSwapchain::ImageFormat() const {
+    return swapchain_image_format_;
+}
+
+const vk::Framebuffer& NVulkanSwapchain::Framebuffer(uint32_t image_index) const {
+    return swapchain_framebuffers_[image_index * frames_in_flight_ + depth_slot_];
+}
+
+const vk::Extent2D& NVulkanSwapchain::Extent() const {
+    return swapchain_extent_;
+}
+
+bool NVulkanSwapchain::HasStencil() const {
+    auto format = FindDepthFormat();
+    return format == vk::Format::eD24UnormS8Uint || format == vk::Format::eD32SfloatS8Uint;
+}
+
+uint64_t NVulkanSwapchain::ImageAge(uint32_t image_index) const {
+    auto frame = image_frames_[image_index];
+    return frame == 0 ? 0 : submitted_frames_ + 1 - frame;
+}
+
+bool NVulkanSwapchain::HasIncrementalPresent() const {
+    return backend_ != Backend::eOffscreen && NVulkanPhysical::Singleton().HasExtension(VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+}
+
+void NVulkanSwapchain::SetPresentRegions(const std::vector<vk::Rect2D>& rects) {
+    present_rects_.clear();
+    if (!HasIncrementalPresent()) {
+        return;
+    }
+    for (const auto& rect : rects) {
+        auto x = std::clamp(rect.offset.x, 0, static_cast<int32_t>(swapchain_extent_.width));
+        auto y = std::clamp(rect.offset.y, 0, static_cast<int32_t>(swapchain_extent_.height));
+        auto width = (std::min)(rect.extent.width, swapchain_extent_.width - static_cast<uint32_t>(x));
+        auto height = (std::min)(rect.extent.height, swapchain_extent_.height - static_cast<uint32_t>(y));
+        if (width > 0 && height > 0) {
+            present_rects_.emplace_back(vk::Offset2D{x, y}, vk::Extent2D{width, height}, 0);
+        }
+    }
+}
+
+void NVulkanSwapchain::Create() {
+    if (backend_ == Backend::eOffscreen) {
+        CreateOffscreenImages();
+    } else {
+        CreateSwapchain();
+    }
     CreateRenderPass();
     CreateDepthResources();
     CreateFramebuffers();
     CreateSyncObjects();
+    image_frames_.assign(GetImageCount(), 0);
 }
 
-size_t NVulkanSwapchain::GetImageCount() const {
-    return swapchain_images_.size();
+vk::Result NVulkanSwapchain::AcquireNextImage(uint32_t& image_index) {
+    NVulkanDevice::Singleton().WaitForFences({in_flight_fences_[current_frame_]});
+    if (submitted_frames_ >= frames_in_flight_) {
+        completed_frames_ = (std::max)(completed_frames_, submitted_frames_ - frames_in_flight_ + 1);
+    }
+    CollectRetiredResources();
+    depth_slot_ = current_frame_;
+    if (backend_ == Backend::eOffscreen) {
+        image_index = next_offscreen_image_;
+        next_offscreen_image_ = (next_offscreen_image_ + 1) % static_cast<uint32_t>(GetImageCount());
+        return vk::Result::eSuccess;
+    }
+    return NVulkanDevice::Singleton().AcquireNextImage(swapchain_, image_available_semaphores_[current_frame_], image_index);
 }
 
-void NVulkanSwapchain::CreateSwapchain() {
+vk::Result NVulkanSwapchain::SubmitCommandBuffers(const vk::CommandBuffer& command_buffer, uint32_t image_index, const std::vector<vk::Semaphore>& wait_semaphores, const std::vector<vk::PipelineStageFlags>& wait_stages, const std::vector<vk::Semaphore>& signal_semaphores) {
+    if (images_in_flight_[image_index]) {
+        NVulkanDevice::Singleton().WaitForFences({images_in_flight_[image_index]});
+    }
+    images_in_flight_[image_index] = in_flight_fences_[current_frame_];
+
+    auto semaphores = wait_semaphores;
+    auto stages = wait_stages;
+    auto signals = signal_semaphores;
+    vk::SubmitInfo submit_info{};
+    submit_info.setCommandBuffers(command_buffer);
+    if (backend_ != Backend::eOffscreen) {
+        semaphores.push_back(image_available_semaphores_[current_frame_]);
+        stages.emplace_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+        signals.push_back(render_finished_semaphores_[current_frame_]);
+    }
+    submit_info
+        .setWaitSemaphores(semaphores)
+        .setWaitDstStageMask(stages)
+        .setSignalSemaphores(signals);
+    NVulkanDevice::Singleton().ResetFence(in_flight_fences_[current_frame_]);
+    NVulkanDevice::Singleton().SubmitGraphics(submit_info, in_flight_fences_[current_frame_]);
+    ++submitted_frames_;
+    image_frames_[image_index] = submitted_frames_;
+    if (backend_ == Backend::eOffscreen) {
+        current_frame_ = (current_frame_ + 1) % frames_in_flight_;
+        return vk::Result::eSuccess;
+    }
+
+    vk::PresentInfoKHR present_info{};
+    present_info
+        .setWaitSemaphores(render_finished_semaphores_[current_frame_])
+        .setSwapchains(swapchain_)
+        .setImageIndices(image_index);
+    vk::PresentRegionKHR present_region{};
+    vk::PresentRegionsKHR present_regions{};
+    if (!present_rects_.empty()) {
+        present_region.setRectangles(present_rects_);
+        present_regions.setRegions(present_region);
+        present_info.setPNext(&present_regions);
+    }
+    auto result = NVulkanDevice::Singleton().Present(present_info);
+    present_rects_.clear();
+    current_frame_ = (current_frame_ + 1) % frames_in_flight_;
+    return result;
+}
+
+const vk::SwapchainKHR& NVulkanSwapchain::Handle() const {
+    return swapchain_;
+}
+
+vk::Result NVulkanSwapchain::AcquireNextImage(const vk::Semaphore& semaphore, size_t frame_index, uint32_t& image_index) {
+    vk::Result result = vk::Result::eSuccess;
+    depth_slot_ = frame_index % frames_in_flight_;
+    if (backend_ == Backend::eOffscreen) {
+        image_index = next_offscreen_image_;
+        next_offscreen_image_ = (next_offscreen_image_ + 1) % static_cast<uint32_t>(GetImageCount());
+    } else {
+        result = NVulkanDevice::Singleton().AcquireNextImage(swapchain_, semaphore, image_index);
+        if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR) {
+            return result;
+        }
+    }
+    if (images_in_flight_[image_index]) {
+        NVulkanDevice::Singleton().WaitForFences({images_in_flight_[image_index]});
+    }
+    return result;
+}
+
+void NVulkanSwapchain::MarkSubmitted(const vk::Fence& fence, uint32_t image_index, uint64_t submission) {
+    images_in_flight_[image_index] = fence;
+    submitted_frames_ = (std::max)(submitted_frames_, submission);
+    image_frames_[image_index] = submission;
+}
+
+void NVulkanSwapchain::MarkCompleted(uint64_t submission) {
+    completed_frames_ = (std::max)(completed_frames_, submission);
+    CollectRetiredResources();
+}
+
+void NVulkanSwapchain::Recreate(uint32_t width, uint32_t height) {
+    window_extent_.setWidth(width);
+    window_extent_.setHeight(height);
+    RetiredResources retired{};
+    retired.frame_ = submitted_frames_;
+    retired.swapchain_ = swapchain_;
+    retired.image_views_ = std::move(swapchain_image_views_);
+    retired.framebuffers_ = std::move(swapchain_framebuffers_);
+    swapchain_image_views_.clear();
+    swapchain_framebuffers_.clear();
+    auto old_format = swapchain_image_format_;
+    if (backend_ == Backend::eOffscreen) {
+        retired.offscreen_images_ = std::move(swapchain_images_);
+        retired.offscreen_image_allocations_ = std::move(offscreen_image_allocations_);
+        CreateOffscreenImages();
+    } else {
+        CreateSwapchain(retired.swapchain_);
+    }
+    if (swapchain_image_format_ != old_format) {
+        retired.render_pass_ = render_pass_;
+        retired.load_render_pass_ = load_render_pass_;
+        CreateRenderPass();
+    }
+    if (swapchain_extent_.width > depth_extent_.width || swapchain_extent_.height > depth_extent_.height || frames_in_flight_ != depth_images_.size()) {
+        RetireDepthResources(retired);
+        CreateDepthResources();
+    }
+    CreateFramebuffers();
+    images_in_flight_.assign(GetImageCount(), nullptr);
+    image_frames_.assign(GetImageCount(), 0);
+    present_rects_.clear();
+    retired_.push_back(std::move(retired));
+}
+
+void NVulkanSwapchain::CreateSwapchain(const vk::SwapchainKHR& old_swapchain) {
     auto swapchain_support = NVulkanPhysical::Singleton().QuerySwapchainSupport(surface_);
     auto surface_format = ChooseSwapSurfaceFormat(swapchain_support.formats_);
     swapchain_image_format_ = surface_format.format;
@@ -49,8 +317,9 @@ void NVulkanSwapchain::CreateSwapchain() {
         .setPreTransform(swapchain_support.capabilities_.currentTransform)
         .setCompositeAlpha(vk::CompositeAlphaFlagBitsKHR::eOpaque)
         .setPresentMode(present_mode)
-        .setClipped(true);
-    auto indices = NVulkanPhysical::Singleton().QueueFamilies();
+        .setClipped(true)
+        .setOldSwapchain(old_swapchain);
+    const auto& indices = NVulkanPhysical::Singleton().QueueFamilies();
     if (indices.graphics_family_ != indices.present_family_) {
         std::array<uint32_t, 2> queue_family_indices{indices.graphics_family_, indices.present_family_};
         create_info
@@ -63,6 +332,22 @@ void NVulkanSwapchain::CreateSwapchain() {
     }
     swapchain_ = NVulkanDevice::Singleton().CreateSwapchain(create_info);
     swapchain_images_ = NVulkanDevice::Singleton().GetSwapchainImages(swapchain_);
+    CreateImageViews();
+}
+
+void NVulkanSwapchain::CreateOffscreenImages() {
+    swapchain_image_format_ = vk::Format::eR8G8B8A8Srgb;
+    swapchain_extent_ = window_extent_;
+    swapchain_images_.resize(frames_in_flight_ + 1);
+    offscreen_image_allocations_.resize(swapchain_images_.size());
+    for (size_t i = 0; i < swapchain_images_.size(); ++i) {
+        NVulkanDevice::Singleton().CreateImage(swapchain_extent_.width, swapchain_extent_.height, swapchain_image_format_, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eSampled, vk::MemoryPropertyFlagBits::eDeviceLocal, swapchain_images_[i], offscreen_image_allocations_[i]);
+    }
+    next_offscreen_image_ = 0;
+    CreateImageViews();
+}
+
+void NVulkanSwapchain::CreateImageViews() {
     swapchain_image_views_.resize(swapchain_images_.size());
     for (size_t i = 0; i < swapchain_image_views_.size(); ++i) {
         swapchain_image_views_[i] = NVulkanDevice::Singleton().CreateImageView(swapchain_images_[i], swapchain_image_format_, vk::ImageAspectFlagBits::eColor);
@@ -70,13 +355,18 @@ void NVulkanSwapchain::CreateSwapchain() {
 }
 
 void NVulkanSwapchain::CreateRenderPass() {
+    render_pass_ = CreateRenderPass(vk::AttachmentLoadOp::eClear);
+    load_render_pass_ = CreateRenderPass(vk::AttachmentLoadOp::eLoad);
+}
+
+vk::RenderPass NVulkanSwapchain::CreateRenderPass(vk::AttachmentLoadOp color_load_op) const {
     vk::AttachmentDescription depth_attachment{};
     depth_attachment
         .setFormat(FindDepthFormat())
         .setSamples(vk::SampleCountFlagBits::e1)
         .setLoadOp(vk::AttachmentLoadOp::eClear)
         .setStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+        .setStencilLoadOp(HasStencil() ? vk::AttachmentLoadOp::eClear : vk::AttachmentLoadOp::eDontCare)
         .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
         .setInitialLayout(vk::ImageLayout::eUndefined)
         .setFinalLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
@@ -85,16 +375,19 @@ void NVulkanSwapchain::CreateRenderPass() {
         .setAttachment(1)
         .setLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
 
+    // Loading the previous contents requires the image to still be in the layout the last pass left it in.
+    auto is_load = color_load_op == vk::AttachmentLoadOp::eLoad;
+    auto final_layout = backend_ == Backend::eOffscreen ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR;
     vk::AttachmentDescription color_attachment;
     color_attachment
         .setFormat(swapchain_image_format_)
         .setSamples(vk::SampleCountFlagBits::e1)
-        .setLoadOp(vk::AttachmentLoadOp::eClear)
+        .setLoadOp(color_load_op)
         .setStoreOp(vk::AttachmentStoreOp::eStore)
         .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
         .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setInitialLayout(vk::ImageLayout::eUndefined)
-        .setFinalLayout(vk::ImageLayout::ePresentSrcKHR);
+        .setInitialLayout(is_load ? final_layout : vk::ImageLayout::eUndefined)
+        .setFinalLayout(final_layout);
     vk::AttachmentReference color_attachment_reference;
     color_attachment_reference
         .setAttachment(0)
@@ -114,7 +407,7 @@ void NVulkanSwapchain::CreateRenderPass() {
         .setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eEarlyFragmentTests)
         .setDstSubpass(0)
         .setDstStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eEarlyFragmentTests)
-        .setDstAccessMask(vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite);
+        .setDstAccessMask(vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite | (is_load ? vk::AccessFlagBits::eColorAttachmentRead : vk::AccessFlags{}));
 
     std::array<vk::AttachmentDescription, 2> attachments{color_attachment, depth_attachment};
 
@@ -126,24 +419,31 @@ void NVulkanSwapchain::CreateRenderPass() {
         .setSubpasses(subpass)
         .setDependencyCount(1)
         .setDependencies(dependency);
-    render_pass_ = NVulkanDevice::Singleton().CreateRenderPass(render_pass_info);
+    return NVulkanDevice::Singleton().CreateRenderPass(render_pass_info);
 }
 
 void NVulkanSwapchain::CreateDepthResources() {
     auto depth_format = FindDepthFormat();
-    depth_images_.resize(GetImageCount());
-    depth_image_memories_.resize(GetImageCount());
-    depth_image_views_.resize(GetImageCount());
+    auto max_dimension = NVulkanPhysical::Singleton().GetCapabilities().properties_.limits.maxImageDimension2D;
+    auto round_up = [max_dimension](uint32_t value) {
+        return (std::min)((value + DEPTH_EXTENT_GRANULARITY - 1) / DEPTH_EXTENT_GRANULARITY * DEPTH_EXTENT_GRANULARITY, max_dimension);
+    };
+    depth_extent_ = vk::Extent2D{round_up(swapchain_extent_.width), round_up(swapchain_extent_.height)};
+    // Depth is cleared on load and never stored, so only the frames in flight need their own image, and
+    // tile-based GPUs can keep it entirely in on-chip memory.
+    depth_images_.resize(frames_in_flight_);
+    depth_image_allocations_.resize(frames_in_flight_);
+    depth_image_views_.resize(frames_in_flight_);
     for (size_t i = 0; i < depth_images_.size(); ++i) {
-        NVulkanDevice::Singleton().CreateImage(swapchain_extent_.width, swapchain_extent_.height, depth_format, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal, depth_images_[i], depth_image_memories_[i]);
-        depth_image_views_[i] = NVulkanDevice::Singleton().CreateImageView(depth_images_[i], depth_format, vk::ImageAspectFlagBits::eDepth);
+        NVulkanDevice::Singleton().CreateImage(depth_extent_.width, depth_extent_.height, depth_format, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eTransientAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal, depth_images_[i], depth_image_allocations_[i], vk::MemoryPropertyFlagBits::eLazilyAllocated);
+        depth_image_views_[i] = NVulkanDevice::Singleton().CreateImageView(depth_images_[i], depth_format, HasStencil() ? vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil : vk::ImageAspectFlags{vk::ImageAspectFlagBits::eDepth});
     }
 }
 
 void NVulkanSwapchain::CreateFramebuffers() {
-    swapchain_framebuffers_.resize(GetImageCount());
-    for (size_t i = 0; i < GetImageCount(); ++i) {
-        std::array<vk::ImageView, 2> attachments{swapchain_image_views_[i], depth_image_views_[i]};
+    swapchain_framebuffers_.resize(GetImageCount() * frames_in_flight_);
+    for (size_t i = 0; i < swapchain_framebuffers_.size(); ++i) {
+        std::array<vk::ImageView, 2> attachments{swapchain_image_views_[i / frames_in_flight_], depth_image_views_[i % frames_in_flight_]};
         vk::FramebufferCreateInfo framebuffer_info{};
         framebuffer_info
             .setRenderPass(render_pass_)
@@ -157,20 +457,78 @@ void NVulkanSwapchain::CreateFramebuffers() {
 }
 
 void NVulkanSwapchain::CreateSyncObjects() {
-    image_available_semaphores_.resize(MAX_FRAMES_IN_FLIGHT);
-    render_finished_semaphores_.resize(MAX_FRAMES_IN_FLIGHT);
-    in_flight_fences_.resize(MAX_FRAMES_IN_FLIGHT);
-    images_in_flight_.resize(GetImageCount());
+    image_available_semaphores_.resize(frames_in_flight_);
+    render_finished_semaphores_.resize(frames_in_flight_);
+    in_flight_fences_.resize(frames_in_flight_);
+    images_in_flight_.assign(GetImageCount(), nullptr);
     vk::SemaphoreCreateInfo semaphore_info{};
     vk::FenceCreateInfo fence_info{};
     fence_info.setFlags(vk::FenceCreateFlagBits::eSignaled);
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+    for (size_t i = 0; i < frames_in_flight_; ++i) {
         image_available_semaphores_[i] = NVulkanDevice::Singleton().CreateSemaphore(semaphore_info);
         render_finished_semaphores_[i] = NVulkanDevice::Singleton().CreateSemaphore(semaphore_info);
         in_flight_fences_[i] = NVulkanDevice::Singleton().CreateFence(fence_info);
     }
 }
 
+void NVulkanSwapchain::DestroySyncObjects() {
+    for (size_t i = 0; i < in_flight_fences_.size(); ++i) {
+        NVulkanDevice::Singleton().DestroySemaphore(image_available_semaphores_[i]);
+        NVulkanDevice::Singleton().DestroySemaphore(render_finished_semaphores_[i]);
+        NVulkanDevice::Singleton().DestroyFence(in_flight_fences_[i]);
+    }
+    image_available_semaphores_.clear();
+    render_finished_semaphores_.clear();
+    in_flight_fences_.clear();
+    images_in_flight_.clear();
+}
+
+void NVulkanSwapchain::RetireDepthResources(RetiredResources& retired) {
+    retired.depth_images_ = std::move(depth_images_);
+    retired.depth_image_allocations_ = std::move(depth_image_allocations_);
+    retired.depth_image_views_ = std::move(depth_image_views_);
+    depth_images_.clear();
+    depth_image_allocations_.clear();
+    depth_image_views_.clear();
+    depth_extent_ = vk::Extent2D{};
+}
+
+void NVulkanSwapchain::CollectRetiredResources() {
+    auto it = retired_.begin();
+    while (it != retired_.end() && it->frame_ <= completed_frames_) {
+        DestroyResources(*it);
+        ++it;
+    }
+    retired_.erase(retired_.begin(), it);
+}
+
+void NVulkanSwapchain::DestroyResources(RetiredResources& resources) {
+    auto& device = NVulkanDevice::Singleton();
+    for (const auto& framebuffer : resources.framebuffers_) {
+        device.DestroyFramebuffer(framebuffer);
+    }
+    for (const auto& image_view : resources.image_views_) {
+        device.DestroyImageView(image_view);
+    }
+    for (size_t i = 0; i < resources.offscreen_images_.size(); ++i) {
+        device.DestroyImage(resources.offscreen_images_[i], resources.offscreen_image_allocations_[i]);
+    }
+    for (size_t i = 0; i < resources.depth_images_.size(); ++i) {
+        device.DestroyImageView(resources.depth_image_views_[i]);
+        device.DestroyImage(resources.depth_images_[i], resources.depth_image_allocations_[i]);
+    }
+    if (resources.render_pass_) {
+        device.DestroyRenderPass(resources.render_pass_);
+    }
+    if (resources.load_render_pass_) {
+        device.DestroyRenderPass(resources.load_render_pass_);
+    }
+    if (resources.swapchain_) {
+        device.DestroySwapchain(resources.swapchain_);
+    }
+    resources = {};
+}
+
 vk::SurfaceFormatKHR NVulkanSwapchain::ChooseSwapSurfaceFormat(const std::vector<vk::SurfaceFormatKHR>& available_formats) {
     for (const auto& available_format : available_formats) {
         if (available_format.format == vk::Format::eR8G8B8A8Srgb && available_format.colorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
@@ -200,5 +558,6 @@ vk::Extent2D NVulkanSwapchain::ChooseSwapExtent(const vk::SurfaceCapabilitiesKHR
 }
 
 vk::Format NVulkanSwapchain::FindDepthFormat() const {
-    return NVulkanDevice::Singleton().FindSupportFormat({vk::Format::eD32Sfloat, vk::Format::eD32SfloatS8Uint, vk::Format::eD24UnormS8Uint}, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment);
+    // Formats with a stencil aspect first: path fills are rendered stencil-then-cover.
+    return NVulkanDevice::Singleton().FindSupportFormat({vk::Format::eD24UnormS8Uint, vk::Format::eD32SfloatS8Uint, vk::Format::eD32Sfloat}, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment);
 }
\ No newline at end of file
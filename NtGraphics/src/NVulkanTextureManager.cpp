@@ -0,0 +1,322 @@
+/**
+ * @file NVulkanTextureManager.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanTextureManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#include "NProfiler.h"
+#include "NVulkanDevice.h"
+#include "NVulkanPhysical.h"
+
+static bool IsBlitSupported(vk::Format format) {
+    return NVulkanPhysical::Singleton().IsFormatSupported(format, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eBlitSrc | vk::FormatFeatureFlagBits::eBlitDst | vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
+}
+
+NVulkanTextureManager::NVulkanTextureManager(NVulkanUploader& uploader, size_t decode_threads)
+    : uploader_(uploader), loader_(decode_threads) {
+    auto max_anisotropy = (std::min)(MAX_ANISOTROPY, NVulkanPhysical::Singleton().GetCapabilities().properties_.limits.maxSamplerAnisotropy);
+    vk::SamplerCreateInfo sampler_info{};
+    sampler_info
+        .setMagFilter(vk::Filter::eLinear)
+        .setMinFilter(vk::Filter::eLinear)
+        .setMipmapMode(vk::SamplerMipmapMode::eLinear)
+        .setAddressModeU(vk::SamplerAddressMode::eRepeat)
+        .setAddressModeV(vk::SamplerAddressMode::eRepeat)
+        .setAddressModeW(vk::SamplerAddressMode::eRepeat)
+        .setAnisotropyEnable(max_anisotropy > 1.0F)
+        .setMaxAnisotropy(max_anisotropy)
+        .setMinLod(0.0F)
+        .setMaxLod(VK_LOD_CLAMP_NONE);
+    sampler_ = NVulkanDevice::Singleton().CreateSampler(sampler_info);
+}
+
+NVulkanTextureManager::~NVulkanTextureManager() {
+    auto& device = NVulkanDevice::Singleton();
+    device.WaitIdle();
+    for (auto& [id, entry] : entries_) {
+        DestroyTexture(entry.texture_);
+    }
+    for (auto& retired : retired_) {
+        DestroyTexture(retired.texture_);
+    }
+    device.DestroySampler(sampler_);
+}
+
+NVulkanTextureID NVulkanTextureManager::Create(std::vector<NImage> layers) {
+    auto id = next_id_++;
+    auto& entry = entries_[id];
+    try {
+        Stage(entry, layers);
+    } catch (...) {
+        entries_.erase(id);
+        throw;
+    }
+    pending_.push_back(id);
+    return id;
+}
+
+NVulkanTextureID NVulkanTextureManager::Load(const std::vector<std::filesystem::path>& layers) {
+    if (layers.empty()) {
+        throw std::runtime_error("A texture needs at least one layer.");
+    }
+    // Build the chain on the workers up front when the GPU could not blit it anyway.
+    auto generate_mips = !IsBlitSupported(ToFormat(NImageFormat::eRGBA8, true));
+    auto id = next_id_++;
+    auto& entry = entries_[id];
+    entry.decodes_.reserve(layers.size());
+    for (const auto& path : layers) {
+        entry.decodes_.push_back(loader_.Load(path, generate_mips));
+    }
+    pending_.push_back(id);
+    return id;
+}
+
+void NVulkanTextureManager::Update(const vk::CommandBuffer& command_buffer) {
+    N_PROFILE_ZONE("NVulkanTextureManager::Update");
+    ++frame_;
+    auto retired_end = std::partition(retired_.begin(), retired_.end(), [this](const Retired& retired) {
+        return retired.frame_ + RETIRE_FRAMES > frame_;
+    });
+    for (auto it = retired_end; it != retired_.end(); ++it) {
+        DestroyTexture(it->texture_);
+    }
+    retired_.erase(retired_end, retired_.end());
+
+    auto flush_count = uploader_.FlushCount();
+    for (size_t i = 0; i < pending_.size();) {
+        auto id = pending_[i];
+        auto& entry = entries_.at(id);
+        if (!entry.is_staged_) {
+            auto is_decoded = std::all_of(entry.decodes_.begin(), entry.decodes_.end(), [](const std::future<NImage>& decode) {
+                return decode.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+            if (!is_decoded) {
+                ++i;
+                continue;
+            }
+            std::vector<NImage> layers{};
+            layers.reserve(entry.decodes_.size());
+            try {
+                for (auto& decode : entry.decodes_) {
+                    layers.push_back(decode.get());
+                }
+                entry.decodes_.clear();
+                Stage(entry, layers);
+            } catch (...) {
+                entries_.erase(id);
+                pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(i));
+                throw;
+            }
+            // Staged now; the copies go out with the uploader's next Flush.
+            ++i;
+            continue;
+        }
+        if (entry.flush_ >= flush_count) {
+            ++i;
+            continue;
+        }
+        if (entry.needs_mips_) {
+            GenerateMips(command_buffer, entry.texture_);
+            entry.needs_mips_ = false;
+        }
+        entry.texture_.is_ready_ = true;
+        pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+}
+
+void NVulkanTextureManager::Destroy(NVulkanTextureID texture) {
+    auto it = entries_.find(texture);
+    if (it == entries_.end()) {
+        return;
+    }
+    // In-flight frames may still sample it; an undecoded load is simply abandoned.
+    if (it->second.texture_.image_) {
+        retired_.push_back({it->second.texture_, frame_});
+    }
+    entries_.erase(it);
+    pending_.erase(std::remove(pending_.begin(), pending_.end(), texture), pending_.end());
+}
+
+bool NVulkanTextureManager::IsReady(NVulkanTextureID texture) const {
+    auto it = entries_.find(texture);
+    return it != entries_.end() && it->second.texture_.is_ready_;
+}
+
+const NVulkanTexture& NVulkanTextureManager::Texture(NVulkanTextureID texture) const {
+    auto it = entries_.find(texture);
+    if (it == entries_.end()) {
+        throw std::runtime_error("Unknown texture.");
+    }
+    return it->second.texture_;
+}
+
+const vk::Sampler& NVulkanTextureManager::Sampler() const {
+    return sampler_;
+}
+
+NImageLoader& NVulkanTextureManager::Loader() {
+    return loader_;
+}
+
+size_t NVulkanTextureManager::PendingCount() const {
+    return pending_.size();
+}
+
+vk::Format NVulkanTextureManager::ToFormat(NImageFormat format, bool is_srgb) {
+    switch (format) {
+        case NImageFormat::eRGBA8:
+            return is_srgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+        case NImageFormat::eBC1:
+            return is_srgb ? vk::Format::eBc1RgbaSrgbBlock : vk::Format::eBc1RgbaUnormBlock;
+        case NImageFormat::eBC3:
+            return is_srgb ? vk::Format::eBc3SrgbBlock : vk::Format::eBc3UnormBlock;
+        case NImageFormat::eBC5:
+            return vk::Format::eBc5UnormBlock;
+        case NImageFormat::eBC7:
+            return is_srgb ? vk::Format::eBc7SrgbBlock : vk::Format::eBc7UnormBlock;
+        case NImageFormat::eASTC4x4:
+            return is_srgb ? vk::Format::eAstc4x4SrgbBlock : vk::Format::eAstc4x4UnormBlock;
+    }
+    return vk::Format::eUndefined;
+}
+
+bool NVulkanTextureManager::IsFormatSupported(NImageFormat format, bool is_srgb) {
+    return NVulkanPhysical::Singleton().IsFormatSupported(ToFormat(format, is_srgb), vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eSampledImage | vk::FormatFeatureFlagBits::eTransferDst);
+}
+
+void NVulkanTextureManager::Stage(Entry& entry, std::vector<NImage>& layers) {
+    if (layers.empty() || layers.front().Empty()) {
+        throw std::runtime_error("A texture needs at least one non-empty layer.");
+    }
+    const auto& first = layers.front();
+    auto is_matching = std::all_of(layers.begin(), layers.end(), [&first](const NImage& layer) {
+        return layer.format_ == first.format_ && layer.is_srgb_ == first.is_srgb_ && layer.Width() == first.Width() && layer.Height() == first.Height() && layer.levels_.size() == first.levels_.size();
+    });
+    if (!is_matching) {
+        throw std::runtime_error("Texture layers differ in format, size or mip count.");
+    }
+    if (!IsFormatSupported(first.format_, first.is_srgb_)) {
+        throw std::runtime_error("Texture format is not supported by the device.");
+    }
+    auto& texture = entry.texture_;
+    texture.format_ = ToFormat(first.format_, first.is_srgb_);
+    texture.extent_ = vk::Extent2D{first.Width(), first.Height()};
+    texture.layers_ = static_cast<uint32_t>(layers.size());
+    // Compressed and complete chains go up as they are; otherwise blit on the GPU or filter on the CPU.
+    auto upload_levels = static_cast<uint32_t>(first.levels_.size());
+    texture.mip_levels_ = upload_levels;
+    if (!first.IsCompressed() && !first.HasMipChain()) {
+        texture.mip_levels_ = NImage::MipCount(first.Width(), first.Height());
+        if (IsBlitSupported(texture.format_)) {
+            entry.needs_mips_ = true;
+            upload_levels = 1;
+        } else {
+            for (auto& layer : layers) {
+                layer.GenerateMips();
+            }
+            upload_levels = texture.mip_levels_;
+        }
+    }
+
+    auto& device = NVulkanDevice::Singleton();
+    vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
+    if (entry.needs_mips_) {
+        usage |= vk::ImageUsageFlagBits::eTransferSrc;
+    }
+    vk::ImageCreateInfo image_info{};
+    image_info
+        .setImageType(vk::ImageType::e2D)
+        .setFormat(texture.format_)
+        .setExtent({texture.extent_.width, texture.extent_.height, 1})
+        .setMipLevels(texture.mip_levels_)
+        .setArrayLayers(texture.layers_)
+        .setSamples(vk::SampleCountFlagBits::e1)
+        .setTiling(vk::ImageTiling::eOptimal)
+        .setUsage(usage)
+        .setSharingMode(vk::SharingMode::eExclusive)
+        .setInitialLayout(vk::ImageLayout::eUndefined);
+    device.CreateImage(image_info, vk::MemoryPropertyFlagBits::eDeviceLocal, texture.image_, texture.allocation_);
+    vk::ImageViewCreateInfo view_info{};
+    view_info
+        .setImage(texture.image_)
+        .setViewType(texture.layers_ > 1 ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D)
+        .setFormat(texture.format_)
+        .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, texture.mip_levels_, 0, texture.layers_});
+    texture.image_view_ = device.CreateImageView(view_info);
+
+    // The base level of a GPU-mipped image stays a blit source until Update builds the chain.
+    auto final_layout = entry.needs_mips_ ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
+    vk::PipelineStageFlags dst_stages = entry.needs_mips_ ? vk::PipelineStageFlagBits::eTransfer : vk::PipelineStageFlagBits::eFragmentShader;
+    vk::AccessFlags dst_access = entry.needs_mips_ ? vk::AccessFlagBits::eTransferRead : vk::AccessFlagBits::eShaderRead;
+    for (uint32_t layer = 0; layer < texture.layers_; ++layer) {
+        for (uint32_t level = 0; level < upload_levels; ++level) {
+            const auto& source = layers[layer].levels_[level];
+            uploader_.UploadImage(source.data_.data(), source.data_.size(), texture.image_, {source.width_, source.height_, 1}, final_layout, dst_stages, dst_access, {vk::ImageAspectFlagBits::eColor, level, layer, 1});
+        }
+    }
+    entry.flush_ = uploader_.FlushCount();
+    entry.is_staged_ = true;
+}
+
+void NVulkanTextureManager::GenerateMips(const vk::CommandBuffer& command_buffer, const NVulkanTexture& texture) const {
+    vk::ImageMemoryBarrier barrier{};
+    barrier
+        .setSrcAccessMask({})
+        .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setOldLayout(vk::ImageLayout::eUndefined)
+        .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setImage(texture.image_)
+        .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 1, texture.mip_levels_ - 1, 0, texture.layers_});
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+
+    auto width = static_cast<int32_t>(texture.extent_.width);
+    auto height = static_cast<int32_t>(texture.extent_.height);
+    for (uint32_t level = 1; level < texture.mip_levels_; ++level) {
+        auto next_width = (std::max)(width / 2, 1);
+        auto next_height = (std::max)(height / 2, 1);
+        vk::ImageBlit blit{};
+        blit
+            .setSrcSubresource({vk::ImageAspectFlagBits::eColor, level - 1, 0, texture.layers_})
+            .setSrcOffsets({vk::Offset3D{0, 0, 0}, vk::Offset3D{width, height, 1}})
+            .setDstSubresource({vk::ImageAspectFlagBits::eColor, level, 0, texture.layers_})
+            .setDstOffsets({vk::Offset3D{0, 0, 0}, vk::Offset3D{next_width, next_height, 1}});
+        command_buffer.blitImage(texture.image_, vk::ImageLayout::eTransferSrcOptimal, texture.image_, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+        barrier
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferRead)
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+            .setSubresourceRange({vk::ImageAspectFlagBits::eColor, level, 1, 0, texture.layers_});
+        command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+        width = next_width;
+        height = next_height;
+    }
+
+    barrier
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eTransferRead)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead)
+        .setOldLayout(vk::ImageLayout::eTransferSrcOptimal)
+        .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, texture.mip_levels_, 0, texture.layers_});
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrier);
+}
+
+void NVulkanTextureManager::DestroyTexture(NVulkanTexture& texture) const {
+    auto& device = NVulkanDevice::Singleton();
+    if (texture.image_view_) {
+        device.DestroyImageView(texture.image_view_);
+    }
+    if (texture.image_) {
+        device.DestroyImage(texture.image_, texture.allocation_);
+    }
+    texture = NVulkanTexture{};
+}
@@ -0,0 +1,382 @@
+/**
+ * @file NVulkanUploader.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include "NVulkanUploader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "NProfiler.h"
+#include "NVulkanDevice.h"
+#include "NVulkanPhysical.h"
+
+static vk::DeviceSize AlignUp(vk::DeviceSize value, vk::DeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+NVulkanUploader::NVulkanUploader(vk::DeviceSize staging_size) : capacity_(staging_size) {
+    auto& device = NVulkanDevice::Singleton();
+    const auto& physical = NVulkanPhysical::Singleton();
+    graphics_family_ = physical.QueueFamilies().graphics_family_;
+    transfer_family_ = physical.QueueFamilies().transfer_family_;
+    alignment_ = (std::max)(alignment_, physical.GetCapabilities().properties_.limits.optimalBufferCopyOffsetAlignment);
+    device.CreateBuffer(capacity_, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, staging_buffer_, staging_allocation_);
+    if (!staging_allocation_.mapped_) {
+        throw std::runtime_error("Staging memory is not host visible.");
+    }
+    command_allocator_ = std::make_unique<NVulkanCommandAllocator>(transfer_family_, BATCH_COUNT);
+    vk::FenceCreateInfo fence_info{};
+    fence_info.setFlags(vk::FenceCreateFlagBits::eSignaled);
+    vk::SemaphoreCreateInfo semaphore_info{};
+    for (auto& batch : batches_) {
+        batch.fence_ = device.CreateFence(fence_info);
+        batch.semaphore_ = device.CreateSemaphore(semaphore_info);
+    }
+}
+
+NVulkanUploader::~NVulkanUploader() {
+    auto& device = NVulkanDevice::Singleton();
+    if (is_recording_) {
+        Submit(false);
+    }
+    WaitIdle();
+    if (!graphics_copies_.empty() || !retired_copies_.empty()) {
+        // Their staging buffers may still be read by frames in flight.
+        device.WaitIdle();
+        retired_copies_.insert(retired_copies_.end(), graphics_copies_.begin(), graphics_copies_.end());
+        for (auto& copy : retired_copies_) {
+            device.DestroyBuffer(copy.buffer_, copy.allocation_);
+        }
+    }
+    for (auto& batch : batches_) {
+        device.DestroyFence(batch.fence_);
+        device.DestroySemaphore(batch.semaphore_);
+    }
+    command_allocator_.reset();
+    device.DestroyBuffer(staging_buffer_, staging_allocation_);
+}
+
+void NVulkanUploader::UploadBuffer(const void* data, vk::DeviceSize size, const vk::Buffer& buffer, vk::DeviceSize offset, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access) {
+    if (size == 0) {
+        return;
+    }
+    vk::Buffer source{};
+    vk::DeviceSize source_offset{};
+    Stage(data, size, alignment_, source, source_offset);
+    auto command_buffer = PendingCommandBuffer();
+    command_buffer.copyBuffer(source, buffer, vk::BufferCopy{source_offset, offset, size});
+
+    auto is_dedicated = transfer_family_ != graphics_family_;
+    vk::BufferMemoryBarrier barrier{};
+    barrier
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(is_dedicated ? vk::AccessFlags{} : dst_access)
+        .setSrcQueueFamilyIndex(is_dedicated ? transfer_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(is_dedicated ? graphics_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setBuffer(buffer)
+        .setOffset(offset)
+        .setSize(size);
+    release_buffer_barriers_.push_back(barrier);
+    if (is_dedicated) {
+        barrier
+            .setSrcAccessMask({})
+            .setDstAccessMask(dst_access);
+        acquire_buffer_barriers_.push_back(barrier);
+    }
+    pending_dst_stages_ |= dst_stages;
+}
+
+void NVulkanUploader::UploadImage(const void* data, vk::DeviceSize size, const vk::Image& image, const vk::Extent3D& extent, vk::ImageLayout final_layout, const vk::PipelineStageFlags& dst_stages, const vk::AccessFlags& dst_access, const vk::ImageSubresourceLayers& subresource, const vk::Offset3D& offset, vk::ImageLayout current_layout) {
+    if (size == 0) {
+        return;
+    }
+    vk::BufferImageCopy region{};
+    region
+        .setImageSubresource(subresource)
+        .setImageOffset(offset)
+        .setImageExtent(extent);
+    auto is_preserving = current_layout != vk::ImageLayout::eUndefined;
+    if (is_preserving && HasDedicatedTransferQueue()) {
+        // The transfer family never owned the existing texels, so it can't keep them.
+        GraphicsCopy copy{};
+        NVulkanDevice::Singleton().CreateBuffer(size, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, copy.buffer_, copy.allocation_);
+        std::memcpy(copy.allocation_.mapped_, data, static_cast<size_t>(size));
+        copy.image_ = image;
+        copy.region_ = region;
+        copy.current_layout_ = current_layout;
+        copy.final_layout_ = final_layout;
+        copy.dst_stages_ = dst_stages;
+        copy.dst_access_ = dst_access;
+        graphics_copies_.push_back(copy);
+        return;
+    }
+    vk::Buffer source{};
+    vk::DeviceSize source_offset{};
+    Stage(data, size, alignment_, source, source_offset);
+    auto command_buffer = PendingCommandBuffer();
+
+    vk::ImageSubresourceRange range{subresource.aspectMask, subresource.mipLevel, 1, subresource.baseArrayLayer, subresource.layerCount};
+    vk::ImageMemoryBarrier to_transfer{};
+    to_transfer
+        .setSrcAccessMask(is_preserving ? vk::AccessFlagBits::eMemoryWrite : vk::AccessFlags{})
+        .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setOldLayout(current_layout)
+        .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setImage(image)
+        .setSubresourceRange(range);
+    command_buffer.pipelineBarrier(is_preserving ? vk::PipelineStageFlagBits::eAllCommands : vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, to_transfer);
+    region.setBufferOffset(source_offset);
+    command_buffer.copyBufferToImage(source, image, vk::ImageLayout::eTransferDstOptimal, region);
+
+    auto is_dedicated = transfer_family_ != graphics_family_;
+    vk::ImageMemoryBarrier barrier{};
+    barrier
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(is_dedicated ? vk::AccessFlags{} : dst_access)
+        .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setNewLayout(final_layout)
+        .setSrcQueueFamilyIndex(is_dedicated ? transfer_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(is_dedicated ? graphics_family_ : VK_QUEUE_FAMILY_IGNORED)
+        .setImage(image)
+        .setSubresourceRange(range);
+    release_image_barriers_.push_back(barrier);
+    if (is_dedicated) {
+        barrier
+            .setSrcAccessMask({})
+            .setDstAccessMask(dst_access);
+        acquire_image_barriers_.push_back(barrier);
+    }
+    pending_dst_stages_ |= dst_stages;
+}
+
+NVulkanQueueSync NVulkanUploader::Flush() {
+    N_PROFILE_ZONE("NVulkanUploader::Flush");
+    ++flush_count_;
+    ReclaimGraphicsCopies();
+    if (!HasDedicatedTransferQueue()) {
+        if (is_recording_) {
+            Submit(false);
+        }
+        return {};
+    }
+    if (acquire_buffer_barriers_.empty() && acquire_image_barriers_.empty()) {
+        return {};
+    }
+    // Batches submitted early because the ring was full are covered too: a semaphore signal waits for
+    // everything submitted before it on the transfer queue.
+    PendingCommandBuffer();
+    auto& batch = batches_[current_batch_];
+    Submit(true);
+    return {batch.semaphore_, acquire_dst_stages_};
+}
+
+void NVulkanUploader::RecordAcquireBarriers(const vk::CommandBuffer& command_buffer) {
+    if (!acquire_buffer_barriers_.empty() || !acquire_image_barriers_.empty()) {
+        command_buffer.pipelineBarrier(acquire_dst_stages_, acquire_dst_stages_, {}, {}, acquire_buffer_barriers_, acquire_image_barriers_);
+        acquire_buffer_barriers_.clear();
+        acquire_image_barriers_.clear();
+        acquire_dst_stages_ = {};
+    }
+    for (auto& copy : graphics_copies_) {
+        const auto& subresource = copy.region_.imageSubresource;
+        vk::ImageSubresourceRange range{subresource.aspectMask, subresource.mipLevel, 1, subresource.baseArrayLayer, subresource.layerCount};
+        vk::ImageMemoryBarrier barrier{};
+        barrier
+            .setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setOldLayout(copy.current_layout_)
+            .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+            .setImage(copy.image_)
+            .setSubresourceRange(range);
+        command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+        command_buffer.copyBufferToImage(copy.buffer_, copy.image_, vk::ImageLayout::eTransferDstOptimal, copy.region_);
+        barrier
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(copy.dst_access_)
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(copy.final_layout_);
+        command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, copy.dst_stages_ ? copy.dst_stages_ : vk::PipelineStageFlags{vk::PipelineStageFlagBits::eAllCommands}, {}, {}, {}, barrier);
+        // The frame recorded here is done once BATCH_COUNT more flushes have started.
+        copy.flush_ = flush_count_;
+        retired_copies_.push_back(copy);
+    }
+    graphics_copies_.clear();
+}
+
+void NVulkanUploader::WaitIdle() {
+    while (batches_[oldest_batch_].is_in_flight_) {
+        ReclaimOldest();
+    }
+}
+
+bool NVulkanUploader::HasDedicatedTransferQueue() const {
+    return transfer_family_ != graphics_family_;
+}
+
+vk::DeviceSize NVulkanUploader::StagingSize() const {
+    return capacity_;
+}
+
+vk::DeviceSize NVulkanUploader::StagingUsed() const {
+    return used_;
+}
+
+uint64_t NVulkanUploader::FlushCount() const {
+    return flush_count_;
+}
+
+NVulkanUploader::Batch& NVulkanUploader::PendingBatch() {
+    PendingCommandBuffer();
+    return batches_[current_batch_];
+}
+
+vk::CommandBuffer NVulkanUploader::PendingCommandBuffer() {
+    auto& batch = batches_[current_batch_];
+    if (is_recording_) {
+        return batch.command_buffer_;
+    }
+    while (batches_[oldest_batch_].is_in_flight_ && NVulkanDevice::Singleton().IsFenceSignaled(batches_[oldest_batch_].fence_)) {
+        ReclaimOldest();
+    }
+    while (batch.is_in_flight_) {
+        ReclaimOldest();
+    }
+    command_allocator_->BeginFrame(current_batch_);
+    batch.command_buffer_ = command_allocator_->AllocatePrimary();
+    vk::CommandBufferBeginInfo begin_info{};
+    begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    batch.command_buffer_.begin(begin_info);
+    is_recording_ = true;
+    return batch.command_buffer_;
+}
+
+void NVulkanUploader::Stage(const void* data, vk::DeviceSize size, vk::DeviceSize alignment, vk::Buffer& buffer, vk::DeviceSize& offset) {
+    auto& batch = PendingBatch();
+    if (size + alignment > capacity_) {
+        batch.dedicated_buffers_.emplace_back();
+        batch.dedicated_allocations_.emplace_back();
+        NVulkanDevice::Singleton().CreateBuffer(size, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, batch.dedicated_buffers_.back(), batch.dedicated_allocations_.back());
+        std::memcpy(batch.dedicated_allocations_.back().mapped_, data, static_cast<size_t>(size));
+        buffer = batch.dedicated_buffers_.back();
+        offset = 0;
+        return;
+    }
+    while (!TryAllocate(size, alignment, offset)) {
+        if (!batches_[oldest_batch_].is_in_flight_) {
+            // Only the batch being recorded holds ring space, so submit it and wait for it to drain.
+            Submit(false);
+        }
+        ReclaimOldest();
+    }
+    std::memcpy(static_cast<char*>(staging_allocation_.mapped_) + offset, data, static_cast<size_t>(size));
+    buffer = staging_buffer_;
+}
+
+bool NVulkanUploader::TryAllocate(vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize& offset) {
+    if (used_ == 0) {
+        head_ = 0;
+        tail_ = 0;
+    }
+    if (used_ > 0 && head_ == tail_) {
+        return false;
+    }
+    auto aligned = AlignUp(head_, alignment);
+    if (head_ > tail_ || used_ == 0) {
+        if (aligned + size <= capacity_) {
+            offset = aligned;
+            used_ += aligned + size - head_;
+            pending_bytes_ += aligned + size - head_;
+            head_ = aligned + size;
+            return true;
+        }
+        if (size <= tail_) {
+            // Wrap around; the unused tail end of the ring is charged to this batch.
+            offset = 0;
+            used_ += capacity_ - head_ + size;
+            pending_bytes_ += capacity_ - head_ + size;
+            head_ = size;
+            return true;
+        }
+        return false;
+    }
+    if (aligned + size <= tail_) {
+        offset = aligned;
+        used_ += aligned + size - head_;
+        pending_bytes_ += aligned + size - head_;
+        head_ = aligned + size;
+        return true;
+    }
+    return false;
+}
+
+void NVulkanUploader::Submit(bool signal_semaphore) {
+    auto& batch = batches_[current_batch_];
+    const auto& command_buffer = batch.command_buffer_;
+    if (!release_buffer_barriers_.empty() || !release_image_barriers_.empty()) {
+        auto dst_stages = HasDedicatedTransferQueue() ? vk::PipelineStageFlags{vk::PipelineStageFlagBits::eBottomOfPipe} : pending_dst_stages_;
+        if (!dst_stages) {
+            dst_stages = vk::PipelineStageFlagBits::eAllCommands;
+        }
+        command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, dst_stages, {}, {}, release_buffer_barriers_, release_image_barriers_);
+    }
+    command_buffer.end();
+    vk::SubmitInfo submit_info{};
+    submit_info.setCommandBuffers(command_buffer);
+    if (signal_semaphore) {
+        submit_info.setSignalSemaphores(batch.semaphore_);
+    }
+    NVulkanDevice::Singleton().ResetFence(batch.fence_);
+    NVulkanDevice::Singleton().SubmitTransfer(submit_info, batch.fence_);
+    batch.ring_end_ = head_;
+    batch.ring_bytes_ = pending_bytes_;
+    batch.is_in_flight_ = true;
+    pending_bytes_ = 0;
+    is_recording_ = false;
+    acquire_dst_stages_ |= pending_dst_stages_;
+    pending_dst_stages_ = {};
+    release_buffer_barriers_.clear();
+    release_image_barriers_.clear();
+    current_batch_ = (current_batch_ + 1) % BATCH_COUNT;
+}
+
+void NVulkanUploader::Reclaim(Batch& batch, bool wait) {
+    if (wait) {
+        NVulkanDevice::Singleton().WaitForFences({batch.fence_});
+    }
+    tail_ = batch.ring_end_;
+    used_ -= batch.ring_bytes_;
+    for (size_t i = 0; i < batch.dedicated_buffers_.size(); ++i) {
+        NVulkanDevice::Singleton().DestroyBuffer(batch.dedicated_buffers_[i], batch.dedicated_allocations_[i]);
+    }
+    batch.dedicated_buffers_.clear();
+    batch.dedicated_allocations_.clear();
+    batch.ring_bytes_ = 0;
+    batch.is_in_flight_ = false;
+}
+
+void NVulkanUploader::ReclaimGraphicsCopies() {
+    auto retired_end = std::partition(retired_copies_.begin(), retired_copies_.end(), [this](const GraphicsCopy& copy) {
+        return copy.flush_ + BATCH_COUNT > flush_count_;
+    });
+    for (auto it = retired_end; it != retired_copies_.end(); ++it) {
+        NVulkanDevice::Singleton().DestroyBuffer(it->buffer_, it->allocation_);
+    }
+    retired_copies_.erase(retired_end, retired_copies_.end());
+}
+
+void NVulkanUploader::ReclaimOldest() {
+    auto& batch = batches_[oldest_batch_];
+    if (!batch.is_in_flight_) {
+        return;
+    }
+    Reclaim(batch, true);
+    oldest_batch_ = (oldest_batch_ + 1) % BATCH_COUNT;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file NVulkanAllocatorTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <iostream>
+
+#include "NVulkanDevice.h"
+
+int main() {
+    auto& device = NVulkanDevice::Singleton();
+    std::vector<vk::Buffer> buffers(64);
+    std::vector<NVulkanAllocation> allocations(64);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        device.CreateBuffer(4096 * (i + 1), vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal, buffers[i], allocations[i]);
+    }
+    for (size_t i = 0; i < buffers.size(); i += 2) {
+        device.DestroyBuffer(buffers[i], allocations[i]);
+    }
+    for (const auto& heap : device.GetHeapStatistics()) {
+        std::cout << "heap " << heap.heap_size_ << ": " << heap.block_count_ << " blocks, "
+                  << heap.allocation_count_ << " allocations, " << heap.used_bytes_ << "/" << heap.reserved_bytes_ << " bytes, "
+                  << heap.free_range_count_ << " free ranges, largest " << heap.largest_free_range_ << std::endl;
+    }
+    for (const auto& heap : device.GetHeapBudgets()) {
+        std::cout << (heap.is_device_local_ ? "device" : "host") << " heap " << heap.heap_size_ << ": "
+                  << heap.usage_ << "/" << heap.budget_ << " bytes used, " << heap.allocated_ << " allocated by Nt" << std::endl;
+    }
+    for (size_t i = 1; i < buffers.size(); i += 2) {
+        device.DestroyBuffer(buffers[i], allocations[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file NVulkanAsyncComputeTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <iostream>
+
+#include "NVulkanAsyncCompute.h"
+#include "NVulkanDevice.h"
+#include "NVulkanPipelineManager.h"
+#include "NVulkanRender.h"
+#include "NVulkanShaderLibrary.h"
+
+int main() {
+    static constexpr int FRAME_COUNT{120};
+    static constexpr uint32_t ELEMENT_COUNT{256 * 1024};
+    static constexpr uint32_t GROUP_SIZE{64};
+    static constexpr vk::DeviceSize BUFFER_SIZE{ELEMENT_COUNT * sizeof(uint32_t)};
+    auto& device = NVulkanDevice::Singleton();
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 1280, 720, 2);
+    NVulkanAsyncCompute compute;
+    vk::Buffer buffer{};
+    NVulkanAllocation allocation{};
+    device.CreateBuffer(BUFFER_SIZE, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eDeviceLocal, buffer, allocation);
+    vk::Buffer readback_buffer{};
+    NVulkanAllocation readback_allocation{};
+    device.CreateBuffer(BUFFER_SIZE, vk::BufferUsageFlagBits::eTransferDst, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, readback_buffer, readback_allocation);
+
+    // The layout and push constants come from the embedded shader's reflection.
+    auto bindings = NVulkanShaderLibrary::SetLayoutBindings({"Fill.comp"}, 0);
+    vk::DescriptorSetLayoutCreateInfo layout_info{};
+    layout_info.setBindings(bindings);
+    auto set_layout = device.CreateDescriptorSetLayout(layout_info);
+    vk::DescriptorPoolSize pool_size{vk::DescriptorType::eStorageBuffer, 1};
+    vk::DescriptorPoolCreateInfo pool_info{};
+    pool_info
+        .setMaxSets(1)
+        .setPoolSizes(pool_size);
+    auto descriptor_pool = device.CreateDescriptorPool(pool_info);
+    vk::DescriptorSetAllocateInfo set_info{};
+    set_info
+        .setDescriptorPool(descriptor_pool)
+        .setSetLayouts(set_layout);
+    auto descriptor_set = device.AllocateDescriptorSets(set_info).front();
+    vk::DescriptorBufferInfo buffer_info{buffer, 0, BUFFER_SIZE};
+    vk::WriteDescriptorSet write{};
+    write
+        .setDstSet(descriptor_set)
+        .setDstBinding(0)
+        .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+        .setBufferInfo(buffer_info);
+    device.UpdateDescriptorSets({write});
+    NVulkanComputePipelineState state{};
+    state.stage_ = NVulkanShaderLibrary::Stage("Fill.comp");
+    state.descriptor_set_layouts_ = {set_layout};
+    state.push_constant_ranges_ = NVulkanShaderLibrary::PushConstantRanges({"Fill.comp"});
+    auto pipeline = NVulkanPipelineManager::Singleton().CreateComputePipeline(state);
+    if (!pipeline || NVulkanPipelineManager::Singleton().CreateComputePipeline(state) != pipeline) {
+        return 1;
+    }
+
+    vk::SemaphoreCreateInfo semaphore_info{};
+    auto graphics_done = device.CreateSemaphore(semaphore_info);
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        auto compute_command_buffer = compute.Begin();
+        pipeline->Bind(compute_command_buffer);
+        compute_command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline->Layout(), 0, descriptor_set, {});
+        uint32_t push_constants[2]{static_cast<uint32_t>(i), ELEMENT_COUNT};
+        compute_command_buffer.pushConstants(pipeline->Layout(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(push_constants), push_constants);
+        compute_command_buffer.dispatch((ELEMENT_COUNT + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+        if (i > 0 && compute.HasAsyncQueue()) {
+            // The previous frame copied the buffer out on the graphics queue.
+            compute.AddWaitSemaphore(graphics_done, vk::PipelineStageFlagBits::eComputeShader);
+        }
+        // Ownership goes back to the graphics family, which reads the results with a copy.
+        compute.ReleaseBuffer(buffer, 0, BUFFER_SIZE, vk::AccessFlagBits::eShaderWrite, vk::PipelineStageFlagBits::eTransfer, vk::AccessFlagBits::eTransferRead);
+        auto sync = compute.Submit();
+
+        auto command_buffer = render.BeginFrame();
+        if (sync) {
+            render.AddWaitSemaphore(sync.semaphore_, sync.wait_stages_);
+        }
+        if (compute.HasAsyncQueue()) {
+            render.AddSignalSemaphore(graphics_done);
+        }
+        compute.RecordAcquireBarriers(command_buffer);
+        command_buffer.copyBuffer(buffer, readback_buffer, vk::BufferCopy{0, 0, BUFFER_SIZE});
+        vk::MemoryBarrier readback_barrier{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead};
+        command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, readback_barrier, {}, {});
+        render.BeginSwapchainRenderPass(command_buffer);
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+    }
+    device.WaitIdle();
+    compute.WaitIdle();
+
+    // The readback holds what the last dispatch wrote.
+    auto is_equal = readback_allocation.mapped_ != nullptr;
+    const auto* results = static_cast<const uint32_t*>(readback_allocation.mapped_);
+    for (uint32_t i = 0; is_equal && i < ELEMENT_COUNT; ++i) {
+        is_equal = results[i] == static_cast<uint32_t>(FRAME_COUNT - 1) + i;
+    }
+    std::cout << "async compute queue: " << compute.HasAsyncQueue() << ", family: " << compute.QueueFamily() << ", results " << (is_equal ? "match" : "differ") << std::endl;
+    pipeline.reset();
+    device.DestroySemaphore(graphics_done);
+    device.DestroyDescriptorPool(descriptor_pool);
+    device.DestroyDescriptorSetLayout(set_layout);
+    device.DestroyBuffer(readback_buffer, readback_allocation);
+    device.DestroyBuffer(buffer, allocation);
+    return is_equal ? 0 : 1;
+}
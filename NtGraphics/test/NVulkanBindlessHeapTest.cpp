@@ -0,0 +1,80 @@
+/**
+ * @file NVulkanBindlessHeapTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "NVulkanBindlessHeap.h"
+#include "NVulkanDevice.h"
+
+int main() {
+    auto& device = NVulkanDevice::Singleton();
+    if (!device.HasBindless()) {
+        std::cout << "descriptor indexing is not supported, skipped" << std::endl;
+        return 0;
+    }
+    NVulkanBindlessHeap heap(1024, 256);
+    vk::Buffer buffer{};
+    NVulkanAllocation allocation{};
+    device.CreateBuffer(64 * 1024, vk::BufferUsageFlagBits::eStorageBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal, buffer, allocation);
+
+    // Handles are dense, and a released slot only comes back once the frames in flight have retired.
+    std::vector<NVulkanBindlessHandle> handles{};
+    for (vk::DeviceSize i = 0; i < 16; ++i) {
+        handles.push_back(heap.AddBuffer(buffer, i * 4096, 4096));
+    }
+    if (handles.front() != 0 || handles.back() != 15 || heap.BufferCount() != 16) {
+        return 1;
+    }
+    heap.ReleaseBuffer(handles[3]);
+    for (uint32_t frame = 0; frame + 1 < NVulkanBindlessHeap::RETIRE_FRAMES; ++frame) {
+        heap.BeginFrame();
+    }
+    if (heap.AddBuffer(buffer) != 16) {
+        return 1;
+    }
+    heap.BeginFrame();
+    if (heap.AddBuffer(buffer) != 3) {
+        return 1;
+    }
+    try {
+        heap.ReleaseBuffer(200);
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    // Equal create infos share one sampler.
+    vk::SamplerCreateInfo sampler_info{};
+    sampler_info
+        .setMagFilter(vk::Filter::eLinear)
+        .setMinFilter(vk::Filter::eLinear)
+        .setMipmapMode(vk::SamplerMipmapMode::eLinear)
+        .setMaxLod(VK_LOD_CLAMP_NONE);
+    auto linear = heap.GetSampler(sampler_info);
+    auto nearest = heap.GetSampler(vk::SamplerCreateInfo{sampler_info}.setMagFilter(vk::Filter::eNearest).setMinFilter(vk::Filter::eNearest));
+    if (heap.GetSampler(sampler_info) != linear || linear == nearest || heap.SamplerCount() != 2) {
+        return 1;
+    }
+
+    // Churn: register and release a frame's worth of buffers every frame.
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < 1000; ++frame) {
+        heap.BeginFrame();
+        std::vector<NVulkanBindlessHandle> transient{};
+        for (int i = 0; i < 32; ++i) {
+            transient.push_back(heap.AddBuffer(buffer));
+        }
+        for (auto handle : transient) {
+            heap.ReleaseBuffer(handle);
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "32000 buffer slots recycled in " << elapsed.count() << " ms, texture capacity " << heap.TextureCapacity() << std::endl;
+    device.DestroyBuffer(buffer, allocation);
+    return heap.BufferCount() == 17 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file NVulkanCommandAllocatorTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "NVulkanRender.h"
+
+int main() {
+    static constexpr int FRAME_COUNT{500};
+    static constexpr size_t WORKER_COUNT{4};
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 1280, 720, 2);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        auto command_buffer = render.BeginFrame();
+        if (!command_buffer) {
+            continue;
+        }
+        render.BeginSwapchainRenderPass(command_buffer, vk::SubpassContents::eSecondaryCommandBuffers);
+        std::vector<vk::CommandBuffer> secondaries(WORKER_COUNT);
+        std::vector<std::thread> workers;
+        for (size_t j = 0; j < WORKER_COUNT; ++j) {
+            workers.emplace_back([&render, &secondaries, j] {
+                secondaries[j] = render.BeginSecondaryCommandBuffer();
+                secondaries[j].end();
+                render.CommandAllocator().ReleaseThread();
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        command_buffer.executeCommands(secondaries);
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // Only the main thread keeps its pools; released ones wait at most one lap of the frame slots.
+    auto& allocator = render.CommandAllocator();
+    if (allocator.ThreadCount() != 1 || allocator.RetiredCount() > WORKER_COUNT * allocator.FramesInFlight()) {
+        return 1;
+    }
+    std::cout << FRAME_COUNT << " frames with " << WORKER_COUNT << " recording threads in " << elapsed.count() << " s, "
+              << allocator.RetiredCount() << " retired thread pools" << std::endl;
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file NVulkanGlyphAtlasTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "NTextCache.h"
+#include "NVulkanDevice.h"
+#include "NVulkanGlyphAtlas.h"
+#include "NVulkanPrimitiveRenderer.h"
+#include "NVulkanRender.h"
+
+#if !defined(_WIN32)
+// No font backend on this platform; solid boxes still exercise the atlas and the text pipeline.
+#include "../../NtCore/test/NBoxRasterizer.h"
+#endif
+
+int main() {
+    static constexpr int FRAME_COUNT{120};
+#if defined(_WIN32)
+    auto rasterizer = std::make_unique<NGdiGlyphRasterizer>();
+#else
+    auto rasterizer = std::make_unique<NBoxRasterizer>();
+#endif
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 1920, 1080, 2);
+    NVulkanPrimitiveRenderer renderer(render.RenderPass(), render.FramesInFlight());
+    NGlyphAtlas atlas(*rasterizer);
+    NVulkanGlyphAtlas gpu_atlas(atlas, renderer, render.FramesInFlight());
+    NTextCache text_cache(*rasterizer, atlas);
+    NFont font{L"Segoe UI", 14.0F};
+
+    NDrawList draw_list;
+    double record_ms = 0.0;
+    vk::DeviceSize uploaded_bytes = 0;
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        if (frame == FRAME_COUNT / 2) {
+            // The atlas was built for two staging slots and must grow with the swapchain.
+            render.SetFramesInFlight(3);
+        }
+        auto command_buffer = render.BeginFrame();
+        if (!command_buffer) {
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        atlas.BeginFrame();
+        draw_list.Clear();
+        for (int i = 0; i < 1000; ++i) {
+            text_cache.DrawText(draw_list, L"Channel " + std::to_wstring(i) + L": nominal", font, {static_cast<float>(i % 10) * 190.0F, static_cast<float>(i / 10) * 10.0F + 14.0F}, {1.0F, 1.0F, 1.0F, 1.0F});
+        }
+        if (frame >= FRAME_COUNT / 2) {
+            // A glyph not seen before keeps every later frame uploading through its own slot.
+            text_cache.DrawText(draw_list, std::wstring(1, static_cast<wchar_t>(0x4E00 + frame)), font, {0.0F, 1060.0F}, {1.0F, 1.0F, 1.0F, 1.0F});
+        }
+        renderer.Prepare(draw_list, render.CurrentFrameIndex());
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        record_ms += elapsed.count();
+        gpu_atlas.Update(command_buffer, render.CurrentFrameIndex());
+        // The first upload of a page covers all of it, so no texel is left undefined.
+        if (uploaded_bytes == 0 && gpu_atlas.UploadedBytes() < static_cast<vk::DeviceSize>(atlas.PageSize()) * atlas.PageSize() * atlas.PageCount()) {
+            return 1;
+        }
+        if (frame >= FRAME_COUNT / 2 && gpu_atlas.UploadedBytes() == 0) {
+            return 1;
+        }
+        uploaded_bytes += gpu_atlas.UploadedBytes();
+        render.BeginSwapchainRenderPass(command_buffer);
+        renderer.Draw(command_buffer, render.Swapchain().Extent());
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+    }
+    std::cout << draw_list.PrimitiveCount() << " glyphs in " << renderer.DrawCallCount() << " draws, " << record_ms / FRAME_COUNT << " ms CPU per frame, "
+              << text_cache.ShapeCount() << " runs shaped, " << uploaded_bytes << " atlas bytes uploaded" << std::endl;
+    NVulkanDevice::Singleton().WaitIdle();
+    return 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file NVulkanMultiRenderTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <map>
+
+#include "NVulkanMultiRender.h"
+
+int main() {
+    static constexpr auto DURATION = std::chrono::seconds(2);
+    NVulkanMultiRender render(2);
+    auto unpaced = render.AddCanvas(NVulkanSwapchain::Backend::eOffscreen, 1280, 720);
+    auto fast = render.AddCanvas(NVulkanSwapchain::Backend::eOffscreen, 1280, 720, 120);
+    auto slow = render.AddCanvas(NVulkanSwapchain::Backend::eOffscreen, 640, 480, 60);
+    std::map<NVulkanMultiRender::CanvasID, int> frames;
+    size_t submissions = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < DURATION) {
+        if (render.RenderFrame([&frames](NVulkanMultiRender::CanvasID canvas_id, const vk::CommandBuffer&, const vk::Extent2D&) {
+                ++frames[canvas_id];
+            }) > 0) {
+            ++submissions;
+        }
+    }
+    std::cout << submissions << " submissions, unpaced " << frames[unpaced] << ", 120 Hz " << frames[fast] << ", 60 Hz " << frames[slow] << std::endl;
+    return 0;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file NVulkanOffscreenTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "NVulkanRender.h"
+
+int main() {
+    static constexpr int FRAME_COUNT{1000};
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 1280, 720, 2);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        if (auto command_buffer = render.BeginFrame()) {
+            render.BeginSwapchainRenderPass(command_buffer);
+            render.EndSwapchainRenderPass(command_buffer);
+            render.EndFrame();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << FRAME_COUNT << " frames in " << elapsed.count() << " s (" << FRAME_COUNT / elapsed.count() << " fps)" << std::endl;
+    return 0;
+}
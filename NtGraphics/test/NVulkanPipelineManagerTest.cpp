@@ -0,0 +1,73 @@
+/**
+ * @file NVulkanPipelineManagerTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "NVulkanPipelineManager.h"
+#include "NVulkanRender.h"
+#include "NVulkanShaderLibrary.h"
+
+int main() {
+    auto& manager = NVulkanPipelineManager::Singleton();
+    auto directory = std::filesystem::temp_directory_path() / "NVulkanPipelineManagerTest";
+    std::filesystem::remove_all(directory);
+    manager.SetCacheDirectory(directory);
+    if (manager.LoadCache()) {
+        return 1;
+    }
+
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 64, 64, 2);
+    NVulkanPipelineState state{};
+    state.stages_ = {NVulkanShaderLibrary::Stage("Path.vert"), NVulkanShaderLibrary::Stage("Path.frag")};
+    state.vertex_bindings_ = {{0, 48, vk::VertexInputRate::eInstance}, {1, 8, vk::VertexInputRate::eVertex}};
+    state.vertex_attributes_ = {
+        {0, 0, vk::Format::eR32G32B32A32Sfloat, 0},
+        {1, 0, vk::Format::eR32G32B32A32Sfloat, 16},
+        {2, 0, vk::Format::eR32G32B32A32Sfloat, 32},
+        {3, 1, vk::Format::eR32G32Sfloat, 0},
+    };
+    state.depth_test_ = false;
+    state.depth_write_ = false;
+    state.push_constant_ranges_ = NVulkanShaderLibrary::PushConstantRanges({"Path.vert"});
+    state.render_pass_ = render.RenderPass();
+
+    // Equal states share one pipeline; any change makes another one on the same layout.
+    auto pipeline = manager.CreateGraphicsPipeline(state);
+    if (manager.CreateGraphicsPipeline(NVulkanPipelineState{state}) != pipeline) {
+        return 1;
+    }
+    auto blended_state = state;
+    blended_state.blend_ = true;
+    auto blended = manager.CreateGraphicsPipeline(blended_state);
+    if (blended == pipeline || blended->Pipeline() == pipeline->Pipeline() || blended->Layout() != pipeline->Layout()) {
+        return 1;
+    }
+
+    // The saved blob carries more than the file and Vulkan cache headers, and loads back.
+    manager.SaveCache();
+    std::filesystem::path cache_file{};
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        cache_file = entry.path();
+    }
+    auto cache_size = cache_file.empty() ? 0 : std::filesystem::file_size(cache_file);
+    if (cache_size <= 80 || !manager.LoadCache()) {
+        return 1;
+    }
+    // A file from another device or a truncated one is ignored.
+    {
+        std::ofstream file(cache_file, std::ios::binary | std::ios::trunc);
+        file << "not a pipeline cache";
+    }
+    if (manager.LoadCache()) {
+        return 1;
+    }
+    std::cout << "pipeline cache of " << cache_size << " bytes round-tripped" << std::endl;
+    manager.SetCacheDirectory({});
+    std::filesystem::remove_all(directory);
+    return 0;
+}
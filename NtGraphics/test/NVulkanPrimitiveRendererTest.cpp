@@ -0,0 +1,124 @@
+/**
+ * @file NVulkanPrimitiveRendererTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "NDamageRegion.h"
+#include "NDrawList.h"
+#include "NPathCache.h"
+#include "NVulkanDevice.h"
+#include "NVulkanPrimitiveRenderer.h"
+#include "NVulkanRender.h"
+#include "NVulkanUploader.h"
+
+int main() {
+    static constexpr int FRAME_COUNT{120};
+    static constexpr uint32_t GRID_SIZE{100};
+    auto& device = NVulkanDevice::Singleton();
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 2400, 2400, 2);
+    NVulkanPrimitiveRenderer renderer(render.RenderPass(), render.FramesInFlight());
+    NVulkanUploader uploader;
+
+    vk::Image image{};
+    NVulkanAllocation allocation{};
+    device.CreateImage(2, 2, vk::Format::eR8G8B8A8Unorm, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst, vk::MemoryPropertyFlagBits::eDeviceLocal, image, allocation);
+    auto image_view = device.CreateImageView(image, vk::Format::eR8G8B8A8Unorm, vk::ImageAspectFlagBits::eColor);
+    vk::SamplerCreateInfo sampler_info{};
+    auto sampler = device.CreateSampler(sampler_info);
+    std::array<uint32_t, 4> pixels{0xFFFFFFFF, 0xFF0000FF, 0xFF00FF00, 0xFFFF0000};
+    uploader.UploadImage(pixels.data(), sizeof(pixels), image, {2, 2, 1}, vk::ImageLayout::eShaderReadOnlyOptimal, vk::PipelineStageFlagBits::eFragmentShader, vk::AccessFlagBits::eShaderRead);
+    auto texture = renderer.RegisterTexture(image_view, sampler);
+
+    // A long chart series and a ring with a hole both go stencil-then-cover; panning and rotating them
+    // reuses the meshes from the first frame.
+    NPathCache path_cache;
+    path_cache.SetStencilFallback(render.Swapchain().HasStencil());
+    NPath series;
+    series.MoveTo({0.0F, 600.0F});
+    for (int i = 0; i < 600; ++i) {
+        series.LineTo({static_cast<float>(i) * 4.0F, 400.0F + 150.0F * std::sin(static_cast<float>(i) * 0.05F)});
+    }
+    series.LineTo({2396.0F, 600.0F});
+    series.Close();
+    NPath ring;
+    ring.MoveTo({0.0F, 0.0F});
+    ring.CubicTo({100.0F, 0.0F}, {100.0F, 100.0F}, {0.0F, 100.0F});
+    ring.CubicTo({-100.0F, 100.0F}, {-100.0F, 0.0F}, {0.0F, 0.0F});
+    ring.MoveTo({0.0F, 25.0F});
+    ring.CubicTo({-50.0F, 25.0F}, {-50.0F, 75.0F}, {0.0F, 75.0F});
+    ring.CubicTo({50.0F, 75.0F}, {50.0F, 25.0F}, {0.0F, 25.0F});
+
+    // After the first frame only the series band and the rings change; the grid is loaded from the
+    // previous image and never repainted.
+    NDamageRegion damage;
+    damage.Add({0.0F, 240.0F, 2400.0F, 370.0F});
+    damage.Add({1070.0F, 1670.0F, 1010.0F, 260.0F});
+
+    NDrawList draw_list;
+    double record_ms = 0.0;
+    int partial_frames = 0;
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        if (frame == FRAME_COUNT / 2) {
+            // The renderer was built for two slots and must grow with the swapchain.
+            render.SetFramesInFlight(3);
+        }
+        auto command_buffer = render.BeginFrame();
+        if (!command_buffer) {
+            continue;
+        }
+        if (auto sync = uploader.Flush()) {
+            render.AddWaitSemaphore(sync.semaphore_, sync.wait_stages_);
+        }
+        uploader.RecordAcquireBarriers(command_buffer);
+        if (frame > 0) {
+            render.SetDamage(damage);
+        }
+        if (render.IsPartialRepaint()) {
+            ++partial_frames;
+        }
+        auto start = std::chrono::steady_clock::now();
+        draw_list.Clear();
+        for (uint32_t y = 0; y < GRID_SIZE; ++y) {
+            for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+                NRect cell{x * 24.0F, y * 24.0F, 18.0F, 18.0F};
+                draw_list.DrawRoundedRect(cell, 3.0F, {0.2F, 0.2F, 0.2F, 1.0F});
+                draw_list.DrawImage(texture, {cell.x_ + 2.0F, cell.y_ + 2.0F, 14.0F, 14.0F});
+                draw_list.DrawLine({cell.x_, cell.Bottom()}, {cell.Right(), cell.Bottom()}, 1.0F, {1.0F, 1.0F, 1.0F, 1.0F});
+            }
+        }
+        auto pan = NTransform::Translation(static_cast<float>(frame % 100), 0.0F);
+        draw_list.DrawPath(path_cache.Fill(series, NFillRule::eNonZero, pan), pan, {0.2F, 0.6F, 1.0F, 0.4F});
+        draw_list.DrawPath(path_cache.Stroke(series, {2.0F}, pan), pan, {0.2F, 0.6F, 1.0F, 1.0F});
+        for (int i = 0; i < 4; ++i) {
+            auto place = NTransform::Translation(1200.0F + static_cast<float>(i) * 250.0F, 1800.0F) * NTransform::Rotation(static_cast<float>(frame) * 0.01F);
+            draw_list.DrawPath(path_cache.Fill(ring, NFillRule::eEvenOdd, place), place, {1.0F, 0.5F, 0.0F, 1.0F});
+        }
+        renderer.Prepare(draw_list, render.CurrentFrameIndex());
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        record_ms += elapsed.count();
+        render.BeginSwapchainRenderPass(command_buffer);
+        render.RecordRepaint(command_buffer, [&](const vk::Rect2D& scissor) {
+            renderer.Draw(command_buffer, render.Swapchain().Extent(), scissor);
+        });
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+        if (frame == FRAME_COUNT / 4) {
+            // Dropping a texture mid-run retires its set behind the frames in flight instead of stalling.
+            renderer.UnregisterTexture(renderer.RegisterTexture(image_view, sampler));
+        }
+    }
+    std::cout << draw_list.PrimitiveCount() << " primitives in " << renderer.DrawCallCount() << " draws, "
+              << record_ms / FRAME_COUNT << " ms CPU per frame, " << path_cache.TessellationCount() << " path tessellations, " << partial_frames << " partial repaints" << std::endl;
+    device.WaitIdle();
+    renderer.UnregisterTexture(texture);
+    device.DestroySampler(sampler);
+    device.DestroyImageView(image_view);
+    device.DestroyImage(image, allocation);
+    return 0;
+}
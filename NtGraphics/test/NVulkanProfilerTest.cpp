@@ -0,0 +1,82 @@
+/**
+ * @file NVulkanProfilerTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "NProfiler.h"
+#include "NVulkanDevice.h"
+#include "NVulkanProfiler.h"
+
+static void Submit(const vk::CommandBuffer& command_buffer) {
+    auto& device = NVulkanDevice::Singleton();
+    command_buffer.end();
+    auto fence = device.CreateFence(vk::FenceCreateInfo{});
+    vk::SubmitInfo submit_info{};
+    submit_info.setCommandBuffers(command_buffer);
+    device.SubmitGraphics(submit_info, fence);
+    device.WaitForFences({fence});
+    device.DestroyFence(fence);
+}
+
+int main() {
+    NVulkanProfiler profiler(4);
+    if (!profiler.IsSupported()) {
+        std::cout << "timestamps are not supported, skipped" << std::endl;
+        return 0;
+    }
+    auto& device = NVulkanDevice::Singleton();
+    vk::CommandBufferAllocateInfo alloc_info{};
+    alloc_info
+        .setCommandPool(device.CommandPool())
+        .setLevel(vk::CommandBufferLevel::ePrimary)
+        .setCommandBufferCount(2);
+    auto command_buffers = device.AllocateCommandBuffers(alloc_info);
+    vk::CommandBufferBeginInfo begin_info{};
+    begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    // Zones beyond the capacity are skipped without unbalancing the nesting.
+    auto& cpu_profiler = NProfiler::Singleton();
+    cpu_profiler.Clear();
+    auto before = NProfiler::Now();
+    command_buffers[0].begin(begin_info);
+    profiler.BeginFrame(command_buffers[0], 1);
+    {
+        NVulkanProfileZone frame(profiler, command_buffers[0], "Frame");
+        for (int i = 0; i < 5; ++i) {
+            NVulkanProfileZone zone(profiler, command_buffers[0], "Pass");
+        }
+    }
+    Submit(command_buffers[0]);
+    auto after = NProfiler::Now();
+
+    // The slot's zones are resolved the next time it begins.
+    command_buffers[1].begin(begin_info);
+    profiler.BeginFrame(command_buffers[1], 1 + NVulkanSwapchain::MAX_FRAMES_IN_FLIGHT);
+    Submit(command_buffers[1]);
+    cpu_profiler.Collect();
+    const auto& events = cpu_profiler.Events();
+    auto is_gpu = [](const NProfileEvent& event) {
+        return event.is_gpu_;
+    };
+    if (std::count_if(events.begin(), events.end(), is_gpu) != 4) {
+        return 1;
+    }
+    // Calibrated GPU times land inside the CPU window of the submission.
+    auto slack = profiler.CalibrationError() + 1000000;
+    for (const auto& event : events) {
+        if (event.is_gpu_ && (event.begin_ < before - slack || event.end_ > after + slack || event.end_ < event.begin_)) {
+            return 1;
+        }
+    }
+    if (cpu_profiler.ChromeTrace().find(R"("name":"Frame","ph":"X","pid":2)") == std::string::npos) {
+        return 1;
+    }
+    std::cout << "calibrated within " << profiler.CalibrationError() << " ns" << std::endl;
+    device.FreeCommandBuffers(command_buffers);
+    return 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file NVulkanShaderLibraryTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <iostream>
+#include <stdexcept>
+
+#include "NVulkanShaderLibrary.h"
+
+int main() {
+    // Every shader under shaders/Vulkan is embedded, sorted by name, as valid SPIR-V.
+    auto shaders = NVulkanShaderLibrary::Shaders();
+    if (shaders.empty()) {
+        return 1;
+    }
+    for (size_t i = 0; i < shaders.size(); ++i) {
+        if (shaders[i].code_.size() < 5 || shaders[i].code_[0] != 0x07230203 || (i > 0 && !(shaders[i - 1].name_ < shaders[i].name_))) {
+            return 1;
+        }
+    }
+
+    const auto& vertex = NVulkanShaderLibrary::Shader("Primitive.vert");
+    if (vertex.stage_ != vk::ShaderStageFlagBits::eVertex || !vertex.bindings_.empty() || vertex.push_constant_offset_ != 0 || vertex.push_constant_size_ != 16) {
+        return 1;
+    }
+    // Both sampling fragment shaders read one combined image sampler at set 0, binding 0.
+    auto bindings = NVulkanShaderLibrary::SetLayoutBindings({"Primitive.frag", "PrimitiveImage.frag", "PrimitiveText.frag"}, 0);
+    if (bindings.size() != 1 || bindings[0].binding != 0 || bindings[0].descriptorType != vk::DescriptorType::eCombinedImageSampler || bindings[0].descriptorCount != 1 ||
+        bindings[0].stageFlags != vk::ShaderStageFlagBits::eFragment) {
+        return 1;
+    }
+    auto ranges = NVulkanShaderLibrary::PushConstantRanges({"Primitive.vert", "Path.vert", "Path.frag"});
+    if (ranges.size() != 1 || ranges[0].stageFlags != vk::ShaderStageFlagBits::eVertex || ranges[0].size != 16) {
+        return 1;
+    }
+    if (NVulkanShaderLibrary::Stage("Path.frag").code_.size() != NVulkanShaderLibrary::Shader("Path.frag").code_.size()) {
+        return 1;
+    }
+    try {
+        NVulkanShaderLibrary::Shader("Missing.frag");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+    std::cout << shaders.size() << " shaders embedded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file NVulkanTextureManagerTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "NVulkanDevice.h"
+#include "NVulkanRender.h"
+#include "NVulkanTextureManager.h"
+#include "NVulkanUploader.h"
+
+static NImage Checkerboard(uint32_t size, uint8_t shade) {
+    NImage image{};
+    NImageLevel level{size, size, std::vector<uint8_t>(static_cast<size_t>(size) * size * 4)};
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            auto value = ((x / 8 + y / 8) % 2 == 0) ? shade : static_cast<uint8_t>(255 - shade);
+            auto* pixel = &level.data_[(static_cast<size_t>(y) * size + x) * 4];
+            pixel[0] = value;
+            pixel[1] = value;
+            pixel[2] = value;
+            pixel[3] = 255;
+        }
+    }
+    image.levels_.push_back(std::move(level));
+    return image;
+}
+
+int main() {
+    static constexpr int FRAME_COUNT{60};
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 1280, 720, 2);
+    NVulkanUploader uploader;
+    NVulkanTextureManager textures(uploader);
+
+    // A four-layer array without a chain: mips are blitted on the GPU, or filtered on the CPU.
+    std::vector<NImage> layers{};
+    for (uint8_t i = 0; i < 4; ++i) {
+        layers.push_back(Checkerboard(512, static_cast<uint8_t>(i * 40)));
+    }
+    auto array = textures.Create(std::move(layers));
+    if (textures.Texture(array).mip_levels_ != 10 || textures.Texture(array).layers_ != 4) {
+        return 1;
+    }
+    // A missing file surfaces from Update and drops only that texture.
+    auto missing = textures.Load({"missing.ppm"});
+    bool is_missing_reported = false;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        auto command_buffer = render.BeginFrame();
+        if (!command_buffer) {
+            continue;
+        }
+        if (auto sync = uploader.Flush()) {
+            render.AddWaitSemaphore(sync.semaphore_, sync.wait_stages_);
+        }
+        uploader.RecordAcquireBarriers(command_buffer);
+        try {
+            textures.Update(command_buffer);
+        } catch (const std::exception&) {
+            is_missing_reported = true;
+        }
+        render.BeginSwapchainRenderPass(command_buffer);
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+        if (frame == FRAME_COUNT / 2) {
+            if (!textures.IsReady(array)) {
+                return 1;
+            }
+            textures.Destroy(array);
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << FRAME_COUNT << " frames in " << elapsed.count() << " ms, pending " << textures.PendingCount() << ", BC7 supported: " << NVulkanTextureManager::IsFormatSupported(NImageFormat::eBC7, true) << std::endl;
+    if (!is_missing_reported || textures.IsReady(missing) || textures.IsReady(array) || textures.PendingCount() != 0) {
+        return 1;
+    }
+    return 0;
+}
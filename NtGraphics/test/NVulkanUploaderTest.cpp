@@ -0,0 +1,127 @@
+/**
+ * @file NVulkanUploaderTest.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "NVulkanDevice.h"
+#include "NVulkanRender.h"
+#include "NVulkanUploader.h"
+
+int main() {
+    static constexpr int FRAME_COUNT{300};
+    static constexpr int UPLOADS_PER_FRAME{64};
+    static constexpr vk::DeviceSize UPLOAD_SIZE{64 * 1024};
+    NVulkanRender render(NVulkanSwapchain::Backend::eOffscreen, 1280, 720, 2);
+    NVulkanUploader uploader(4 * 1024 * 1024);
+    vk::Buffer buffer{};
+    NVulkanAllocation allocation{};
+    NVulkanDevice::Singleton().CreateBuffer(UPLOAD_SIZE * UPLOADS_PER_FRAME, vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eDeviceLocal, buffer, allocation);
+    // Every upload gets its own bytes, so a copy landing at the wrong offset shows up in the readback.
+    std::vector<char> data(UPLOAD_SIZE * UPLOADS_PER_FRAME);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>((i * 31 + i / UPLOAD_SIZE) & 0xFF);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        auto command_buffer = render.BeginFrame();
+        if (!command_buffer) {
+            continue;
+        }
+        for (int j = 0; j < UPLOADS_PER_FRAME; ++j) {
+            uploader.UploadBuffer(data.data() + UPLOAD_SIZE * j, UPLOAD_SIZE, buffer, UPLOAD_SIZE * j, vk::PipelineStageFlagBits::eVertexInput, vk::AccessFlagBits::eVertexAttributeRead);
+        }
+        if (auto sync = uploader.Flush()) {
+            render.AddWaitSemaphore(sync.semaphore_, sync.wait_stages_);
+        }
+        uploader.RecordAcquireBarriers(command_buffer);
+        render.BeginSwapchainRenderPass(command_buffer);
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << FRAME_COUNT * UPLOADS_PER_FRAME << " uploads in " << elapsed.count() << " s, dedicated transfer queue: " << uploader.HasDedicatedTransferQueue() << std::endl;
+
+    // Copy the uploaded buffer into host memory and compare it with what was sent.
+    vk::Buffer readback_buffer{};
+    NVulkanAllocation readback_allocation{};
+    NVulkanDevice::Singleton().CreateBuffer(data.size(), vk::BufferUsageFlagBits::eTransferDst, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, readback_buffer, readback_allocation);
+    vk::CommandBuffer command_buffer{};
+    while (!(command_buffer = render.BeginFrame())) {
+    }
+    vk::MemoryBarrier upload_barrier{vk::AccessFlagBits::eMemoryWrite, vk::AccessFlagBits::eTransferRead};
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, upload_barrier, {}, {});
+    command_buffer.copyBuffer(buffer, readback_buffer, vk::BufferCopy{0, 0, data.size()});
+    vk::MemoryBarrier readback_barrier{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead};
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, readback_barrier, {}, {});
+    render.BeginSwapchainRenderPass(command_buffer);
+    render.EndSwapchainRenderPass(command_buffer);
+    render.EndFrame();
+    NVulkanDevice::Singleton().WaitIdle();
+    auto is_equal = readback_allocation.mapped_ && std::memcmp(readback_allocation.mapped_, data.data(), data.size()) == 0;
+    NVulkanDevice::Singleton().DestroyBuffer(readback_buffer, readback_allocation);
+    NVulkanDevice::Singleton().DestroyBuffer(buffer, allocation);
+
+    // A region written into an image already in use keeps the texels around it.
+    static constexpr uint32_t IMAGE_SIZE{4};
+    vk::Image image{};
+    NVulkanAllocation image_allocation{};
+    NVulkanDevice::Singleton().CreateImage(IMAGE_SIZE, IMAGE_SIZE, vk::Format::eR8G8B8A8Unorm, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eDeviceLocal, image, image_allocation);
+    std::vector<uint32_t> pixels(IMAGE_SIZE * IMAGE_SIZE, 0xFF0000FF);
+    std::vector<uint32_t> patch(4, 0xFF00FF00);
+    for (int i = 0; i < 2; ++i) {
+        while (!(command_buffer = render.BeginFrame())) {
+        }
+        if (i == 0) {
+            uploader.UploadImage(pixels.data(), pixels.size() * sizeof(uint32_t), image, {IMAGE_SIZE, IMAGE_SIZE, 1}, vk::ImageLayout::eShaderReadOnlyOptimal, vk::PipelineStageFlagBits::eFragmentShader, vk::AccessFlagBits::eShaderRead);
+        } else {
+            uploader.UploadImage(patch.data(), patch.size() * sizeof(uint32_t), image, {2, 2, 1}, vk::ImageLayout::eShaderReadOnlyOptimal, vk::PipelineStageFlagBits::eFragmentShader, vk::AccessFlagBits::eShaderRead, {vk::ImageAspectFlagBits::eColor, 0, 0, 1}, {1, 1, 0}, vk::ImageLayout::eShaderReadOnlyOptimal);
+        }
+        if (auto sync = uploader.Flush()) {
+            render.AddWaitSemaphore(sync.semaphore_, sync.wait_stages_);
+        }
+        uploader.RecordAcquireBarriers(command_buffer);
+        render.BeginSwapchainRenderPass(command_buffer);
+        render.EndSwapchainRenderPass(command_buffer);
+        render.EndFrame();
+    }
+    for (uint32_t y = 1; y < 3; ++y) {
+        for (uint32_t x = 1; x < 3; ++x) {
+            pixels[y * IMAGE_SIZE + x] = 0xFF00FF00;
+        }
+    }
+    NVulkanDevice::Singleton().CreateBuffer(pixels.size() * sizeof(uint32_t), vk::BufferUsageFlagBits::eTransferDst, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, readback_buffer, readback_allocation);
+    while (!(command_buffer = render.BeginFrame())) {
+    }
+    vk::ImageMemoryBarrier to_source{};
+    to_source
+        .setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eTransferRead)
+        .setOldLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setImage(image)
+        .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1});
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, to_source);
+    vk::BufferImageCopy image_region{};
+    image_region
+        .setImageSubresource({vk::ImageAspectFlagBits::eColor, 0, 0, 1})
+        .setImageExtent({IMAGE_SIZE, IMAGE_SIZE, 1});
+    command_buffer.copyImageToBuffer(image, vk::ImageLayout::eTransferSrcOptimal, readback_buffer, image_region);
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, readback_barrier, {}, {});
+    render.BeginSwapchainRenderPass(command_buffer);
+    render.EndSwapchainRenderPass(command_buffer);
+    render.EndFrame();
+    NVulkanDevice::Singleton().WaitIdle();
+    is_equal = is_equal && readback_allocation.mapped_ && std::memcmp(readback_allocation.mapped_, pixels.data(), pixels.size() * sizeof(uint32_t)) == 0;
+    NVulkanDevice::Singleton().DestroyBuffer(readback_buffer, readback_allocation);
+    NVulkanDevice::Singleton().DestroyImage(image, image_allocation);
+    return is_equal ? 0 : 1;
+}
@@ -0,0 +1,368 @@
+/**
+ * @file NShaderEmbed.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-18
+ *
+ * Build-time tool: NShaderEmbed <output.cpp> <shader.spv>...
+ * Writes the SPIR-V of every shader as a constexpr array, together with its stage, descriptor
+ * bindings and push-constant block reflected from the module, as the table behind
+ * NVulkanShaderLibrary::Shaders().
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+static constexpr uint32_t SPIRV_MAGIC{0x07230203};
+
+static constexpr uint32_t OP_ENTRY_POINT{15};
+static constexpr uint32_t OP_TYPE_INT{21};
+static constexpr uint32_t OP_TYPE_FLOAT{22};
+static constexpr uint32_t OP_TYPE_VECTOR{23};
+static constexpr uint32_t OP_TYPE_MATRIX{24};
+static constexpr uint32_t OP_TYPE_IMAGE{25};
+static constexpr uint32_t OP_TYPE_SAMPLER{26};
+static constexpr uint32_t OP_TYPE_SAMPLED_IMAGE{27};
+static constexpr uint32_t OP_TYPE_ARRAY{28};
+static constexpr uint32_t OP_TYPE_RUNTIME_ARRAY{29};
+static constexpr uint32_t OP_TYPE_STRUCT{30};
+static constexpr uint32_t OP_TYPE_POINTER{32};
+static constexpr uint32_t OP_CONSTANT{43};
+static constexpr uint32_t OP_VARIABLE{59};
+static constexpr uint32_t OP_DECORATE{71};
+static constexpr uint32_t OP_MEMBER_DECORATE{72};
+
+static constexpr uint32_t DECORATION_BUFFER_BLOCK{3};
+static constexpr uint32_t DECORATION_ARRAY_STRIDE{6};
+static constexpr uint32_t DECORATION_MATRIX_STRIDE{7};
+static constexpr uint32_t DECORATION_BINDING{33};
+static constexpr uint32_t DECORATION_DESCRIPTOR_SET{34};
+static constexpr uint32_t DECORATION_OFFSET{35};
+
+static constexpr uint32_t STORAGE_UNIFORM_CONSTANT{0};
+static constexpr uint32_t STORAGE_UNIFORM{2};
+static constexpr uint32_t STORAGE_PUSH_CONSTANT{9};
+static constexpr uint32_t STORAGE_STORAGE_BUFFER{12};
+
+static constexpr uint32_t DIM_BUFFER{5};
+static constexpr uint32_t DIM_SUBPASS_DATA{6};
+
+struct Type {
+    uint32_t opcode_{0};
+    std::vector<uint32_t> operands_{};
+};
+
+struct Binding {
+    uint32_t set_{0};
+    uint32_t binding_{0};
+    std::string type_{};
+    uint32_t count_{1};
+};
+
+struct Reflection {
+    std::string stage_{};
+    std::vector<Binding> bindings_{};
+    uint32_t push_constant_offset_{0};
+    uint32_t push_constant_size_{0};
+};
+
+class Module {
+public:
+    explicit Module(const std::vector<uint32_t>& code) {
+        if (code.size() < 5 || code[0] != SPIRV_MAGIC) {
+            throw std::runtime_error("not a SPIR-V module");
+        }
+        for (size_t offset = 5; offset < code.size();) {
+            auto word_count = code[offset] >> 16;
+            auto opcode = code[offset] & 0xFFFF;
+            if (word_count == 0 || offset + word_count > code.size()) {
+                throw std::runtime_error("truncated instruction");
+            }
+            std::vector<uint32_t> operands(code.begin() + static_cast<std::ptrdiff_t>(offset + 1), code.begin() + static_cast<std::ptrdiff_t>(offset + word_count));
+            Parse(opcode, operands);
+            offset += word_count;
+        }
+    }
+
+    Reflection Reflect() const {
+        Reflection reflection{};
+        reflection.stage_ = stage_;
+        for (const auto& [id, variable] : variables_) {
+            auto [storage_class, pointer_type] = variable;
+            auto type_id = types_.at(pointer_type).operands_.at(1);
+            if (storage_class == STORAGE_PUSH_CONSTANT) {
+                auto [offset, size] = StructRange(type_id);
+                reflection.push_constant_offset_ = offset;
+                reflection.push_constant_size_ = size;
+                continue;
+            }
+            if (storage_class != STORAGE_UNIFORM_CONSTANT && storage_class != STORAGE_UNIFORM && storage_class != STORAGE_STORAGE_BUFFER) {
+                continue;
+            }
+            Binding binding{Decoration(id, DECORATION_DESCRIPTOR_SET), Decoration(id, DECORATION_BINDING)};
+            // Arrays of descriptors: fixed arrays multiply the count, a runtime array leaves it open.
+            while (true) {
+                const auto& type = types_.at(type_id);
+                if (type.opcode_ == OP_TYPE_ARRAY) {
+                    binding.count_ *= constants_.at(type.operands_.at(1));
+                    type_id = type.operands_.at(0);
+                } else if (type.opcode_ == OP_TYPE_RUNTIME_ARRAY) {
+                    binding.count_ = 0;
+                    type_id = type.operands_.at(0);
+                } else {
+                    break;
+                }
+            }
+            binding.type_ = DescriptorType(storage_class, type_id);
+            reflection.bindings_.push_back(binding);
+        }
+        std::sort(reflection.bindings_.begin(), reflection.bindings_.end(), [](const Binding& left, const Binding& right) {
+            return left.set_ != right.set_ ? left.set_ < right.set_ : left.binding_ < right.binding_;
+        });
+        return reflection;
+    }
+
+private:
+    void Parse(uint32_t opcode, const std::vector<uint32_t>& operands) {
+        switch (opcode) {
+            case OP_ENTRY_POINT:
+                if (stage_.empty()) {
+                    stage_ = StageName(operands.at(0));
+                }
+                break;
+            case OP_TYPE_INT:
+            case OP_TYPE_FLOAT:
+            case OP_TYPE_VECTOR:
+            case OP_TYPE_MATRIX:
+            case OP_TYPE_IMAGE:
+            case OP_TYPE_SAMPLER:
+            case OP_TYPE_SAMPLED_IMAGE:
+            case OP_TYPE_ARRAY:
+            case OP_TYPE_RUNTIME_ARRAY:
+            case OP_TYPE_STRUCT:
+            case OP_TYPE_POINTER:
+                types_[operands.at(0)] = {opcode, std::vector<uint32_t>(operands.begin() + 1, operands.end())};
+                break;
+            case OP_CONSTANT:
+                constants_[operands.at(1)] = operands.at(2);
+                break;
+            case OP_VARIABLE:
+                variables_[operands.at(1)] = {operands.at(2), operands.at(0)};
+                break;
+            case OP_DECORATE:
+                decorations_[{operands.at(0), operands.at(1)}] = operands.size() > 2 ? operands[2] : 1;
+                break;
+            case OP_MEMBER_DECORATE:
+                member_decorations_[{operands.at(0), operands.at(1), operands.at(2)}] = operands.size() > 3 ? operands[3] : 1;
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint32_t Decoration(uint32_t id, uint32_t decoration) const {
+        auto it = decorations_.find({id, decoration});
+        return it == decorations_.end() ? 0 : it->second;
+    }
+
+    bool HasDecoration(uint32_t id, uint32_t decoration) const {
+        return decorations_.contains({id, decoration});
+    }
+
+    std::string DescriptorType(uint32_t storage_class, uint32_t type_id) const {
+        const auto& type = types_.at(type_id);
+        if (storage_class == STORAGE_STORAGE_BUFFER) {
+            return "eStorageBuffer";
+        }
+        if (storage_class == STORAGE_UNIFORM) {
+            return HasDecoration(type_id, DECORATION_BUFFER_BLOCK) ? "eStorageBuffer" : "eUniformBuffer";
+        }
+        switch (type.opcode_) {
+            case OP_TYPE_SAMPLED_IMAGE:
+                return "eCombinedImageSampler";
+            case OP_TYPE_SAMPLER:
+                return "eSampler";
+            case OP_TYPE_IMAGE: {
+                // Operands: sampled type, dim, depth, arrayed, multisampled, sampled.
+                auto dim = type.operands_.at(1);
+                auto is_storage = type.operands_.at(5) == 2;
+                if (dim == DIM_BUFFER) {
+                    return is_storage ? "eStorageTexelBuffer" : "eUniformTexelBuffer";
+                }
+                if (dim == DIM_SUBPASS_DATA) {
+                    return "eInputAttachment";
+                }
+                return is_storage ? "eStorageImage" : "eSampledImage";
+            }
+            default:
+                throw std::runtime_error("unsupported descriptor type");
+        }
+    }
+
+    std::pair<uint32_t, uint32_t> StructRange(uint32_t struct_id) const {
+        const auto& members = types_.at(struct_id).operands_;
+        uint32_t begin = UINT32_MAX;
+        uint32_t end = 0;
+        for (uint32_t member = 0; member < members.size(); ++member) {
+            auto offset = MemberDecoration(struct_id, member, DECORATION_OFFSET);
+            begin = (std::min)(begin, offset);
+            end = (std::max)(end, offset + TypeSize(members[member], MemberDecoration(struct_id, member, DECORATION_MATRIX_STRIDE)));
+        }
+        return members.empty() ? std::pair<uint32_t, uint32_t>{0, 0} : std::pair<uint32_t, uint32_t>{begin, end - begin};
+    }
+
+    uint32_t MemberDecoration(uint32_t struct_id, uint32_t member, uint32_t decoration) const {
+        auto it = member_decorations_.find({struct_id, member, decoration});
+        return it == member_decorations_.end() ? 0 : it->second;
+    }
+
+    uint32_t TypeSize(uint32_t type_id, uint32_t matrix_stride) const {
+        const auto& type = types_.at(type_id);
+        switch (type.opcode_) {
+            case OP_TYPE_INT:
+            case OP_TYPE_FLOAT:
+                return type.operands_.at(0) / 8;
+            case OP_TYPE_VECTOR:
+                return TypeSize(type.operands_.at(0), 0) * type.operands_.at(1);
+            case OP_TYPE_MATRIX: {
+                auto column_size = TypeSize(type.operands_.at(0), 0);
+                return (matrix_stride != 0 ? matrix_stride : column_size) * (type.operands_.at(1) - 1) + column_size;
+            }
+            case OP_TYPE_ARRAY: {
+                auto stride = Decoration(type_id, DECORATION_ARRAY_STRIDE);
+                auto element_size = TypeSize(type.operands_.at(0), matrix_stride);
+                return (stride != 0 ? stride : element_size) * constants_.at(type.operands_.at(1));
+            }
+            case OP_TYPE_STRUCT: {
+                auto [offset, size] = StructRange(type_id);
+                return offset + size;
+            }
+            default:
+                throw std::runtime_error("unsupported push constant member");
+        }
+    }
+
+    static std::string StageName(uint32_t execution_model) {
+        switch (execution_model) {
+            case 0:
+                return "eVertex";
+            case 1:
+                return "eTessellationControl";
+            case 2:
+                return "eTessellationEvaluation";
+            case 3:
+                return "eGeometry";
+            case 4:
+                return "eFragment";
+            case 5:
+                return "eCompute";
+            default:
+                throw std::runtime_error("unsupported execution model");
+        }
+    }
+
+private:
+    std::string stage_{};
+    std::map<uint32_t, Type> types_{};
+    std::map<uint32_t, uint32_t> constants_{};
+    std::map<uint32_t, std::pair<uint32_t, uint32_t>> variables_{};
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> decorations_{};
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> member_decorations_{};
+};
+
+static std::vector<uint32_t> ReadSpirv(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("failed to open");
+    }
+    auto size = static_cast<size_t>(file.tellg());
+    if (size == 0 || size % sizeof(uint32_t) != 0) {
+        throw std::runtime_error("size is not a multiple of 4");
+    }
+    std::vector<uint32_t> code(size / sizeof(uint32_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(size));
+    return code;
+}
+
+static std::string Identifier(const std::string& name) {
+    std::string identifier{};
+    for (auto c : name) {
+        identifier.push_back(std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_');
+    }
+    return identifier;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: NShaderEmbed <output.cpp> <shader.spv>..." << std::endl;
+        return 1;
+    }
+    // Sorted by name so NVulkanShaderLibrary::Shader can binary search.
+    std::map<std::string, std::filesystem::path> shaders{};
+    for (int i = 2; i < argc; ++i) {
+        std::filesystem::path path{argv[i]};
+        shaders[path.stem().string()] = path;
+    }
+
+    std::ostringstream tables{};
+    std::ostringstream entries{};
+    tables << std::hex;
+    for (const auto& [name, path] : shaders) {
+        std::vector<uint32_t> code{};
+        Reflection reflection{};
+        try {
+            code = ReadSpirv(path);
+            reflection = Module(code).Reflect();
+        } catch (const std::exception& error) {
+            std::cerr << path.string() << ": " << error.what() << std::endl;
+            return 1;
+        }
+        auto identifier = Identifier(name);
+        tables << "static constexpr uint32_t " << identifier << "_CODE[]{";
+        for (size_t i = 0; i < code.size(); ++i) {
+            tables << (i % 8 == 0 ? "\n    " : " ") << "0x" << code[i] << ",";
+        }
+        tables << "\n};\n";
+        std::string bindings{"{}"};
+        if (!reflection.bindings_.empty()) {
+            tables << std::dec << "static constexpr NVulkanShaderBinding " << identifier << "_BINDINGS[]{\n";
+            for (const auto& binding : reflection.bindings_) {
+                tables << "    {" << binding.set_ << ", " << binding.binding_ << ", vk::DescriptorType::" << binding.type_ << ", " << binding.count_ << "},\n";
+            }
+            tables << "};\n" << std::hex;
+            bindings = identifier + "_BINDINGS";
+        }
+        entries << "    {\"" << name << "\", vk::ShaderStageFlagBits::" << reflection.stage_ << ", " << identifier << "_CODE, " << bindings << ", "
+                << reflection.push_constant_offset_ << ", " << reflection.push_constant_size_ << "},\n";
+    }
+
+    std::ostringstream source{};
+    source << "// Generated by NShaderEmbed from the compiled shaders; do not edit.\n\n"
+           << "#include \"NVulkanShaderLibrary.h\"\n\n"
+           << tables.str() << "\n"
+           << "static constexpr NVulkanEmbeddedShader SHADERS[]{\n"
+           << entries.str() << "};\n\n"
+           << "std::span<const NVulkanEmbeddedShader> NVulkanShaderLibrary::Shaders() {\n"
+           << "    return SHADERS;\n"
+           << "}\n";
+    std::filesystem::path output{argv[1]};
+    std::filesystem::create_directories(output.parent_path());
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    file << source.str();
+    if (!file) {
+        std::cerr << output.string() << ": failed to write" << std::endl;
+        return 1;
+    }
+    return 0;
+}